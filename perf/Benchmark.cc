@@ -0,0 +1,158 @@
+//
+//  Benchmark.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <iomanip>
+#include <iostream>
+#include "Benchmark.h"
+#include "Timer.h"
+
+using namespace snowcrash::perf;
+
+BenchmarkState::BenchmarkState(double minTime)
+: m_minTime(minTime), m_start(0), m_elapsed(0), m_iterations(0), m_checkpoint(1),
+  m_bytes(0), m_items(0), m_sink(0), m_running(false)
+{
+}
+
+bool BenchmarkState::keepRunning()
+{
+    if (!m_running) {
+        m_running = true;
+        m_start = Now();
+        return true;
+    }
+
+    ++m_iterations;
+    if (m_iterations < m_checkpoint)
+        return true;
+
+    // Check the clock in doubling batches only
+    m_elapsed = Now() - m_start;
+    if (m_elapsed >= m_minTime) {
+        m_running = false;
+        return false;
+    }
+
+    m_checkpoint *= 2;
+    return true;
+}
+
+void BenchmarkState::setMetric(const std::string& name, double value)
+{
+    for (std::vector<std::pair<std::string, double> >::iterator it = m_metrics.begin(); it != m_metrics.end(); ++it) {
+        if (it->first == name) {
+            it->second = value;
+            return;
+        }
+    }
+
+    m_metrics.push_back(std::make_pair(name, value));
+}
+
+std::vector<Benchmark>& snowcrash::perf::Benchmarks()
+{
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+BenchmarkRegistrar::BenchmarkRegistrar(const char* name, BenchmarkFunction function)
+{
+    Benchmark benchmark;
+    benchmark.name = name;
+    benchmark.function = function;
+    Benchmarks().push_back(benchmark);
+}
+
+// Whether the name passes filters
+static bool Matches(const std::string& name, const std::vector<std::string>& filters)
+{
+    if (filters.empty())
+        return true;
+
+    for (std::vector<std::string>::const_iterator it = filters.begin(); it != filters.end(); ++it) {
+        if (name.find(*it) != std::string::npos)
+            return true;
+    }
+
+    return false;
+}
+
+// Write result as a JSON line
+static void WriteJSON(const std::string& name, const BenchmarkState& state, std::ostream& os)
+{
+    double iterations = static_cast<double>(state.iterations());
+    os << "{\"name\": \"" << name << "\"";
+    os << ", \"iterations\": " << state.iterations();
+    os << ", \"seconds\": " << state.elapsed();
+    os << ", \"ns_per_iteration\": " << state.elapsed() * 1e9 / iterations;
+
+    if (state.bytes())
+        os << ", \"bytes_per_second\": " << state.bytes() * iterations / state.elapsed();
+
+    if (state.items())
+        os << ", \"items_per_second\": " << state.items() * iterations / state.elapsed();
+
+    for (std::vector<std::pair<std::string, double> >::const_iterator it = state.metrics().begin();
+         it != state.metrics().end();
+         ++it) {
+        os << ", \"" << it->first << "\": " << it->second;
+    }
+
+    os << "}\n";
+}
+
+// Write human readable result
+static void WriteText(const std::string& name, const BenchmarkState& state, std::ostream& os)
+{
+    double iterations = static_cast<double>(state.iterations());
+    os << std::left << std::setw(40) << name << std::right;
+    os << std::setw(12) << state.iterations() << " iter";
+    os << std::setw(14) << std::fixed << std::setprecision(1) << state.elapsed() * 1e9 / iterations << " ns";
+
+    if (state.bytes())
+        os << std::setw(10) << std::setprecision(2) << state.bytes() * iterations / state.elapsed() / (1024 * 1024) << " MB/s";
+
+    if (state.items())
+        os << std::setw(12) << std::setprecision(0) << state.items() * iterations / state.elapsed() << " items/s";
+
+    for (std::vector<std::pair<std::string, double> >::const_iterator it = state.metrics().begin();
+         it != state.metrics().end();
+         ++it) {
+        os << "  " << it->first << "=" << std::setprecision(2) << it->second;
+    }
+
+    os << std::endl;
+    os.unsetf(std::ios::floatfield);
+}
+
+size_t snowcrash::perf::RunBenchmarks(const std::vector<std::string>& filters,
+                                      double minTime,
+                                      bool json,
+                                      std::ostream& os)
+{
+    size_t count = 0;
+    for (std::vector<Benchmark>::const_iterator it = Benchmarks().begin(); it != Benchmarks().end(); ++it) {
+
+        if (!Matches(it->name, filters))
+            continue;
+
+        BenchmarkState state(minTime);
+        it->function(state);
+        if (!state.iterations())
+            continue;
+
+        if (json)
+            WriteJSON(it->name, state, os);
+        else
+            WriteText(it->name, state, os);
+
+        os.flush();
+        ++count;
+    }
+
+    return count;
+}
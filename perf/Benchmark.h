@@ -0,0 +1,111 @@
+//
+//  Benchmark.h
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#ifndef SNOWCRASH_BENCHMARK_H
+#define SNOWCRASH_BENCHMARK_H
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <ostream>
+
+namespace snowcrash {
+namespace perf {
+
+    //
+    // Running benchmark state
+    //
+    // A benchmark body prepares its data and then loops while keepRunning()
+    // returns true. Iterations are timed in growing batches until
+    // the minimal run time is reached.
+    //
+    class BenchmarkState {
+    public:
+        explicit BenchmarkState(double minTime);
+
+        // Returns true while more iterations should be run
+        bool keepRunning();
+
+        // Number of iterations run so far
+        size_t iterations() const { return m_iterations; }
+
+        // Bytes processed by one iteration
+        void setBytes(size_t bytes) { m_bytes = bytes; }
+
+        // Items (e.g. lookups) processed by one iteration
+        void setItems(size_t items) { m_items = items; }
+
+        // Additional named metric
+        void setMetric(const std::string& name, double value);
+
+        // Keep a value from being optimized away
+        template <typename T>
+        void use(const T& value) { m_sink += static_cast<size_t>(value != T()); }
+
+        // Run results
+        double elapsed() const { return m_elapsed; }
+        size_t bytes() const { return m_bytes; }
+        size_t items() const { return m_items; }
+        const std::vector<std::pair<std::string, double> >& metrics() const { return m_metrics; }
+
+    private:
+        double m_minTime;
+        double m_start;
+        double m_elapsed;
+        size_t m_iterations;
+        size_t m_checkpoint;
+        size_t m_bytes;
+        size_t m_items;
+        size_t m_sink;
+        bool m_running;
+        std::vector<std::pair<std::string, double> > m_metrics;
+    };
+
+    // Benchmark function
+    typedef void (*BenchmarkFunction)(BenchmarkState& state);
+
+    // Registered benchmark
+    struct Benchmark {
+        std::string name;
+        BenchmarkFunction function;
+    };
+
+    // All registered benchmarks
+    std::vector<Benchmark>& Benchmarks();
+
+    // Registers a benchmark at static initialization time
+    struct BenchmarkRegistrar {
+        BenchmarkRegistrar(const char* name, BenchmarkFunction function);
+    };
+
+    // Run benchmarks whose name contains any of filters (all if empty),
+    // write results in human readable or JSON lines format.
+    // Returns number of benchmarks run.
+    size_t RunBenchmarks(const std::vector<std::string>& filters,
+                         double minTime,
+                         bool json,
+                         std::ostream& os);
+}
+}
+
+#define SNOWCRASH_BENCHMARK_CAT2(a, b) a##b
+#define SNOWCRASH_BENCHMARK_CAT(a, b) SNOWCRASH_BENCHMARK_CAT2(a, b)
+
+//
+// Define a benchmark, e.g.
+//
+//      BENCHMARK("router/match")
+//      {
+//          while (state.keepRunning()) { ... }
+//      }
+//
+#define BENCHMARK(name) \
+    static void SNOWCRASH_BENCHMARK_CAT(Benchmark_, __LINE__)(snowcrash::perf::BenchmarkState& state); \
+    static snowcrash::perf::BenchmarkRegistrar SNOWCRASH_BENCHMARK_CAT(BenchmarkRegistrar_, __LINE__)(name, &SNOWCRASH_BENCHMARK_CAT(Benchmark_, __LINE__)); \
+    static void SNOWCRASH_BENCHMARK_CAT(Benchmark_, __LINE__)(snowcrash::perf::BenchmarkState& state)
+
+#endif
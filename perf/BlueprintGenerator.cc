@@ -0,0 +1,190 @@
+//
+//  BlueprintGenerator.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <cstdlib>
+#include <sstream>
+#include "BlueprintGenerator.h"
+
+using namespace snowcrash::perf;
+
+// Filler text of descriptions
+static const std::string LoremIpsum = "Lorem ipsum dolor sit amet, consectetur adipiscing elit, "
+                                      "sed do eiusmod tempor incididunt ut labore et dolore magna aliqua. ";
+
+// Methods cycled through by resources
+static const char* const Methods[] = { "GET", "PUT", "POST", "DELETE", "PATCH", "HEAD", "OPTIONS" };
+static const size_t MethodCount = sizeof(Methods) / sizeof(Methods[0]);
+
+// Width of a generated text line
+static const size_t LineWidth = 72;
+
+// Write description paragraph of given length & nested list
+static void WriteDescription(const BlueprintGeneratorOptions& options,
+                             const std::string& indent,
+                             std::ostream& os)
+{
+    if (!options.descriptionLength && !options.nesting)
+        return;
+
+    size_t written = 0;
+    size_t line = 0;
+    while (written < options.descriptionLength) {
+        char c = LoremIpsum[written % LoremIpsum.length()];
+        ++written;
+
+        if (line >= LineWidth && c == ' ') {
+            os << "\n";
+            line = 0;
+            continue;
+        }
+
+        if (line == 0)
+            os << indent;
+
+        os << c;
+        ++line;
+    }
+
+    if (line)
+        os << "\n";
+
+    if (options.nesting) {
+        os << "\n";
+        std::string itemIndent = indent;
+        for (size_t level = 0; level < options.nesting; ++level) {
+            os << itemIndent << "- Level " << level << "\n";
+            itemIndent += "    ";
+        }
+    }
+
+    os << "\n";
+}
+
+// Write JSON payload body of given size
+static void WriteBody(const BlueprintGeneratorOptions& options,
+                      const std::string& indent,
+                      std::ostream& os)
+{
+    os << indent << "{\n";
+
+    size_t written = 4;
+    for (size_t item = 0; written < options.bodySize; ++item) {
+        std::stringstream line;
+        line << "    \"item" << item << "\": \"" << LoremIpsum.substr(0, LineWidth / 2) << "\"";
+        written += line.str().length() + 2;
+
+        os << indent << line.str() << ((written < options.bodySize) ? ",\n" : "\n");
+    }
+
+    os << indent << "}\n\n";
+}
+
+// Write request or response
+static void WritePayload(const BlueprintGeneratorOptions& options,
+                         const std::string& signature,
+                         std::ostream& os)
+{
+    os << "+ " << signature << " (application/json)\n\n";
+    WriteDescription(options, "    ", os);
+
+    if (options.headers) {
+        os << "    + Headers\n\n";
+        for (size_t i = 0; i < options.headers; ++i)
+            os << "            X-Header-" << i << ": Value " << i << "\n";
+        os << "\n";
+    }
+
+    os << "    + Body\n\n";
+    WriteBody(options, "            ", os);
+}
+
+BlueprintGeneratorOptions::BlueprintGeneratorOptions()
+: groups(10), resources(10), methods(3), payloads(2), headers(2),
+  bodySize(256), descriptionLength(160), nesting(0)
+{
+}
+
+std::string snowcrash::perf::GenerateBlueprint(const BlueprintGeneratorOptions& options)
+{
+    std::stringstream os;
+
+    os << "FORMAT: 1A\nHOST: http://acme.com\n\n";
+    os << "# Generated API\n";
+    WriteDescription(options, "", os);
+
+    for (size_t g = 0; g < options.groups; ++g) {
+
+        os << "# Group Group " << g << "\n";
+        WriteDescription(options, "", os);
+
+        for (size_t r = 0; r < options.resources; ++r) {
+
+            os << "## Resource " << g << " " << r << " [/groups/" << g << "/resources/" << r << "/{id}]\n";
+            WriteDescription(options, "", os);
+
+            for (size_t m = 0; m < options.methods; ++m) {
+
+                os << "### Method " << m << " [" << Methods[m % MethodCount] << "]\n";
+                WriteDescription(options, "", os);
+
+                // Requests first, then at least one response
+                size_t requests = options.payloads / 2;
+                for (size_t p = 0; p < options.payloads; ++p) {
+                    std::stringstream signature;
+                    if (p < requests)
+                        signature << "Request Request " << p;
+                    else
+                        signature << "Response " << (200 + p - requests);
+
+                    WritePayload(options, signature.str(), os);
+                }
+            }
+        }
+    }
+
+    return os.str();
+}
+
+bool snowcrash::perf::ParseBlueprintGeneratorOptions(const std::string& specification,
+                                                     BlueprintGeneratorOptions& options)
+{
+    std::stringstream ss(specification);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+
+        std::string::size_type separator = item.find('=');
+        if (separator == std::string::npos)
+            return false;
+
+        std::string key = item.substr(0, separator);
+        std::string value = item.substr(separator + 1);
+        if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos)
+            return false;
+
+        size_t number = static_cast<size_t>(std::strtoul(value.c_str(), NULL, 10));
+        if (key == "groups")
+            options.groups = number;
+        else if (key == "resources")
+            options.resources = number;
+        else if (key == "methods")
+            options.methods = number;
+        else if (key == "payloads")
+            options.payloads = number;
+        else if (key == "headers")
+            options.headers = number;
+        else if (key == "bodySize")
+            options.bodySize = number;
+        else if (key == "descriptionLength")
+            options.descriptionLength = number;
+        else if (key == "nesting")
+            options.nesting = number;
+        else
+            return false;
+    }
+
+    return true;
+}
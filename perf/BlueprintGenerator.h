@@ -0,0 +1,44 @@
+//
+//  BlueprintGenerator.h
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#ifndef SNOWCRASH_PERF_BLUEPRINTGENERATOR_H
+#define SNOWCRASH_PERF_BLUEPRINTGENERATOR_H
+
+#include <string>
+#include <cstddef>
+
+namespace snowcrash {
+namespace perf {
+
+    //
+    // Synthetic blueprint shape
+    //
+    struct BlueprintGeneratorOptions {
+        BlueprintGeneratorOptions();
+
+        size_t groups;              // Resource groups
+        size_t resources;           // Resources per group
+        size_t methods;             // Methods per resource
+        size_t payloads;            // Requests & responses per method
+        size_t headers;             // Headers per payload
+        size_t bodySize;            // Bytes per payload body
+        size_t descriptionLength;   // Bytes per description
+        size_t nesting;             // Depth of the list nested in descriptions
+    };
+
+    // Generate API blueprint source of the given shape.
+    // The output is deterministic.
+    std::string GenerateBlueprint(const BlueprintGeneratorOptions& options);
+
+    // Update options from `key=value[,key=value...]` specification,
+    // keys are the option names. Returns false on malformed specification.
+    bool ParseBlueprintGeneratorOptions(const std::string& specification,
+                                        BlueprintGeneratorOptions& options);
+}
+}
+
+#endif
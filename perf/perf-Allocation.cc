@@ -0,0 +1,79 @@
+//
+//  perf-Allocation.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <algorithm>
+#include <sstream>
+#include "Benchmark.h"
+#include "BlueprintGenerator.h"
+#include "snowcrash.h"
+
+using namespace snowcrash;
+using namespace snowcrash::perf;
+
+// Number of resource groups of the generated blueprints
+static const size_t AllocationGroups[] = { 1, 4, 16, 64 };
+static const size_t AllocationGroupsCount = sizeof(AllocationGroups) / sizeof(AllocationGroups[0]);
+
+// Generated blueprints of growing size
+static const std::vector<std::string>& AllocationSources()
+{
+    static std::vector<std::string> sources;
+    if (sources.empty()) {
+        for (size_t i = 0; i < AllocationGroupsCount; ++i) {
+            BlueprintGeneratorOptions options;
+            options.groups = AllocationGroups[i];
+            options.resources = 4;
+            sources.push_back(GenerateBlueprint(options));
+        }
+    }
+
+    return sources;
+}
+
+// Reports bytes allocated and peak live bytes per input byte for each of
+// the generated blueprints. The metrics are available in the allocation
+// accounting build only, see AllocationAccountingEnabled().
+BENCHMARK("allocation/parse")
+{
+    const std::vector<std::string>& sources = AllocationSources();
+    size_t bytes = 0;
+    for (std::vector<std::string>::const_iterator it = sources.begin(); it != sources.end(); ++it)
+        bytes += it->length();
+
+    while (state.keepRunning()) {
+        for (std::vector<std::string>::const_iterator it = sources.begin(); it != sources.end(); ++it) {
+            Result result;
+            Blueprint blueprint;
+            parse(*it, 0, result, blueprint);
+            state.use(blueprint.resourceGroups.size());
+        }
+    }
+
+    state.setBytes(bytes);
+
+    if (!AllocationAccountingEnabled())
+        return;
+
+    for (size_t i = 0; i < sources.size(); ++i) {
+        ResetPeakLiveBytes();
+        AllocationCounters start = ThreadAllocationCounters();
+        {
+            Result result;
+            Blueprint blueprint;
+            parse(sources[i], 0, result, blueprint);
+        }
+        AllocationCounters end = ThreadAllocationCounters();
+
+        double allocatedBytes = static_cast<double>(end.bytes - start.bytes);
+        double peakLiveBytes = static_cast<double>(end.peakLiveBytes - start.liveBytes);
+        double input = static_cast<double>(std::max<size_t>(sources[i].length(), 1));
+        std::stringstream name;
+        name << "groups_" << AllocationGroups[i];
+        state.setMetric(name.str() + "_bytes_per_input_byte", allocatedBytes / input);
+        state.setMetric(name.str() + "_peak_bytes_per_input_byte", peakLiveBytes / input);
+    }
+}
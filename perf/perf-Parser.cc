@@ -0,0 +1,212 @@
+//
+//  perf-Parser.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <sstream>
+#include <vector>
+#include "Benchmark.h"
+#include "BlueprintGenerator.h"
+#include "MarkdownParser.h"
+#include "SerializeSnapshot.h"
+#include "Snapshot.h"
+#include "snowcrash.h"
+
+using namespace snowcrash;
+using namespace snowcrash::perf;
+
+// Generated blueprint of the default shape
+static const std::string& DefaultSource()
+{
+    static const std::string source = GenerateBlueprint(BlueprintGeneratorOptions());
+    return source;
+}
+
+// Generated blueprint of many small resources
+static const std::string& LargeSource()
+{
+    static std::string source;
+    if (source.empty()) {
+        BlueprintGeneratorOptions options;
+        options.groups = 50;
+        options.resources = 40;
+        options.bodySize = 64;
+        options.descriptionLength = 40;
+        source = GenerateBlueprint(options);
+    }
+
+    return source;
+}
+
+// Generated blueprint of deeply nested descriptions
+static const std::string& NestedSource()
+{
+    static std::string source;
+    if (source.empty()) {
+        BlueprintGeneratorOptions options;
+        options.nesting = 8;
+        source = GenerateBlueprint(options);
+    }
+
+    return source;
+}
+
+BENCHMARK("markdown/parse")
+{
+    const std::string& source = DefaultSource();
+    MarkdownParser parser;
+    while (state.keepRunning()) {
+        Result result;
+        MarkdownBlock::Stack markdown;
+        parser.parse(source, result, markdown);
+        state.use(markdown.size());
+    }
+
+    state.setBytes(source.length());
+}
+
+BENCHMARK("parser/parse")
+{
+    const std::string& source = DefaultSource();
+    while (state.keepRunning()) {
+        Result result;
+        Blueprint blueprint;
+        parse(source, 0, result, blueprint);
+        state.use(blueprint.resourceGroups.size());
+    }
+
+    state.setBytes(source.length());
+}
+
+BENCHMARK("parser/validate")
+{
+    const std::string& source = DefaultSource();
+    while (state.keepRunning()) {
+        Result result;
+        validate(source, 0, result);
+        state.use(result.warnings.size());
+    }
+
+    state.setBytes(source.length());
+}
+
+BENCHMARK("parser/parse-large")
+{
+    const std::string& source = LargeSource();
+    while (state.keepRunning()) {
+        Result result;
+        Blueprint blueprint;
+        parse(source, 0, result, blueprint);
+        state.use(blueprint.resourceGroups.size());
+    }
+
+    state.setBytes(source.length());
+}
+
+BENCHMARK("parser/parse-nested")
+{
+    const std::string& source = NestedSource();
+    while (state.keepRunning()) {
+        Result result;
+        Blueprint blueprint;
+        parse(source, 0, result, blueprint);
+        state.use(blueprint.resourceGroups.size());
+    }
+
+    state.setBytes(source.length());
+}
+
+// Snapshot of the parsed source, in a buffer aligned for its 32-bit fields
+static void SnapshotOf(const std::string& source, std::vector<uint32_t>& buffer, size_t& length)
+{
+    Result result;
+    Blueprint blueprint;
+    parse(source, 0, result, blueprint);
+
+    std::stringstream ss;
+    SerializeSnapshot(blueprint, ss);
+    const std::string snapshot = ss.str();
+
+    length = snapshot.length();
+    buffer.assign(length / sizeof(uint32_t) + 1, 0);
+    snapshot.copy(reinterpret_cast<char*>(&buffer[0]), length);
+}
+
+// Snapshot benchmarks report the blueprint source size as their bytes,
+// their throughput compares directly to the parser/parse of the same source
+
+BENCHMARK("snapshot/load")
+{
+    const std::string& source = DefaultSource();
+    std::vector<uint32_t> buffer;
+    size_t length;
+    SnapshotOf(source, buffer, length);
+
+    while (state.keepRunning()) {
+        Snapshot snapshot;
+        snapshot.load(reinterpret_cast<const char*>(&buffer[0]), length);
+        state.use(snapshot.blueprint().resourceGroups.count);
+    }
+
+    state.setBytes(source.length());
+    state.setMetric("snapshot_bytes", static_cast<double>(length));
+}
+
+BENCHMARK("snapshot/materialize")
+{
+    const std::string& source = DefaultSource();
+    std::vector<uint32_t> buffer;
+    size_t length;
+    SnapshotOf(source, buffer, length);
+
+    while (state.keepRunning()) {
+        Snapshot snapshot;
+        snapshot.load(reinterpret_cast<const char*>(&buffer[0]), length);
+
+        Blueprint blueprint;
+        snapshot.materialize(blueprint);
+        state.use(blueprint.resourceGroups.size());
+    }
+
+    state.setBytes(source.length());
+    state.setMetric("snapshot_bytes", static_cast<double>(length));
+}
+
+BENCHMARK("snapshot/load-large")
+{
+    const std::string& source = LargeSource();
+    std::vector<uint32_t> buffer;
+    size_t length;
+    SnapshotOf(source, buffer, length);
+
+    while (state.keepRunning()) {
+        Snapshot snapshot;
+        snapshot.load(reinterpret_cast<const char*>(&buffer[0]), length);
+        state.use(snapshot.blueprint().resourceGroups.count);
+    }
+
+    state.setBytes(source.length());
+    state.setMetric("snapshot_bytes", static_cast<double>(length));
+}
+
+BENCHMARK("snapshot/materialize-large")
+{
+    const std::string& source = LargeSource();
+    std::vector<uint32_t> buffer;
+    size_t length;
+    SnapshotOf(source, buffer, length);
+
+    while (state.keepRunning()) {
+        Snapshot snapshot;
+        snapshot.load(reinterpret_cast<const char*>(&buffer[0]), length);
+
+        Blueprint blueprint;
+        snapshot.materialize(blueprint);
+        state.use(blueprint.resourceGroups.size());
+    }
+
+    state.setBytes(source.length());
+    state.setMetric("snapshot_bytes", static_cast<double>(length));
+}
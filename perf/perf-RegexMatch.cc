@@ -0,0 +1,55 @@
+//
+//  perf-RegexMatch.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include "Benchmark.h"
+#include "MarkdownBlock.h"
+#include "RegexMatch.h"
+#include "ResourceParser.h"
+
+using namespace snowcrash;
+using namespace snowcrash::perf;
+
+// Typical named resource header
+static const std::string ResourceHeader = "My Resource [/collection/{id}/items/{item}]";
+
+BENCHMARK("regex/match")
+{
+    while (state.keepRunning())
+        state.use(RegexMatch(ResourceHeader, NamedResourceHeaderRegex));
+
+    state.setBytes(ResourceHeader.length());
+}
+
+BENCHMARK("regex/capture")
+{
+    CaptureGroups captureGroups;
+    while (state.keepRunning())
+        state.use(RegexCapture(ResourceHeader, NamedResourceHeaderRegex, captureGroups, 3));
+
+    state.setBytes(ResourceHeader.length());
+}
+
+BENCHMARK("markdown/map-source-data")
+{
+    // Source of 64 lines, mapped by a block of every other line
+    std::string source;
+    SourceDataBlock sourceMap;
+    for (size_t i = 0; i < 64; ++i) {
+        SourceDataRange range;
+        range.location = source.length();
+        range.length = 64;
+        source += std::string(63, 'x') + "\n";
+
+        if (i % 2 == 0)
+            sourceMap.push_back(range);
+    }
+
+    while (state.keepRunning())
+        state.use(MapSourceData(source, sourceMap).length());
+
+    state.setBytes(sourceMap.size() * 64);
+}
@@ -0,0 +1,181 @@
+//
+//  perf-Router.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <sstream>
+#include "Benchmark.h"
+#include "Router.h"
+
+using namespace snowcrash;
+using namespace snowcrash::perf;
+
+// Number of resources in the benchmark blueprint
+static const size_t ResourceCount = 10000;
+
+// Number of distinct looked-up paths
+static const size_t PathCount = 1024;
+
+// Blueprint with many resources of mixed URI template shapes
+static const Blueprint& RouterBlueprint(std::vector<std::string>* paths)
+{
+    static Blueprint blueprint;
+    static std::vector<std::string> lookups;
+
+    if (blueprint.resourceGroups.empty()) {
+
+        ResourceGroup group;
+        for (size_t i = 0; i < ResourceCount; ++i) {
+            std::stringstream uriTemplate;
+            uriTemplate << "/api/collection" << i;
+
+            switch (i % 4) {
+                case 1:
+                    uriTemplate << "/{id}";
+                    break;
+                case 2:
+                    uriTemplate << "/{id}/items/{item}";
+                    break;
+                case 3:
+                    uriTemplate << "/{id}.{format}";
+                    break;
+                default:
+                    break;
+            }
+
+            Resource resource;
+            resource.uriTemplate = uriTemplate.str();
+
+            Method method;
+            method.method = "GET";
+            resource.methods.push_back(method);
+            method.method = "POST";
+            resource.methods.push_back(method);
+
+            group.resources.push_back(resource);
+        }
+        blueprint.resourceGroups.push_back(group);
+
+        // Deterministic pseudo-random selection of resources
+        size_t seed = 42;
+        for (size_t i = 0; i < PathCount; ++i) {
+            seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+            size_t index = seed % ResourceCount;
+
+            std::stringstream path;
+            path << "/api/collection" << index;
+            switch (index % 4) {
+                case 1:
+                    path << "/" << i;
+                    break;
+                case 2:
+                    path << "/" << i << "/items/" << seed;
+                    break;
+                case 3:
+                    path << "/" << i << ".json";
+                    break;
+                default:
+                    break;
+            }
+
+            lookups.push_back(path.str());
+        }
+    }
+
+    if (paths)
+        *paths = lookups;
+
+    return blueprint;
+}
+
+// Naive match of a path against a URI template, variables match
+// up to the next template literal character or slash
+static bool MatchTemplate(const std::string& uriTemplate, const std::string& path)
+{
+    size_t t = 0;
+    size_t p = 0;
+    while (t < uriTemplate.length()) {
+
+        if (uriTemplate[t] == '{') {
+            t = uriTemplate.find('}', t);
+            if (t == std::string::npos)
+                return false;
+            ++t;
+
+            char stop = (t < uriTemplate.length()) ? uriTemplate[t] : '/';
+            size_t start = p;
+            while (p < path.length() && path[p] != stop && path[p] != '/')
+                ++p;
+
+            if (p == start)
+                return false;
+
+            continue;
+        }
+
+        if (p >= path.length() || uriTemplate[t] != path[p])
+            return false;
+
+        ++t;
+        ++p;
+    }
+
+    return p == path.length();
+}
+
+BENCHMARK("router/linear-scan")
+{
+    std::vector<std::string> paths;
+    const Blueprint& blueprint = RouterBlueprint(&paths);
+    const Collection<Resource>::type& resources = blueprint.resourceGroups.front().resources;
+
+    state.setItems(1);
+    size_t i = 0;
+    while (state.keepRunning()) {
+        const std::string& path = paths[i++ % paths.size()];
+        const Method* found = NULL;
+        for (Collection<Resource>::const_iterator it = resources.begin(); it != resources.end() && !found; ++it) {
+            if (!MatchTemplate(it->uriTemplate, path))
+                continue;
+
+            for (Collection<Method>::const_iterator method = it->methods.begin(); method != it->methods.end(); ++method) {
+                if (method->method == "POST") {
+                    found = &*method;
+                    break;
+                }
+            }
+        }
+
+        state.use(found);
+    }
+}
+
+BENCHMARK("router/trie")
+{
+    std::vector<std::string> paths;
+    const Blueprint& blueprint = RouterBlueprint(&paths);
+    Router router(blueprint);
+    RouteMatch match;
+
+    state.setItems(1);
+    size_t i = 0;
+    while (state.keepRunning()) {
+        const std::string& path = paths[i++ % paths.size()];
+        router.match("POST", 4, path.data(), path.length(), match);
+        state.use(match.method);
+    }
+}
+
+BENCHMARK("router/build")
+{
+    const Blueprint& blueprint = RouterBlueprint(NULL);
+
+    state.setItems(ResourceCount);
+    while (state.keepRunning()) {
+        Router router(blueprint);
+        RouteMatch match;
+        state.use(router.match("GET", "/api/collection0", match));
+    }
+}
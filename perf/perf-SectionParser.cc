@@ -0,0 +1,255 @@
+//
+//  perf-SectionParser.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <sstream>
+#include "Benchmark.h"
+#include "Fixture.h"
+#include "BlueprintParser.h"
+
+using namespace snowcrash;
+using namespace snowcrash::perf;
+using namespace snowcrashtest;
+
+//
+// Section parsers on the canonical test fixtures
+//
+
+BENCHMARK("section/blueprint")
+{
+    const MarkdownBlock::Stack markdown = CanonicalBlueprintFixture();
+    while (state.keepRunning()) {
+        Result result;
+        Blueprint blueprint;
+        BlueprintParser::Parse(SourceDataFixture, markdown, 0, result, blueprint);
+        state.use(blueprint.resourceGroups.size());
+    }
+
+    state.setItems(markdown.size());
+}
+
+BENCHMARK("section/blueprint-validate")
+{
+    const MarkdownBlock::Stack markdown = CanonicalBlueprintFixture();
+    while (state.keepRunning()) {
+        Result result;
+        Blueprint blueprint;
+        BlueprintParser::Parse(SourceDataFixture, markdown, ValidateOnlyOption, result, blueprint);
+        state.use(result.warnings.size());
+    }
+
+    state.setItems(markdown.size());
+}
+
+BENCHMARK("section/resource-group")
+{
+    const MarkdownBlock::Stack markdown = CanonicalResourceGroupFixture();
+    Blueprint blueprint;
+    while (state.keepRunning()) {
+        BlueprintParserCore parser(0, SourceDataFixture, blueprint);
+        ResourceGroup resourceGroup;
+        ParseSectionResult result = ResourceGroupParser::Parse(markdown.begin(), markdown.end(), parser, resourceGroup);
+        state.use(result.first.warnings.size() + resourceGroup.resources.size());
+    }
+
+    state.setItems(markdown.size());
+}
+
+BENCHMARK("section/resource")
+{
+    const MarkdownBlock::Stack markdown = CanonicalResourceFixture();
+    Blueprint blueprint;
+    while (state.keepRunning()) {
+        BlueprintParserCore parser(0, SourceDataFixture, blueprint);
+        Resource resource;
+        ParseSectionResult result = ResourceParser::Parse(markdown.begin(), markdown.end(), parser, resource);
+        state.use(result.first.warnings.size() + resource.methods.size());
+    }
+
+    state.setItems(markdown.size());
+}
+
+BENCHMARK("section/method")
+{
+    const MarkdownBlock::Stack markdown = CanonicalMethodFixture();
+    Blueprint blueprint;
+    while (state.keepRunning()) {
+        BlueprintParserCore parser(0, SourceDataFixture, blueprint);
+        Method method;
+        ParseSectionResult result = MethodParser::Parse(markdown.begin(), markdown.end(), parser, method);
+        state.use(result.first.warnings.size() + method.responses.size());
+    }
+
+    state.setItems(markdown.size());
+}
+
+BENCHMARK("section/payload")
+{
+    const MarkdownBlock::Stack markdown = CanonicalPayloadFixture();
+    Blueprint blueprint;
+    while (state.keepRunning()) {
+        BlueprintParserCore parser(0, SourceDataFixture, blueprint);
+        Payload payload;
+        ParseSectionResult result = PayloadParser::Parse(markdown.begin(), markdown.end(), parser, payload);
+        state.use(result.first.warnings.size() + payload.body.length());
+    }
+
+    state.setItems(markdown.size());
+}
+
+BENCHMARK("section/asset-body")
+{
+    const MarkdownBlock::Stack markdown = CanonicalBodyAssetFixture();
+    Blueprint blueprint;
+    while (state.keepRunning()) {
+        BlueprintParserCore parser(0, SourceDataFixture, blueprint);
+        Asset asset;
+        ParseSectionResult result = AssetParser::Parse(markdown.begin(), markdown.end(), parser, asset);
+        state.use(result.first.warnings.size() + asset.length());
+    }
+
+    state.setItems(markdown.size());
+}
+
+BENCHMARK("section/asset-schema")
+{
+    const MarkdownBlock::Stack markdown = CanonicalSchemaAssetFixture();
+    Blueprint blueprint;
+    while (state.keepRunning()) {
+        BlueprintParserCore parser(0, SourceDataFixture, blueprint);
+        Asset asset;
+        ParseSectionResult result = AssetParser::Parse(markdown.begin(), markdown.end(), parser, asset);
+        state.use(result.first.warnings.size() + asset.length());
+    }
+
+    state.setItems(markdown.size());
+}
+
+//
+// Payload with a large body, copied & kept as its source
+//
+
+// Body payload source of `lines` JSON lines & its markdown
+static void LargeBodyPayload(size_t lines, SourceData& source, MarkdownBlock::Stack& markdown)
+{
+    source = "+ Request (application/json)\n\n";
+    size_t code = source.length();
+
+    std::string content = "[\n";
+    for (size_t i = 0; i < lines; ++i)
+        content += "  {\"id\": 42, \"name\": \"Lorem ipsum dolor sit amet\"},\n";
+    content += "]\n";
+
+    std::string::size_type begin = 0;
+    while (begin < content.length()) {
+        std::string::size_type end = content.find('\n', begin) + 1;
+        source += "        " + content.substr(begin, end - begin);
+        begin = end;
+    }
+
+    markdown.clear();
+    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Request (application/json)", 0, MakeSourceDataBlock(0, code)));
+    markdown.push_back(MarkdownBlock(CodeBlockType, content, 0, MakeSourceDataBlock(code, source.length() - code)));
+    markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, SourceDataBlock()));
+}
+
+static void BenchmarkLargeBody(BenchmarkState& state, BlueprintParserOptions options)
+{
+    SourceData source;
+    MarkdownBlock::Stack markdown;
+    LargeBodyPayload(4096, source, markdown);
+
+    Blueprint blueprint;
+    while (state.keepRunning()) {
+        BlueprintParserCore parser(options, source, blueprint);
+        Payload payload;
+        ParseSectionResult result = PayloadParser::Parse(markdown.begin(), markdown.end(), parser, payload);
+        state.use(result.first.warnings.size() + payload.body.length() + payload.bodySource.sourceMap.size());
+    }
+
+    state.setBytes(source.length());
+}
+
+BENCHMARK("section/payload-large-body")
+{
+    BenchmarkLargeBody(state, 0);
+}
+
+BENCHMARK("section/payload-large-body-source")
+{
+    BenchmarkLargeBody(state, AssetSourceOption);
+}
+
+//
+// Method with large body responses, parsed & validated
+//
+
+// Method source of `responses` JSON body responses, `lines` lines each & its markdown
+static void LargeBodyMethod(size_t responses, size_t lines, SourceData& source, MarkdownBlock::Stack& markdown)
+{
+    source = "# GET /resource\n";
+    markdown.clear();
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "GET /resource", 1, MakeSourceDataBlock(0, source.length())));
+    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
+
+    std::string content = "[\n";
+    for (size_t i = 0; i < lines; ++i)
+        content += "  {\"id\": 42, \"name\": \"Lorem ipsum dolor sit amet\"},\n";
+    content += "]\n";
+
+    for (size_t r = 0; r < responses; ++r) {
+        std::stringstream signature;
+        signature << "Response " << (200 + r) << " (application/json)";
+
+        size_t item = source.length();
+        source += "+ " + signature.str() + "\n\n";
+        size_t code = source.length();
+
+        std::string::size_type begin = 0;
+        while (begin < content.length()) {
+            std::string::size_type end = content.find('\n', begin) + 1;
+            source += "        " + content.substr(begin, end - begin);
+            begin = end;
+        }
+
+        markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+        markdown.push_back(MarkdownBlock(ParagraphBlockType, signature.str(), 0, MakeSourceDataBlock(item, code - item)));
+        markdown.push_back(MarkdownBlock(CodeBlockType, content, 0, MakeSourceDataBlock(code, source.length() - code)));
+        markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, SourceDataBlock()));
+    }
+
+    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, SourceDataBlock()));
+}
+
+static void BenchmarkLargeBodyMethod(BenchmarkState& state, BlueprintParserOptions options)
+{
+    SourceData source;
+    MarkdownBlock::Stack markdown;
+    LargeBodyMethod(16, 4096, source, markdown);
+
+    Blueprint blueprint;
+    while (state.keepRunning()) {
+        BlueprintParserCore parser(options, source, blueprint);
+        Resource resource;
+        ParseSectionResult result = ResourceParser::Parse(markdown.begin(), markdown.end(), parser, resource);
+        state.use(result.first.warnings.size() + resource.methods.size());
+    }
+
+    state.setBytes(source.length());
+}
+
+BENCHMARK("section/method-large-bodies")
+{
+    BenchmarkLargeBodyMethod(state, 0);
+}
+
+BENCHMARK("section/method-large-bodies-validate")
+{
+    BenchmarkLargeBodyMethod(state, ValidateOnlyOption);
+}
@@ -0,0 +1,175 @@
+//
+//  perf-Serialize.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <cstring>
+#include <sstream>
+#include <vector>
+#include "Benchmark.h"
+#include "DeserializeJSON.h"
+#include "SerializeJSON.h"
+#include "SerializeMsgPack.h"
+#include "SerializeYAML.h"
+
+using namespace snowcrash;
+using namespace snowcrash::perf;
+
+// In-memory blueprint with resources of typical size
+static const Blueprint& SerializeBlueprint()
+{
+    static Blueprint blueprint;
+    if (!blueprint.resourceGroups.empty())
+        return blueprint;
+
+    blueprint.name = "Benchmark API";
+    blueprint.description = "Blueprint used by serializer benchmarks.\n\nWith *two* paragraphs.\n";
+    blueprint.metadata.push_back(std::make_pair("HOST", "http://acme.com"));
+
+    for (size_t g = 0; g < 50; ++g) {
+        std::stringstream name;
+        name << "Group " << g;
+
+        ResourceGroup group;
+        group.name = name.str();
+        group.description = "Group description\n";
+
+        for (size_t r = 0; r < 20; ++r) {
+            std::stringstream uri;
+            uri << "/group" << g << "/resource" << r << "/{id}";
+
+            Resource resource;
+            resource.uriTemplate = uri.str();
+            resource.name = "Resource";
+            resource.description = "Resource description\nspanning two lines\n";
+            resource.headers.push_back(std::make_pair("X-Resource", "42"));
+
+            const char* methods[] = { "GET", "PUT", "DELETE" };
+            for (size_t m = 0; m < 3; ++m) {
+                Method method;
+                method.method = methods[m];
+                method.description = "Method description\n";
+
+                Response response;
+                response.name = "200";
+                response.headers.push_back(std::make_pair("Content-Type", "application/json"));
+                response.body = "{\n    \"id\": 42,\n    \"name\": \"Snow Crash\",\n    \"tags\": [\"a\", \"b\"]\n}\n";
+                method.responses.push_back(response);
+
+                if (m == 1) {
+                    Request request = response;
+                    request.name.clear();
+                    method.requests.push_back(request);
+                }
+
+                resource.methods.push_back(method);
+            }
+
+            group.resources.push_back(resource);
+        }
+
+        blueprint.resourceGroups.push_back(group);
+    }
+
+    return blueprint;
+}
+
+BENCHMARK("serialize/yaml")
+{
+    const Blueprint& blueprint = SerializeBlueprint();
+    std::stringstream ss;
+    while (state.keepRunning()) {
+        ss.str(std::string());
+        SerializeYAML(blueprint, ss);
+    }
+
+    state.setBytes(ss.str().length());
+    state.setMetric("output_bytes", static_cast<double>(ss.str().length()));
+}
+
+BENCHMARK("serialize/json")
+{
+    const Blueprint& blueprint = SerializeBlueprint();
+    std::stringstream ss;
+    while (state.keepRunning()) {
+        ss.str(std::string());
+        SerializeJSON(blueprint, ss);
+    }
+
+    state.setBytes(ss.str().length());
+    state.setMetric("output_bytes", static_cast<double>(ss.str().length()));
+}
+
+BENCHMARK("serialize/json-compact")
+{
+    const Blueprint& blueprint = SerializeBlueprint();
+    std::stringstream ss;
+    while (state.keepRunning()) {
+        ss.str(std::string());
+        SerializeJSON(blueprint, ss, CompactJSONOption);
+    }
+
+    state.setBytes(ss.str().length());
+    state.setMetric("output_bytes", static_cast<double>(ss.str().length()));
+}
+
+BENCHMARK("serialize/json-parallel")
+{
+    const Blueprint& blueprint = SerializeBlueprint();
+    std::stringstream ss;
+    while (state.keepRunning()) {
+        ss.str(std::string());
+        SerializeJSON(blueprint, ss, ParallelJSONOption);
+    }
+
+    state.setBytes(ss.str().length());
+    state.setMetric("output_bytes", static_cast<double>(ss.str().length()));
+}
+
+BENCHMARK("serialize/yaml-parallel")
+{
+    const Blueprint& blueprint = SerializeBlueprint();
+    std::stringstream ss;
+    while (state.keepRunning()) {
+        ss.str(std::string());
+        SerializeYAML(blueprint, ss, ParallelYAMLOption);
+    }
+
+    state.setBytes(ss.str().length());
+    state.setMetric("output_bytes", static_cast<double>(ss.str().length()));
+}
+
+BENCHMARK("serialize/msgpack")
+{
+    const Blueprint& blueprint = SerializeBlueprint();
+    std::stringstream ss;
+    while (state.keepRunning()) {
+        ss.str(std::string());
+        SerializeMsgPack(blueprint, ss);
+    }
+
+    state.setBytes(ss.str().length());
+    state.setMetric("output_bytes", static_cast<double>(ss.str().length()));
+}
+
+BENCHMARK("deserialize/json")
+{
+    std::stringstream ss;
+    SerializeJSON(SerializeBlueprint(), ss);
+    const std::string json = ss.str();
+
+    // Deserialization is in place, work on a fresh copy every iteration
+    std::vector<char> buffer(json.length());
+    while (state.keepRunning()) {
+        ::memcpy(&buffer[0], json.data(), json.length());
+
+        Blueprint blueprint;
+        Error error;
+        DeserializeJSON(&buffer[0], buffer.size(), blueprint, error);
+        state.use(blueprint.resourceGroups.size());
+    }
+
+    state.setBytes(json.length());
+}
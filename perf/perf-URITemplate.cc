@@ -0,0 +1,54 @@
+//
+//  perf-URITemplate.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include "Benchmark.h"
+#include "URITemplate.h"
+
+using namespace snowcrash;
+using namespace snowcrash::perf;
+
+static const char* const BenchmarkURITemplate = "/users/{user}/notes/{id}.{format}{?q,limit}";
+
+BENCHMARK("uritemplate/compile")
+{
+    CompiledURITemplate compiled;
+    while (state.keepRunning()) {
+        state.use(CompileURITemplate(BenchmarkURITemplate, compiled));
+    }
+}
+
+BENCHMARK("uritemplate/expand")
+{
+    CompiledURITemplate compiled;
+    CompileURITemplate(BenchmarkURITemplate, compiled);
+
+    Collection<KeyValuePair>::type values;
+    values.push_back(std::make_pair("user", "john"));
+    values.push_back(std::make_pair("id", "42"));
+    values.push_back(std::make_pair("format", "json"));
+    values.push_back(std::make_pair("q", "snow crash"));
+
+    std::string uri;
+    while (state.keepRunning()) {
+        uri.clear();
+        ExpandURITemplate(compiled, values, uri);
+        state.use(uri.length());
+    }
+}
+
+BENCHMARK("uritemplate/match")
+{
+    CompiledURITemplate compiled;
+    CompileURITemplate(BenchmarkURITemplate, compiled);
+
+    std::string uri = "/users/john/notes/42.json?q=snow%20crash&limit=10";
+    std::vector<URITemplateCapture> captures;
+    state.setBytes(uri.length());
+    while (state.keepRunning()) {
+        state.use(MatchURITemplate(compiled, uri, captures));
+    }
+}
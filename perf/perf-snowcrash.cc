@@ -0,0 +1,75 @@
+//
+//  perf-snowcrash.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "Benchmark.h"
+#include "BlueprintGenerator.h"
+
+using namespace snowcrash::perf;
+
+// Default minimal run time of a benchmark in seconds
+static const double DefaultMinTime = 0.5;
+
+static void PrintUsage()
+{
+    std::cerr << "usage: perf-snowcrash [--json] [--min-time <seconds>] [--list] [filter ...]\n";
+    std::cerr << "       perf-snowcrash --generate [<key>=<value>[,...]]\n\n";
+    std::cerr << "--generate writes a synthetic blueprint to stdout, keys: groups, resources,\n";
+    std::cerr << "methods, payloads, headers, bodySize, descriptionLength & nesting\n";
+}
+
+int main(int argc, const char *argv[])
+{
+    bool json = false;
+    bool list = false;
+    double minTime = DefaultMinTime;
+    std::vector<std::string> filters;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0) {
+            json = true;
+        }
+        else if (std::strcmp(argv[i], "--list") == 0) {
+            list = true;
+        }
+        else if (std::strcmp(argv[i], "--generate") == 0) {
+            BlueprintGeneratorOptions options;
+            if (i + 1 < argc && !ParseBlueprintGeneratorOptions(argv[i + 1], options)) {
+                PrintUsage();
+                return EXIT_FAILURE;
+            }
+            
+            std::cout << GenerateBlueprint(options);
+            return EXIT_SUCCESS;
+        }
+        else if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            minTime = std::atof(argv[++i]);
+        }
+        else if (argv[i][0] == '-') {
+            PrintUsage();
+            return EXIT_FAILURE;
+        }
+        else {
+            filters.push_back(argv[i]);
+        }
+    }
+
+    if (list) {
+        for (std::vector<Benchmark>::const_iterator it = Benchmarks().begin(); it != Benchmarks().end(); ++it)
+            std::cout << it->name << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    if (!RunBenchmarks(filters, minTime, json, std::cout)) {
+        std::cerr << "no benchmarks matched\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
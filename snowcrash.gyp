@@ -4,6 +4,12 @@
     'common.gypi'
   ],
 
+  'variables': {
+    # Interpose the global operator new & delete to account for allocations,
+    # see src/Allocation.h
+    'snowcrash_allocation_accounting%': 'false'
+  },
+
   'targets' : [
     {
       'target_name': 'sundown',
@@ -34,39 +40,72 @@
         'sundown/src/html'
       ],
       'sources': [
+        'src/Allocation.cc',
+        'src/Allocation.h',
+        'src/AssetSource.cc',
+        'src/AssetSource.h',
         'src/Blueprint.h',
         'src/BlueprintParser.h',
         'src/BlueprintParserCore.h',
+        'src/DeserializeJSON.cc',
+        'src/DeserializeJSON.h',
         'src/HeaderParser.h',
+        'src/JSONCheck.cc',
+        'src/JSONCheck.h',
         'src/ListUtility.h',
+        'src/MappedFile.h',
         'src/MarkdownBlock.cc',
         'src/MarkdownBlock.h',
         'src/MarkdownParser.cc',
         'src/MarkdownParser.h',
         'src/MethodParser.h',
+        'src/OutputBuffer.h',
         'src/Parser.cc',
         'src/Parser.h',
+        'src/ParserBudget.cc',
+        'src/ParserBudget.h',
         'src/ParserCore.cc',
         'src/ParserCore.h',
+        'src/ParserStatistics.cc',
+        'src/ParserStatistics.h',
         'src/PayloadParser.h',
         'src/RegexMatch.h',
         'src/ResourceGroupParser.h',
         'src/ResourceParser.h',
+        'src/Router.cc',
+        'src/Router.h',
         'src/Serialize.cc',
         'src/Serialize.h',
         'src/SerializeJSON.cc',
         'src/SerializeJSON.h',
+        'src/SerializeMsgPack.cc',
+        'src/SerializeMsgPack.h',
+        'src/SerializeSnapshot.cc',
+        'src/SerializeSnapshot.h',
         'src/SerializeYAML.cc',
         'src/SerializeYAML.h',
+        'src/Snapshot.cc',
+        'src/Snapshot.h',
         'src/StringUtility.h',
         'src/snowcrash.cc',
         'src/snowcrash.h',
-        'src/SymbolTable.h'
+        'src/SymbolTable.h',
+        'src/Thread.h',
+        'src/Timer.h',
+        'src/Trace.cc',
+        'src/Trace.h',
+        'src/URITemplate.cc',
+        'src/URITemplate.h',
+        'src/Version.h'
       ],
       'conditions': [
         [ 'OS=="win"', 
-          { 'sources': [ 'src/win/RegexMatch.cc' ] }, 
-          { 'sources': [ 'src/posix/RegexMatch.cc' ] } # OS != Windows
+          { 'sources': [ 'src/win/MappedFile.cc', 'src/win/RegexMatch.cc', 'src/win/Thread.cc', 'src/win/Timer.cc' ] }, 
+          { 'sources': [ 'src/posix/MappedFile.cc', 'src/posix/RegexMatch.cc', 'src/posix/Thread.cc', 'src/posix/Timer.cc' ],
+            'link_settings': { 'libraries': [ '-lpthread' ] } } # OS != Windows
+        ],
+        [ 'snowcrash_allocation_accounting=="true"',
+          { 'defines': [ 'SNOWCRASH_ALLOCATION_ACCOUNTING' ] }
         ]
       ],
     },
@@ -76,25 +115,49 @@
       'type': 'executable',
       'include_dirs': [
         'src',
+        'src/snowcrash',
         'test',
         'test/vendor/Catch/include',
         'sundown/src',
         'sundown/src/html'
       ],
       'sources': [
+        'src/snowcrash/ParseCache.cc',
+        'src/snowcrash/ParseOutput.cc',
+        'src/snowcrash/ParseServer.cc',
+        'src/snowcrash/SplitOutput.cc',
+        'src/snowcrash/Watch.cc',
+        'test/Fixture.cc',
+        'test/Fixture.h',
         'test/test-AssetParser.cc',
         'test/test-Blueprint.cc',
         'test/test-BlueprintParser.cc',
+        'test/test-DeserializeJSON.cc',
         'test/test-HeaderParser.cc',
+        'test/test-JSONCheck.cc',
         'test/test-MarkdownBlock.cc',
         'test/test-MarkdownParser.cc',
         'test/test-MethodParser.cc',
+        'test/test-ParseCache.cc',
+        'test/test-ParseServer.cc',
         'test/test-Parser.cc',
+        'test/test-ParserStatistics.cc',
         'test/test-PayloadParser.cc',
         'test/test-RegexMatch.cc',
+        'test/test-Scaling.cc',
         'test/test-ResouceGroupParser.cc',
         'test/test-ResourceParser.cc',
+        'test/test-SerializeJSON.cc',
+        'test/test-SerializeMsgPack.cc',
+        'test/test-SerializeYAML.cc',
+        'test/test-Router.cc',
+        'test/test-Snapshot.cc',
+        'test/test-SplitOutput.cc',
         'test/test-SymbolTable.cc',
+        'test/test-Thread.cc',
+        'test/test-Trace.cc',
+        'test/test-URITemplate.cc',
+        'test/test-Watch.cc',
         'test/test-snowcrash.cc'
       ],
       'dependencies': [
@@ -111,6 +174,45 @@
       }
     },
 
+    {
+      'target_name': 'perf-snowcrash',
+      'type': 'executable',
+      'include_dirs': [
+        'src',
+        'perf',
+        'test',
+        'sundown/src',
+        'sundown/src/html'
+      ],
+      'sources': [
+        'perf/Benchmark.cc',
+        'perf/Benchmark.h',
+        'perf/BlueprintGenerator.cc',
+        'perf/BlueprintGenerator.h',
+        'perf/perf-Allocation.cc',
+        'perf/perf-Parser.cc',
+        'perf/perf-RegexMatch.cc',
+        'perf/perf-Router.cc',
+        'perf/perf-SectionParser.cc',
+        'perf/perf-Serialize.cc',
+        'perf/perf-URITemplate.cc',
+        'perf/perf-snowcrash.cc',
+        'test/Fixture.cc'
+      ],
+      'dependencies': [
+        'libsnowcrash',
+        'sundown'
+      ],
+      'ldflags': [
+        '-stdlib=libstdc++'
+      ],
+      'xcode_settings': {
+        'OTHER_LDFLAGS': [
+          '-stdlib=libstdc++'
+        ]
+      }
+    },
+
     {
       'target_name': 'snowcrash',
       'type': 'executable',
@@ -120,6 +222,16 @@
         'cmdline'
       ],
       'sources': [
+        'src/snowcrash/ParseCache.cc',
+        'src/snowcrash/ParseCache.h',
+        'src/snowcrash/ParseOutput.cc',
+        'src/snowcrash/ParseOutput.h',
+        'src/snowcrash/ParseServer.cc',
+        'src/snowcrash/ParseServer.h',
+        'src/snowcrash/SplitOutput.cc',
+        'src/snowcrash/SplitOutput.h',
+        'src/snowcrash/Watch.cc',
+        'src/snowcrash/Watch.h',
         'src/snowcrash/snowcrash.cc'
       ],
       'dependencies': [
@@ -135,5 +247,30 @@
         ]
       }
     }    
+  ],
+
+  'conditions': [
+    [ 'OS=="linux"', {
+      'targets': [
+        {
+          'target_name': 'snowcrash-mock',
+          'type': 'executable',
+          'include_dirs': [
+            'src',
+            'src/snowcrash-mock',
+            'cmdline'
+          ],
+          'sources': [
+            'src/snowcrash-mock/MockServer.cc',
+            'src/snowcrash-mock/MockServer.h',
+            'src/snowcrash-mock/snowcrash-mock.cc'
+          ],
+          'dependencies': [
+            'libsnowcrash',
+            'sundown'
+          ]
+        }
+      ]
+    }]
   ]
 }
\ No newline at end of file
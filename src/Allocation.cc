@@ -0,0 +1,180 @@
+//
+//  Allocation.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include "Allocation.h"
+
+using namespace snowcrash;
+
+#ifdef SNOWCRASH_ALLOCATION_ACCOUNTING
+
+#include <cstdlib>
+#include <new>
+#include "Platform.h"
+
+#if __cplusplus >= 201103L
+#   define THROW_BAD_ALLOC
+#   define THROW_NOTHING noexcept
+#else
+#   define THROW_BAD_ALLOC throw(std::bad_alloc)
+#   define THROW_NOTHING throw()
+#endif
+
+// Counters of the current thread, plain data so they are
+// usable before any static initialization takes place
+static THREADLOCAL size_t s_allocations = 0;
+static THREADLOCAL size_t s_bytes = 0;
+static THREADLOCAL ptrdiff_t s_liveBytes = 0;
+static THREADLOCAL ptrdiff_t s_peakLiveBytes = 0;
+
+// Allocation header holding the requested size,
+// sized to keep the returned memory maximally aligned
+union AllocationHeader {
+    size_t size;
+    double alignDouble;
+    long double alignLongDouble;
+    void* alignPointer;
+};
+
+// Allocate and account for `size` bytes, NULL on failure
+static void* AccountedAlloc(size_t size)
+{
+    AllocationHeader* header = static_cast<AllocationHeader*>(std::malloc(sizeof(AllocationHeader) + size));
+    if (!header)
+        return NULL;
+    
+    header->size = size;
+    
+    ++s_allocations;
+    s_bytes += size;
+    s_liveBytes += size;
+    if (s_liveBytes > s_peakLiveBytes)
+        s_peakLiveBytes = s_liveBytes;
+    
+    return header + 1;
+}
+
+// Release memory allocated by AccountedAlloc()
+static void AccountedFree(void* ptr)
+{
+    if (!ptr)
+        return;
+    
+    AllocationHeader* header = static_cast<AllocationHeader*>(ptr) - 1;
+    s_liveBytes -= header->size;
+    std::free(header);
+}
+
+// Allocate `size` bytes the way operator new does, calling the new handler
+static void* AccountedNew(size_t size, bool nothrow)
+{
+    if (size == 0)
+        size = 1;
+    
+    for (;;) {
+        void* ptr = AccountedAlloc(size);
+        if (ptr)
+            return ptr;
+        
+        std::new_handler handler = std::set_new_handler(0);
+        std::set_new_handler(handler);
+        if (!handler) {
+            if (nothrow)
+                return NULL;
+            throw std::bad_alloc();
+        }
+        
+        handler();
+    }
+}
+
+void* operator new(std::size_t size) THROW_BAD_ALLOC
+{
+    return AccountedNew(size, false);
+}
+
+void* operator new[](std::size_t size) THROW_BAD_ALLOC
+{
+    return AccountedNew(size, false);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) THROW_NOTHING
+{
+    try {
+        return AccountedNew(size, true);
+    }
+    catch (...) {
+        return NULL;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) THROW_NOTHING
+{
+    try {
+        return AccountedNew(size, true);
+    }
+    catch (...) {
+        return NULL;
+    }
+}
+
+void operator delete(void* ptr) THROW_NOTHING
+{
+    AccountedFree(ptr);
+}
+
+void operator delete[](void* ptr) THROW_NOTHING
+{
+    AccountedFree(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) THROW_NOTHING
+{
+    AccountedFree(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) THROW_NOTHING
+{
+    AccountedFree(ptr);
+}
+
+bool snowcrash::AllocationAccountingEnabled()
+{
+    return true;
+}
+
+AllocationCounters snowcrash::ThreadAllocationCounters()
+{
+    AllocationCounters counters;
+    counters.allocations = s_allocations;
+    counters.bytes = s_bytes;
+    counters.liveBytes = s_liveBytes;
+    counters.peakLiveBytes = s_peakLiveBytes;
+    return counters;
+}
+
+void snowcrash::ResetPeakLiveBytes()
+{
+    s_peakLiveBytes = s_liveBytes;
+}
+
+#else
+
+bool snowcrash::AllocationAccountingEnabled()
+{
+    return false;
+}
+
+AllocationCounters snowcrash::ThreadAllocationCounters()
+{
+    return AllocationCounters();
+}
+
+void snowcrash::ResetPeakLiveBytes()
+{
+}
+
+#endif
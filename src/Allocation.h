@@ -0,0 +1,49 @@
+//
+//  Allocation.h
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#ifndef SNOWCRASH_ALLOCATION_H
+#define SNOWCRASH_ALLOCATION_H
+
+#include <cstddef>
+
+namespace snowcrash {
+    
+    //
+    // Allocation Counters
+    //
+    // Heap allocations made through the global operator new by a thread.
+    // Live bytes are signed as memory may be released by another thread
+    // than the one that allocated it.
+    //
+    // The counters are meaningful for single-threaded parses only. Work
+    // done on worker threads, e.g. CheckJSONBodiesOption or parallel
+    // serialization, is not counted for the calling thread and memory
+    // passed between threads skews the live bytes of both.
+    //
+    struct AllocationCounters {
+        AllocationCounters()
+        : allocations(0), bytes(0), liveBytes(0), peakLiveBytes(0) {}
+        
+        size_t allocations;         // Number of allocations
+        size_t bytes;               // Bytes allocated
+        ptrdiff_t liveBytes;        // Bytes allocated and not yet released
+        ptrdiff_t peakLiveBytes;    // Peak of live bytes
+    };
+    
+    // True in the allocation accounting build of the library, that is
+    // when built with SNOWCRASH_ALLOCATION_ACCOUNTING defined
+    bool AllocationAccountingEnabled();
+    
+    // Allocation counters of the calling thread,
+    // all zero unless allocation accounting is enabled
+    AllocationCounters ThreadAllocationCounters();
+    
+    // Restart peak tracking of the calling thread at its current live bytes
+    void ResetPeakLiveBytes();
+}
+
+#endif
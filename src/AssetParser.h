@@ -12,6 +12,7 @@
 #include <sstream>
 #include "BlueprintParserCore.h"
 #include "Blueprint.h"
+#include "AssetSource.h"
 #include "ListUtility.h"
 #include "RegexMatch.h"
 #include "StringUtility.h"
@@ -135,6 +136,49 @@ namespace snowcrash {
                                                           BlueprintParserCore& parser,
                                                           Asset& asset) {
 
+            // Body to be checked is kept as its code blocks' source while
+            // there is nothing else, other blocks are copied into it
+            JSONBody* checkedBody = parser.checkedBody;
+            if (checkedBody &&
+                cur != bounds.first &&
+                checkedBody->body.empty() &&
+                AppendAssetSource(parser.sourceData, *cur, checkedBody->bodySource))
+                checkedBody = NULL;
+            
+            // Asset left out of the projection, check for content only
+            if (parser.skippedAssetContent) {
+                bool hasData;
+                SourceData data;
+                SourceDataBlock sourceMap;
+                ParseSectionResult result = ParseListPreformattedBlock(section,
+                                                                       cur,
+                                                                       bounds,
+                                                                       parser,
+                                                                       checkedBody ? &data : NULL,
+                                                                       hasData,
+                                                                       sourceMap);
+                if (result.first.error.code == Error::OK &&
+                    !parser.sourceData.empty() &&
+                    hasData) {
+                    
+                    *parser.skippedAssetContent = true;
+                    AppendCheckedBody(parser, checkedBody, data);
+                }
+                
+                return result;
+            }
+            
+            // Keep code blocks as their source while there is nothing else,
+            // a block the body to be checked has not taken is copied
+            if (parser.assetSource && !checkedBody &&
+                cur != bounds.first &&
+                asset.empty() &&
+                AppendAssetSource(parser.sourceData, *cur, *parser.assetSource)) {
+                
+                BlockIterator next = cur;
+                return std::make_pair(Result(), ++next);
+            }
+            
             SourceData data;
             SourceDataBlock sourceMap;
             ParseSectionResult result = ParseListPreformattedBlock(section,
@@ -147,9 +191,33 @@ namespace snowcrash {
                 parser.sourceData.empty())
                 return result;
             
+            // Anything else makes the whole asset a copy
+            if (parser.assetSource && !data.empty()) {
+                asset = MapAsset(parser.sourceData, *parser.assetSource);
+                *parser.assetSource = AssetSource();
+                parser.assetSource = NULL;
+            }
+            
+            AppendCheckedBody(parser, checkedBody, data);
             asset += data;
             return result;
         }
+        
+        // Append data to the body to be checked, copying its source first
+        static void AppendCheckedBody(const BlueprintParserCore& parser,
+                                      JSONBody* checkedBody,
+                                      const SourceData& data) {
+            
+            if (!checkedBody || data.empty())
+                return;
+            
+            if (checkedBody->body.empty() && !checkedBody->bodySource.sourceMap.empty()) {
+                checkedBody->body = MapAsset(parser.sourceData, checkedBody->bodySource);
+                checkedBody->bodySource = AssetSource();
+            }
+            
+            checkedBody->body += data;
+        }
 
     };
     
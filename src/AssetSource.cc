@@ -0,0 +1,187 @@
+//
+//  AssetSource.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <algorithm>
+#include <cstring>
+#include "AssetSource.h"
+
+using namespace snowcrash;
+
+// Call visitor with the location & length of each line of mapped source,
+// up to `indentation` leading spaces stripped, until it returns false
+template <class V>
+static void VisitLines(const SourceData& source,
+                       const SourceDataBlock& sourceMap,
+                       size_t indentation,
+                       V& visitor)
+{
+    for (SourceDataBlock::const_iterator it = sourceMap.begin(); it != sourceMap.end(); ++it) {
+        
+        size_t location = it->location;
+        size_t end = std::min(it->location + it->length, source.length());
+        while (location < end) {
+            
+            for (size_t stripped = 0; stripped < indentation && location < end && source[location] == ' '; ++stripped)
+                ++location;
+            
+            const void* newline = ::memchr(source.data() + location, '\n', end - location);
+            size_t lineEnd = newline ? static_cast<const char*>(newline) - source.data() + 1 : end;
+            
+            if (!visitor(location, lineEnd - location))
+                return;
+            
+            location = lineEnd;
+        }
+    }
+}
+
+// Matches mapped lines against block content, followed by blank lines only
+struct ContentMatcher {
+    ContentMatcher(const SourceData& s, const std::string& c)
+    : source(s), content(c), matched(0), end(0), match(true) {}
+    
+    bool operator()(size_t location, size_t length) {
+        
+        size_t n = std::min(length, content.length() - matched);
+        if (source.compare(location, n, content, matched, n) != 0) {
+            match = false;
+            return false;
+        }
+        
+        matched += n;
+        if (n)
+            end = location + n;
+        
+        for (size_t i = location + n; i < location + length; ++i) {
+            if (source[i] != ' ' && source[i] != '\n') {
+                match = false;
+                return false;
+            }
+        }
+        
+        return true;
+    }
+    
+    const SourceData& source;
+    const std::string& content;
+    size_t matched;     // Content matched so far
+    size_t end;         // Source location after the last character matched
+    bool match;
+};
+
+// Appends mapped lines to an asset
+struct AssetWriter {
+    AssetWriter(const SourceData& s, Asset& a) : source(s), asset(a) {}
+    
+    bool operator()(size_t location, size_t length) {
+        asset.append(source, location, length);
+        return true;
+    }
+    
+    const SourceData& source;
+    Asset& asset;
+};
+
+// Writes mapped lines to a stream
+struct StreamWriter {
+    StreamWriter(const SourceData& s, std::ostream& o) : source(s), os(o) {}
+    
+    bool operator()(size_t location, size_t length) {
+        os.write(source.data() + location, length);
+        return true;
+    }
+    
+    const SourceData& source;
+    std::ostream& os;
+};
+
+bool snowcrash::AppendAssetSource(const SourceData& source,
+                                  const MarkdownBlock& block,
+                                  AssetSource& assetSource)
+{
+    const std::string& content = block.content;
+    if (block.type != CodeBlockType ||
+        block.sourceMap.empty() ||
+        content.empty() ||
+        content[content.length() - 1] != '\n')
+        return false;
+    
+    // Indentation of the first line
+    size_t location = block.sourceMap.front().location;
+    size_t sourceSpaces = 0;
+    while (location + sourceSpaces < source.length() && source[location + sourceSpaces] == ' ')
+        ++sourceSpaces;
+    
+    size_t contentSpaces = content.find_first_not_of(' ');
+    if (contentSpaces == std::string::npos || sourceSpaces < contentSpaces)
+        return false;
+    
+    size_t indentation = sourceSpaces - contentSpaces;
+    if (!assetSource.sourceMap.empty() && assetSource.indentation != indentation)
+        return false;
+    
+    ContentMatcher matcher(source, content);
+    VisitLines(source, block.sourceMap, indentation, matcher);
+    if (!matcher.match || matcher.matched != content.length())
+        return false;
+    
+    // Leave the trailing blank lines out
+    SourceDataBlock sourceMap;
+    for (SourceDataBlock::const_iterator it = block.sourceMap.begin(); it != block.sourceMap.end(); ++it) {
+        if (it->location >= matcher.end)
+            break;
+        
+        SourceDataRange range = *it;
+        range.length = std::min(range.length, matcher.end - range.location);
+        sourceMap.push_back(range);
+    }
+    
+    assetSource.source = &source;
+    assetSource.indentation = indentation;
+    AppendSourceDataBlock(assetSource.sourceMap, sourceMap);
+    return true;
+}
+
+Asset snowcrash::MapAsset(const SourceData& source, const AssetSource& assetSource)
+{
+    size_t length = 0;
+    for (SourceDataBlock::const_iterator it = assetSource.sourceMap.begin(); it != assetSource.sourceMap.end(); ++it)
+        length += it->length;
+    
+    Asset asset;
+    asset.reserve(length);
+    
+    AssetWriter writer(source, asset);
+    VisitLines(source, assetSource.sourceMap, assetSource.indentation, writer);
+    return asset;
+}
+
+void snowcrash::WriteAsset(const SourceData& source, const AssetSource& assetSource, std::ostream& os)
+{
+    StreamWriter writer(source, os);
+    VisitLines(source, assetSource.sourceMap, assetSource.indentation, writer);
+}
+
+// Payload asset or the asset rendered from its source into storage
+static const Asset& PayloadAsset(const Asset& asset, const AssetSource& assetSource, Asset& storage)
+{
+    if (!assetSource.source || assetSource.sourceMap.empty())
+        return asset;
+    
+    storage = MapAsset(*assetSource.source, assetSource);
+    return storage;
+}
+
+const Asset& snowcrash::PayloadBody(const Payload& payload, Asset& storage)
+{
+    return PayloadAsset(payload.body, payload.bodySource, storage);
+}
+
+const Asset& snowcrash::PayloadSchema(const Payload& payload, Asset& storage)
+{
+    return PayloadAsset(payload.schema, payload.schemaSource, storage);
+}
@@ -0,0 +1,37 @@
+//
+//  AssetSource.h
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#ifndef SNOWCRASH_ASSETSOURCE_H
+#define SNOWCRASH_ASSETSOURCE_H
+
+#include <ostream>
+#include "Blueprint.h"
+#include "MarkdownBlock.h"
+
+namespace snowcrash {
+    
+    // Append a code block to asset source. Returns false, leaving
+    // the asset source intact, unless the block content is exactly
+    // its source with the same indentation stripped from each line.
+    bool AppendAssetSource(const SourceData& source,
+                           const MarkdownBlock& block,
+                           AssetSource& assetSource);
+    
+    // Asset rendered from its source
+    Asset MapAsset(const SourceData& source, const AssetSource& assetSource);
+    
+    // Write asset from its source, without copying it first
+    void WriteAsset(const SourceData& source, const AssetSource& assetSource, std::ostream& os);
+    
+    // Body & schema of a payload. An asset kept as its source, see
+    // AssetSourceOption, is rendered into storage, otherwise the
+    // payload's own asset is returned.
+    const Asset& PayloadBody(const Payload& payload, Asset& storage);
+    const Asset& PayloadSchema(const Payload& payload, Asset& storage);
+}
+
+#endif
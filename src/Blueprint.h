@@ -12,6 +12,7 @@
 #include <vector>
 #include <string>
 #include <utility>
+#include "ParserCore.h"
 
 namespace snowcrash {
     
@@ -52,12 +53,75 @@ namespace snowcrash {
     
     // Asset data
     typedef std::string Asset;
+    
+    // Asset kept as ranges of the source data, see AssetSource.h
+    //
+    // The ranges point into the source data passed to the parser,
+    // e.g. parse(), which must outlive the AST.
+    //
+    struct AssetSource {
+        AssetSource() : source(NULL), indentation(0) {}
+        
+        // Source data the ranges point into
+        const SourceData* source;
+        
+        // Ranges of the source data, each starting at a line start
+        SourceDataBlock sourceMap;
+        
+        // Spaces stripped from the start of each line
+        size_t indentation;
+    };
 
     // Metadata key-value pair, e.g. "HOST: http://acme.com"
     typedef KeyValuePair Metadata;
 
     // Header key-value pair, e.g. "Content-Type: application/json"
     typedef KeyValuePair Header;
+
+    // URI template variable, RFC 6570
+    struct URITemplateVariable {
+
+        // Variable name
+        Name name;
+
+        // Prefix modifier length, e.g. 3 for `{var:3}`, 0 if none
+        size_t maxLength;
+
+        // Explode modifier, e.g. `{var*}`
+        bool explode;
+    };
+
+    // Type of a compiled URI template part
+    enum URITemplatePartType {
+        LiteralURITemplatePartType,
+        ExpressionURITemplatePartType
+    };
+
+    // Literal or expression of a compiled URI template
+    struct URITemplatePart {
+
+        // Part type
+        URITemplatePartType type;
+
+        // Literal text, literal part only
+        std::string literal;
+
+        // Expression operator (one of `+#./;?&`), '\0' for a simple expression
+        char op;
+
+        // Expression variables
+        Collection<URITemplateVariable>::type variables;
+    };
+
+    // URI template split into literals and expressions
+    struct CompiledURITemplate {
+
+        // Parts
+        Collection<URITemplatePart>::type parts;
+
+        // Literal prefix preceding the first expression
+        std::string prefix;
+    };
     
     // Parameter
     struct Parameter {
@@ -91,6 +155,12 @@ namespace snowcrash {
         
         // Schema
         Asset schema;
+        
+        // Body & schema source, used instead of the body & schema with
+        // AssetSourceOption. Read the asset with PayloadBody() and
+        // PayloadSchema(), see AssetSource.h
+        AssetSource bodySource;
+        AssetSource schemaSource;
     };
     
     // Resource Object
@@ -132,6 +202,9 @@ namespace snowcrash {
         
         // URI template
         URITemplate uriTemplate;
+
+        // Compiled URI template
+        CompiledURITemplate compiledURITemplate;
         
         // Resource Name
         Name name;
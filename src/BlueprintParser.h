@@ -16,6 +16,7 @@
 #include "Blueprint.h"
 #include "ResourceParser.h"
 #include "ResourceGroupParser.h"
+#include "ParserStatistics.h"
 
 static const std::string ExpectedAPINameMessage = "expected API name, e.g. `# <API Name>`";
 
@@ -134,7 +135,7 @@ namespace snowcrash {
                     }
                     else {
                         // WARN: No API name specified
-                        result.first.warnings.push_back(Warning(ExpectedAPINameMessage,
+                        result.first.warnings.push_back(Warning(ExpectedAPINameWarning,
                                                                 0,
                                                                 sectionCur->sourceMap));
                     }
@@ -142,7 +143,9 @@ namespace snowcrash {
                 
                 if (!CheckCursor(sectionCur, bounds, cur, result.first))
                     return result;
-                output.description += MapSourceData(parser.sourceData, sectionCur->sourceMap);
+                
+                if (!(parser.options & SkipDescriptionsOption))
+                    output.description += MapSourceData(parser.sourceData, sectionCur->sourceMap);
             }
             
             result.second = ++sectionCur;
@@ -159,20 +162,38 @@ namespace snowcrash {
             if (result.first.error.code != Error::OK)
                 return result;
             
-            Collection<ResourceGroup>::const_iterator duplicate = FindResourceGroup(parser.blueprint, resourceGroup);
-            if (duplicate != parser.blueprint.resourceGroups.end()) {
+            CountLookup();
+            if (!parser.resourceGroupIndex.insert(resourceGroup.name).second) {
                 
                 // WARN: duplicate group
-                std::stringstream ss;
-                if (resourceGroup.name.empty()) {
-                    ss << "anonymous group";
-                }
-                else {
-                    ss << "group `" << resourceGroup.name << "`";
-                }
-                ss << " is already defined";
+                result.first.warnings.push_back(Warning(DuplicateResourceGroupWarning,
+                                                        0,
+                                                        begin->sourceMap,
+                                                        resourceGroup.name));
+            }
+            
+            if (parser.options & ValidateOnlyOption) {
+                
+                // Groups are checked against the index only
+                if (parser.statistics)
+                    CountASTSize(*parser.statistics, ASTSize(resourceGroup), 0);
                 
-                result.first.warnings.push_back(Warning(ss.str(), 0, begin->sourceMap));
+                return result;
+            }
+            
+            if (parser.delegate) {
+                parser.delegate->handleResourceGroup(parser.blueprint, resourceGroup);
+                
+                // Nothing is kept, the duplicate checks use the indices
+                if (parser.statistics)
+                    CountASTSize(*parser.statistics, ASTSize(resourceGroup), 0);
+                
+                return result;
+            }
+            
+            if (parser.statistics) {
+                size_t size = ASTSize(resourceGroup);
+                CountASTSize(*parser.statistics, size, size);
             }
             
             output.resourceGroups.push_back(resourceGroup); // FIXME: C++11 move
@@ -224,11 +245,10 @@ namespace snowcrash {
                         duplicateKeys.push_back(it->first);
                         
                         // WARN: duplicate metada definition
-                        std::stringstream ss;
-                        ss << "duplicate definition of `" << it->first << "`";
-                        result.first.warnings.push_back(Warning(ss.str(),
+                        result.first.warnings.push_back(Warning(DuplicateMetadataWarning,
                                                                 0,
-                                                                cur->sourceMap));
+                                                                cur->sourceMap,
+                                                                it->first));
                     }
                 }
                 
@@ -241,8 +261,7 @@ namespace snowcrash {
             }
             else if (!metadataCollection.empty()) {
                 // WARN: malformed metadata block
-                result.first.warnings.push_back(Warning("ignoring possible metadata, expected"
-                                                        " `<key> : <value>`, one one per line",
+                result.first.warnings.push_back(Warning(MetadataFormattingWarning,
                                                         0,
                                                         cur->sourceMap));
             }
@@ -264,9 +283,15 @@ namespace snowcrash {
                           const MarkdownBlock::Stack& source,
                           BlueprintParserOptions options,
                           Result& result,
-                          Blueprint& blueprint) {
+                          Blueprint& blueprint,
+                          BlueprintParserDelegate* delegate = NULL,
+                          ParserStatistics* statistics = NULL,
+                          Trace* trace = NULL,
+                          const ParserBudget* budget = NULL) {
             
-            BlueprintParserCore parser(options, sourceData, blueprint);
+            BlueprintParserCore parser(options, sourceData, blueprint, delegate, statistics, trace, budget);
+            parser.warnings = result.warnings.size();
+            LookupCountScope lookups(statistics ? &statistics->lookups : NULL);
             ParseSectionResult sectionResult = BlueprintParserInner::Parse(source.begin(),
                                                                            source.end(),
                                                                            parser,
@@ -276,10 +301,10 @@ namespace snowcrash {
 #ifdef DEBUG
             PrintSymbolTable(parser.symbolTable);
 #endif
-            if (result.error.code != Error::OK)
-                return;
-            
-            PostParseCheck(sourceData, source, parser, result);
+            if (result.error.code == Error::OK) {
+                PostParseCheck(sourceData, source, parser, result);
+                CheckJSONBodies(sourceData, parser.jsonBodies, result);
+            }
         }
         
         // Perform additional post-parsing result checks
@@ -10,11 +10,15 @@
 #define SNOWCRASH_BLUEPRINTPARSERCORE_H
 
 #include <algorithm>
+#include <set>
 #include "StringUtility.h"
 #include "ParserCore.h"
 #include "MarkdownBlock.h"
 #include "Blueprint.h"
 #include "SymbolTable.h"
+#include "ParserBudget.h"
+#include "JSONCheck.h"
+#include "Timer.h"
 
 // Recognized HTTP headers, regex string
 #define HTTP_METHODS "GET|POST|PUT|DELETE|OPTIONS|PATCH|PROPPATCH|LOCK|UNLOCK|COPY|MOVE|MKCOL|HEAD"
@@ -80,10 +84,41 @@ namespace snowcrash {
     // Section boundaries (begin : end)
     typedef std::pair<BlockIterator, BlockIterator> SectionBounds;
     
+    // Count duplicate check lookups of the calling thread into the counter,
+    // NULL stops counting. Returns the counter set before.
+    size_t* SetLookupCounter(size_t* counter);
+    
+    // Add a lookup to the counter of the calling thread, if any. Every entry
+    // compared by a matching predicate and every index lookup is one lookup.
+    void CountLookup();
+    
+    //
+    // Scope counting duplicate check lookups of the calling thread,
+    // see ParserStatistics::lookups
+    //
+    class LookupCountScope {
+    public:
+        explicit LookupCountScope(size_t* counter)
+        : m_previous(counter ? SetLookupCounter(counter) : NULL), m_active(counter != NULL) {}
+        
+        ~LookupCountScope() {
+            if (m_active)
+                SetLookupCounter(m_previous);
+        }
+        
+    private:
+        size_t* m_previous;
+        bool m_active;
+        
+        LookupCountScope(const LookupCountScope&);
+        LookupCountScope& operator=(const LookupCountScope&);
+    };
+    
     // Name matching predicate
     template <class T>
     struct MatchName : std::binary_function<T, T, bool> {
         bool operator()(const T& first, const T& second) const {
+            CountLookup();
             return first.name == second.name;
         }
     };
@@ -92,6 +127,7 @@ namespace snowcrash {
     template <class T>
     struct MatchURI : std::binary_function<T, T, bool> {
         bool operator()(const T& first, const T& second) const {
+            CountLookup();
             return first.uriTemplate == second.uriTemplate;
         }
     };
@@ -100,6 +136,7 @@ namespace snowcrash {
     template <class T>
     struct MatchMethod : std::binary_function<T, T, bool> {
         bool operator()(const T& first, const T& second) const {
+            CountLookup();
             return first.method == second.method;
         }
     };
@@ -117,23 +154,120 @@ namespace snowcrash {
     //
     enum BlueprintParserOption {
         RenderDescriptionsOption = (1 << 0),    // Render Markdown in description
-        RequireBlueprintNameOption = (1 << 1)   // Treat missing blueprint name as error
+        RequireBlueprintNameOption = (1 << 1),  // Treat missing blueprint name as error
+        ValidateOnlyOption = (1 << 2),          // Check the source only, build no AST but
+                                                // the blueprint name & metadata, see validate()
+        
+        // Projections, leave parts of the AST out. The rest of the AST
+        // and the parser result are the same as of a full parse.
+        SkipDescriptionsOption = (1 << 3),      // No descriptions
+        SkipBodiesOption = (1 << 4),            // No payload bodies
+        SkipSchemasOption = (1 << 5),           // No payload schemas
+        SkipHeadersOption = (1 << 6),           // No resource, method & payload headers
+        
+        AssetSourceOption = (1 << 7),           // Keep code block bodies & schemas as their
+                                                // source, see Payload::bodySource
+        CheckJSONBodiesOption = (1 << 8)        // Warn about JSON media type bodies that are
+                                                // not well-formed JSON, see CheckJSONBodies()
     };
     typedef unsigned int BlueprintParserOptions;
     
+    // Projections implied by ValidateOnlyOption
+    static const BlueprintParserOptions ValidateOnlyProjection = SkipDescriptionsOption |
+                                                                 SkipBodiesOption |
+                                                                 SkipSchemasOption |
+                                                                 SkipHeadersOption;
+    
+    //
+    // Blueprint Parser Delegate
+    //
+    // Receives every resource group as soon as it is parsed. When a delegate
+    // is set no group is kept in the blueprint AST, its resource groups are
+    // left empty. Only the names & URI templates parsed so far are kept, in
+    // the parser core indices, for the duplicate checks.
+    //
+    class BlueprintParserDelegate {
+    public:
+        virtual ~BlueprintParserDelegate() {}
+        
+        // A resource group has been parsed. Blueprint overview (metadata,
+        // name & description) is complete at the time of the first call.
+        virtual void handleResourceGroup(const Blueprint& blueprint, const ResourceGroup& resourceGroup) = 0;
+    };
+    
+    // Parser statistics, see ParserStatistics.h
+    struct ParserStatistics;
+    void CountSection(ParserStatistics& statistics, Section section);
+    
+    // Span trace, see Trace.h
+    class Trace;
+    
+    // Record span of a section parsed from first to last block, started at begin
+    void TraceSection(Trace& trace,
+                      Section section,
+                      double begin,
+                      const BlockIterator& first,
+                      const BlockIterator& last);
+    
     //
     // Parser Core Data
     //
     struct BlueprintParserCore {
         BlueprintParserCore(BlueprintParserOptions opts,
                             const SourceData& src,
-                            const Blueprint& bp)
-        : options(opts), sourceData(src), blueprint(bp) {}
+                            const Blueprint& bp,
+                            BlueprintParserDelegate* dlg = NULL,
+                            ParserStatistics* stats = NULL,
+                            Trace* trc = NULL,
+                            const ParserBudget* bgt = NULL)
+        : options((opts & ValidateOnlyOption) ? (opts | ValidateOnlyProjection) : opts), sourceData(src), blueprint(bp), delegate(dlg), statistics(stats), trace(trc), budget(bgt), warnings(0), assetSource(NULL), skippedAssetContent(NULL), skippedBody(false), skippedSchema(false), checkedBody(NULL) {}
         
         BlueprintParserOptions options;
         SymbolTable symbolTable;
         const SourceData& sourceData;
         const Blueprint& blueprint;
+        BlueprintParserDelegate* delegate;
+        ParserStatistics* statistics;
+        Trace* trace;
+        const ParserBudget* budget;
+        
+        // Warnings reported in the whole source so far, for the budget
+        size_t warnings;
+        
+        // Names of resource groups parsed so far, for duplicate checks
+        std::set<Name> resourceGroupIndex;
+        
+        // URI templates of resources parsed so far, for duplicate checks
+        std::set<URITemplate> resourceIndex;
+        
+        // Names of requests & responses of the method being parsed,
+        // for duplicate checks
+        std::set<Name> requestIndex;
+        std::set<Name> responseIndex;
+        
+        // Source of the asset being parsed, NULL unless it is to be kept,
+        // see AssetSourceOption
+        AssetSource* assetSource;
+        
+        // Set if the asset being parsed has any content, NULL unless the
+        // asset is left out of the projection. Such asset is not built.
+        bool* skippedAssetContent;
+        
+        // Assets of the payload being parsed, left out of the projection,
+        // that had any content. For the duplicate asset checks.
+        bool skippedBody;
+        bool skippedSchema;
+        
+        // Body of the payload being parsed, to be checked once the payload
+        // is complete, see CheckJSONBodiesOption. Its source map is empty
+        // unless there is one.
+        JSONBody jsonBody;
+        
+        // Body being parsed, NULL unless it is to be checked
+        JSONBody* checkedBody;
+        
+        // Bodies to be checked once parsed, see CheckJSONBodiesOption
+        std::vector<JSONBody> jsonBodies;
         
     private:
         BlueprintParserCore();
@@ -194,19 +328,32 @@ namespace snowcrash {
             Result result;
             Section currentSection = UndefinedSection;
             BlockIterator currentBlock = begin;
+            size_t warnings = parser.warnings;
             while (currentBlock != end) {
                 
                 currentSection = ClassifyBlock<T>(currentBlock, end, currentSection);
+                if (parser.statistics)
+                    CountSection(*parser.statistics, currentSection);
+                
+                double sectionBegin = parser.trace ? Now() : 0;
                 ParseSectionResult sectionResult = P::ParseSection(currentSection,
                                                                    currentBlock,
                                                                    std::make_pair(begin, end),
                                                                    parser,
                                                                    output);
+                if (parser.trace)
+                    TraceSection(*parser.trace, currentSection, sectionBegin, currentBlock, sectionResult.second);
                 
                 result += sectionResult.first;
                 if (result.error.code != Error::OK)
                     break;
                 
+                if (parser.budget) {
+                    parser.warnings = warnings + result.warnings.size();
+                    if (!CheckBudget(*parser.budget, parser.warnings, result, currentBlock->sourceMap))
+                        break;
+                }
+                
                 if (sectionResult.second == currentBlock)
                     break;
 
@@ -245,6 +392,24 @@ namespace snowcrash {
         return currentBlock;
     }
     
+    // Parse the key of one line of raw `key:value` data, leaving the value out.
+    // Returns true if the line is a valid key-value pair, false otherwise.
+    FORCEINLINE bool KeyFromLine(const std::string& line,
+                                 std::string& key) {
+        
+        std::string::size_type delimiter = line.find(':');
+        if (delimiter == std::string::npos)
+            return false;
+        
+        std::string::const_iterator value = line.begin() + delimiter + 1;
+        if (std::find_if(value, line.end(), std::not1(std::ptr_fun<int, int>(std::isspace))) == line.end())
+            return false;
+        
+        key = line.substr(0, delimiter);
+        TrimString(key);
+        return !key.empty();
+    }
+    
     // Parse one line of raw `key:value` data.
     // Returns true on success, false otherwise.
     FORCEINLINE bool KeyValueFromLine(const std::string& line,
@@ -0,0 +1,358 @@
+//
+//  DeserializeJSON.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <cstring>
+#include <iterator>
+#include <vector>
+#include "DeserializeJSON.h"
+#include "Serialize.h"
+#include "URITemplate.h"
+
+using namespace snowcrash;
+
+namespace {
+
+    //
+    // Recursive descent reader of the AST JSON
+    //
+    class JSONReader {
+    public:
+        JSONReader(char* data, size_t length, Error& error)
+        : m_begin(data), m_cur(data), m_end(data + length), m_error(error) {}
+
+        // Read the blueprint, returns false on error
+        bool read(Blueprint& blueprint) {
+            if (!readValue(blueprint))
+                return false;
+
+            skipWhitespace();
+            if (m_cur != m_end)
+                return fail("unexpected data after the blueprint");
+
+            return true;
+        }
+
+    private:
+        char* m_begin;
+        char* m_cur;
+        char* m_end;
+        Error& m_error;
+
+        // Set error at the current position, always returns false
+        bool fail(const std::string& message) {
+            size_t location = m_cur - m_begin;
+            m_error = Error(message, 1, MakeSourceDataBlock(location, (m_cur < m_end) ? 1 : 0));
+            return false;
+        }
+
+        void skipWhitespace() {
+            while (m_cur < m_end &&
+                   (*m_cur == ' ' || *m_cur == '\n' || *m_cur == '\r' || *m_cur == '\t'))
+                ++m_cur;
+        }
+
+        // Consume the character if it is next
+        bool consume(char c) {
+            skipWhitespace();
+            if (m_cur < m_end && *m_cur == c) {
+                ++m_cur;
+                return true;
+            }
+
+            return false;
+        }
+
+        // Consume the character, fail if it is not next
+        bool expect(char c) {
+            if (consume(c))
+                return true;
+
+            return fail(std::string("expected `") + c + "`");
+        }
+
+        // Read four hex digits of an \u escape
+        bool readHex(unsigned int& value) {
+            if (m_end - m_cur < 4)
+                return fail("invalid unicode escape");
+
+            value = 0;
+            for (int i = 0; i < 4; ++i, ++m_cur) {
+                char c = *m_cur;
+                value <<= 4;
+                if (c >= '0' && c <= '9')
+                    value |= c - '0';
+                else if (c >= 'a' && c <= 'f')
+                    value |= c - 'a' + 10;
+                else if (c >= 'A' && c <= 'F')
+                    value |= c - 'A' + 10;
+                else
+                    return fail("invalid unicode escape");
+            }
+
+            return true;
+        }
+
+        // Write code point as UTF-8, never longer than its escape
+        static char* writeUTF8(unsigned int codePoint, char* out) {
+            if (codePoint < 0x80) {
+                *out++ = static_cast<char>(codePoint);
+            }
+            else if (codePoint < 0x800) {
+                *out++ = static_cast<char>(0xc0 | (codePoint >> 6));
+                *out++ = static_cast<char>(0x80 | (codePoint & 0x3f));
+            }
+            else if (codePoint < 0x10000) {
+                *out++ = static_cast<char>(0xe0 | (codePoint >> 12));
+                *out++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+                *out++ = static_cast<char>(0x80 | (codePoint & 0x3f));
+            }
+            else {
+                *out++ = static_cast<char>(0xf0 | (codePoint >> 18));
+                *out++ = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3f));
+                *out++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+                *out++ = static_cast<char>(0x80 | (codePoint & 0x3f));
+            }
+
+            return out;
+        }
+
+        // Read a string, unescaping it in place.
+        // On success str points to the unescaped string in the buffer.
+        bool readString(const char*& str, size_t& length) {
+            if (!expect('"'))
+                return false;
+
+            char* out = m_cur;
+            str = out;
+            while (true) {
+
+                // Copy up to the next quote or escape
+                char* run = m_cur;
+                while (m_cur < m_end && *m_cur != '"' && *m_cur != '\\')
+                    ++m_cur;
+
+                if (out != run)
+                    ::memmove(out, run, m_cur - run);
+                out += m_cur - run;
+
+                if (m_cur == m_end)
+                    return fail("unterminated string");
+
+                if (*m_cur++ == '"')
+                    break;
+
+                if (m_cur == m_end)
+                    return fail("unterminated string");
+
+                char escaped = *m_cur++;
+                switch (escaped) {
+                    case '"':  *out++ = '"'; break;
+                    case '\\': *out++ = '\\'; break;
+                    case '/':  *out++ = '/'; break;
+                    case 'n':  *out++ = '\n'; break;
+                    case 'r':  *out++ = '\r'; break;
+                    case 't':  *out++ = '\t'; break;
+                    case 'b':  *out++ = '\b'; break;
+                    case 'f':  *out++ = '\f'; break;
+                    case 'u': {
+                        unsigned int codePoint;
+                        if (!readHex(codePoint))
+                            return false;
+
+                        // Surrogate pair
+                        if (codePoint >= 0xd800 && codePoint < 0xdc00 &&
+                            m_end - m_cur >= 2 && m_cur[0] == '\\' && m_cur[1] == 'u') {
+
+                            m_cur += 2;
+                            unsigned int low;
+                            if (!readHex(low))
+                                return false;
+
+                            if (low < 0xdc00 || low >= 0xe000)
+                                return fail("invalid unicode surrogate pair");
+
+                            codePoint = 0x10000 + ((codePoint - 0xd800) << 10) + (low - 0xdc00);
+                        }
+
+                        out = writeUTF8(codePoint, out);
+                        break;
+                    }
+                    default:
+                        --m_cur;
+                        return fail("invalid escape sequence");
+                }
+            }
+
+            length = out - str;
+            return true;
+        }
+
+        bool readValue(std::string& value) {
+            const char* str;
+            size_t length;
+            if (!readString(str, length))
+                return false;
+
+            value.assign(str, length);
+            return true;
+        }
+
+        // Key value pair, an object with a single member
+        bool readValue(KeyValuePair& pair) {
+            return expect('{') &&
+                   readValue(pair.first) &&
+                   expect(':') &&
+                   readValue(pair.second) &&
+                   expect('}');
+        }
+
+        template <typename T>
+        bool readValue(T& value) {
+            if (!expect('{'))
+                return false;
+
+            if (consume('}'))
+                return true;
+
+            do {
+                const char* key;
+                size_t length;
+                if (!readString(key, length) || !expect(':'))
+                    return false;
+
+                if (!readMember(value, key, length))
+                    return false;
+
+            } while (consume(','));
+
+            return expect('}');
+        }
+
+        template <typename T>
+        bool readValue(std::vector<T>& values) {
+            if (!expect('['))
+                return false;
+
+            if (consume(']'))
+                return true;
+
+            do {
+                values.push_back(T());
+                if (!readValue(values.back()))
+                    return false;
+
+            } while (consume(','));
+
+            return expect(']');
+        }
+
+        // Unknown key of an object
+        bool unexpectedKey(const char* key, size_t length) {
+            return fail("unexpected key `" + std::string(key, length) + "`");
+        }
+
+        static bool isKey(const char* key, size_t length, const std::string& name) {
+            return length == name.length() && ::memcmp(key, name.data(), length) == 0;
+        }
+
+        bool readMember(Payload& payload, const char* key, size_t length) {
+            if (isKey(key, length, SerializeKey::Name))
+                return readValue(payload.name);
+            if (isKey(key, length, SerializeKey::Description))
+                return readValue(payload.description);
+            if (isKey(key, length, SerializeKey::Body))
+                return readValue(payload.body);
+            if (isKey(key, length, SerializeKey::Schema))
+                return readValue(payload.schema);
+            if (isKey(key, length, SerializeKey::Headers))
+                return readValue(payload.headers);
+
+            return unexpectedKey(key, length);
+        }
+
+        bool readMember(Method& method, const char* key, size_t length) {
+            if (isKey(key, length, SerializeKey::Method))
+                return readValue(method.method);
+            if (isKey(key, length, SerializeKey::Name))
+                return readValue(method.name);
+            if (isKey(key, length, SerializeKey::Description))
+                return readValue(method.description);
+            if (isKey(key, length, SerializeKey::Headers))
+                return readValue(method.headers);
+            if (isKey(key, length, SerializeKey::Requests))
+                return readValue(method.requests);
+            if (isKey(key, length, SerializeKey::Responses))
+                return readValue(method.responses);
+
+            return unexpectedKey(key, length);
+        }
+
+        bool readMember(Resource& resource, const char* key, size_t length) {
+            if (isKey(key, length, SerializeKey::URITemplate)) {
+                if (!readValue(resource.uriTemplate))
+                    return false;
+
+                // As the parser does
+                CompileURITemplate(resource.uriTemplate, resource.compiledURITemplate);
+                return true;
+            }
+            if (isKey(key, length, SerializeKey::Name))
+                return readValue(resource.name);
+            if (isKey(key, length, SerializeKey::Description))
+                return readValue(resource.description);
+            if (isKey(key, length, SerializeKey::Object))
+                return readValue(resource.object);
+            if (isKey(key, length, SerializeKey::Headers))
+                return readValue(resource.headers);
+            if (isKey(key, length, SerializeKey::Methods))
+                return readValue(resource.methods);
+
+            return unexpectedKey(key, length);
+        }
+
+        bool readMember(ResourceGroup& resourceGroup, const char* key, size_t length) {
+            if (isKey(key, length, SerializeKey::Name))
+                return readValue(resourceGroup.name);
+            if (isKey(key, length, SerializeKey::Description))
+                return readValue(resourceGroup.description);
+            if (isKey(key, length, SerializeKey::Resources))
+                return readValue(resourceGroup.resources);
+
+            return unexpectedKey(key, length);
+        }
+
+        bool readMember(Blueprint& blueprint, const char* key, size_t length) {
+            if (isKey(key, length, SerializeKey::Metadata))
+                return readValue(blueprint.metadata);
+            if (isKey(key, length, SerializeKey::Name))
+                return readValue(blueprint.name);
+            if (isKey(key, length, SerializeKey::Description))
+                return readValue(blueprint.description);
+            if (isKey(key, length, SerializeKey::ResourceGroups))
+                return readValue(blueprint.resourceGroups);
+
+            return unexpectedKey(key, length);
+        }
+    };
+}
+
+void snowcrash::DeserializeJSON(char* buffer, size_t length, Blueprint& blueprint, Error& error)
+{
+    JSONReader reader(buffer, length, error);
+    reader.read(blueprint);
+}
+
+void snowcrash::DeserializeJSON(std::istream& is, Blueprint& blueprint, Error& error)
+{
+    std::vector<char> buffer((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+    if (buffer.empty()) {
+        error = Error("no input data", 1);
+        return;
+    }
+
+    DeserializeJSON(&buffer[0], buffer.size(), blueprint, error);
+}
@@ -0,0 +1,28 @@
+//
+//  DeserializeJSON.h
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#ifndef SNOWCRASH_DESERIALIZE_JSON_H
+#define SNOWCRASH_DESERIALIZE_JSON_H
+
+#include <istream>
+#include "Blueprint.h"
+#include "ParserCore.h"
+
+namespace snowcrash {
+
+    // Deserialize AST from JSON produced by SerializeJSON(), pretty or compact.
+    //
+    // Reads exactly the SerializeKey schema in a single pass. Strings are
+    // unescaped in place, the buffer content is modified. On malformed input
+    // the error is set, its location is the offending byte in the buffer.
+    void DeserializeJSON(char* buffer, size_t length, snowcrash::Blueprint& blueprint, snowcrash::Error& error);
+
+    // Deserialize AST from JSON read from input stream
+    void DeserializeJSON(std::istream& is, snowcrash::Blueprint& blueprint, snowcrash::Error& error);
+}
+
+#endif
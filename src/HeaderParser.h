@@ -132,6 +132,10 @@ namespace snowcrash {
                 parser.sourceData.empty())
                 return result;
             
+            // Headers left out of the projection keep their keys only, for
+            // the duplicate checks. The values are needed to check JSON bodies.
+            bool keysOnly = (parser.options & SkipHeadersOption) && !(parser.options & CheckJSONBodiesOption);
+            
             // Proces raw data
             std::vector<std::string> lines = Split(data, '\n');
             for (std::vector<std::string>::iterator line = lines.begin();
@@ -139,15 +143,14 @@ namespace snowcrash {
                  ++line) {
                 
                 Header header;
-                if (KeyValueFromLine(*line, header)) {
+                if (keysOnly ? KeyFromLine(*line, header.first) : KeyValueFromLine(*line, header)) {
                     
                     if (FindHeader(headers, header) != headers.end()) {
                         // WARN: duplicate header on this level
-                        std::stringstream ss;
-                        ss << "duplicate definition of `" << header.first << "` header";
-                        result.first.warnings.push_back(Warning(ss.str(),
-                                                                0   ,
-                                                                sourceMap));
+                        result.first.warnings.push_back(Warning(DuplicateHeaderWarning,
+                                                                0,
+                                                                sourceMap,
+                                                                header.first));
                         
                     }
                         
@@ -155,10 +158,9 @@ namespace snowcrash {
                 }
                 else {
                     // WARN: unable to parse header
-                    result.first.warnings.push_back(Warning("unable to parse HTTP header, expected"
-                                                            " `<header name> : <header value>`, one header per line",
-                                               1,
-                                               sourceMap));
+                    result.first.warnings.push_back(Warning(HeaderFormattingWarning,
+                                                            1,
+                                                            sourceMap));
                 }
             }
             
@@ -184,7 +186,7 @@ namespace snowcrash {
         
         if (t.headers.size() == headerCount) {
             BlockIterator nameBlock = ListItemNameBlock(begin, end);
-            result.first.warnings.push_back(Warning("no headers specified",
+            result.first.warnings.push_back(Warning(NoHeadersWarning,
                                                     0,
                                                     nameBlock->sourceMap));
         }
@@ -201,11 +203,10 @@ namespace snowcrash {
         for (HeaderIterator it = right.headers.begin(); it != right.headers.end(); ++it) {
             if (FindHeader(left.headers, *it) != left.headers.end()) {
                 // WARN: overshadowing header definition
-                std::stringstream ss;
-                ss << "overshadowing `" << it->first << "` header definition";
-                result.warnings.push_back(Warning(ss.str(),
+                result.warnings.push_back(Warning(OvershadowingHeaderWarning,
                                                   0,
-                                                  rightSourceMap));
+                                                  rightSourceMap,
+                                                  it->first));
             }
         }
     }
@@ -0,0 +1,454 @@
+//
+//  JSONCheck.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include "JSONCheck.h"
+#include "AssetSource.h"
+#include "StringUtility.h"
+#include "Thread.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define SNOWCRASH_JSON_SSE2
+#   include <emmintrin.h>
+#   if defined(_MSC_VER)
+#       include <intrin.h>
+#   endif
+#endif
+
+using namespace snowcrash;
+
+// Total size of bodies worth checking in parallel
+static const size_t ParallelCheckSize = 256 * 1024;
+
+namespace {
+
+#if defined(SNOWCRASH_JSON_SSE2)
+
+    // Index of the lowest bit set, mask must not be zero
+    FORCEINLINE unsigned int LowestBit(unsigned int mask) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<unsigned int>(index);
+#else
+        return static_cast<unsigned int>(__builtin_ctz(mask));
+#endif
+    }
+
+#endif
+
+    //
+    // Validation-only JSON scanner
+    //
+    // Iterative, nesting is kept on an explicit stack of expected closing
+    // characters so no input can exhaust the call stack.
+    //
+    class JSONScanner {
+    public:
+        JSONScanner(const char* data, size_t length)
+        : m_begin(data), m_cur(data), m_end(data + length), m_reason(NULL) {}
+
+        // Scan the data, returns false if not well-formed
+        bool scan() {
+            skipWhitespace();
+
+            for (;;) {
+
+                // Value
+                if (m_cur == m_end)
+                    return fail("unexpected end of data");
+
+                char c = *m_cur;
+                if (c == '{' || c == '[') {
+                    char closing = (c == '{') ? '}' : ']';
+                    ++m_cur;
+                    skipWhitespace();
+                    if (m_cur != m_end && *m_cur == closing) {
+                        ++m_cur;
+                    }
+                    else {
+                        m_containers.push_back(closing);
+                        if (closing == '}' && !scanKey())
+                            return false;
+                        continue;
+                    }
+                }
+                else if (c == '"') {
+                    if (!scanString())
+                        return false;
+                }
+                else if (c == '-' || (c >= '0' && c <= '9')) {
+                    if (!scanNumber())
+                        return false;
+                }
+                else if (!scanLiteral("true", 4) &&
+                         !scanLiteral("false", 5) &&
+                         !scanLiteral("null", 4)) {
+                    return fail("unexpected character");
+                }
+
+                // Closing containers & separator
+                for (;;) {
+                    skipWhitespace();
+                    if (m_containers.empty())
+                        return (m_cur == m_end) || fail("unexpected data after the value");
+
+                    if (m_cur == m_end)
+                        return fail("unexpected end of data");
+
+                    char closing = m_containers.back();
+                    if (*m_cur == closing) {
+                        ++m_cur;
+                        m_containers.pop_back();
+                        continue;
+                    }
+
+                    if (*m_cur != ',')
+                        return fail((closing == '}') ? "expected `,` or `}`" : "expected `,` or `]`");
+
+                    ++m_cur;
+                    skipWhitespace();
+                    if (closing == '}' && !scanKey())
+                        return false;
+                    break;
+                }
+            }
+        }
+
+        // Offset of the offending byte
+        size_t errorOffset() const {
+            return m_cur - m_begin;
+        }
+
+        // Reason the data is not well-formed
+        const char* errorReason() const {
+            return m_reason;
+        }
+
+    private:
+        const char* m_begin;
+        const char* m_cur;
+        const char* m_end;
+        const char* m_reason;
+        std::vector<char> m_containers;
+
+        // Set reason at the current position, always returns false
+        bool fail(const char* reason) {
+            m_reason = reason;
+            return false;
+        }
+
+        FORCEINLINE static bool IsWhitespace(char c) {
+            return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+        }
+
+        void skipWhitespace() {
+
+            // Single separating space or none, the common case
+            if (m_cur == m_end || !IsWhitespace(*m_cur))
+                return;
+            ++m_cur;
+
+#if defined(SNOWCRASH_JSON_SSE2)
+            const __m128i space = _mm_set1_epi8(' ');
+            const __m128i lineFeed = _mm_set1_epi8('\n');
+            const __m128i carriageReturn = _mm_set1_epi8('\r');
+            const __m128i tab = _mm_set1_epi8('\t');
+
+            while (m_end - m_cur >= 16) {
+                __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_cur));
+                __m128i whitespace = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, space),
+                                                               _mm_cmpeq_epi8(chunk, lineFeed)),
+                                                  _mm_or_si128(_mm_cmpeq_epi8(chunk, carriageReturn),
+                                                               _mm_cmpeq_epi8(chunk, tab)));
+                unsigned int other = ~static_cast<unsigned int>(_mm_movemask_epi8(whitespace)) & 0xFFFF;
+                if (other) {
+                    m_cur += LowestBit(other);
+                    return;
+                }
+
+                m_cur += 16;
+            }
+#endif
+            while (m_cur != m_end && IsWhitespace(*m_cur))
+                ++m_cur;
+        }
+
+        // Skip string content up to a quote, backslash or control character
+        void skipStringContent() {
+#if defined(SNOWCRASH_JSON_SSE2)
+            const __m128i quote = _mm_set1_epi8('"');
+            const __m128i backslash = _mm_set1_epi8('\\');
+            const __m128i control = _mm_set1_epi8(0x1F);
+
+            while (m_end - m_cur >= 16) {
+                __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_cur));
+                __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                                                            _mm_cmpeq_epi8(chunk, backslash)),
+                                               _mm_cmpeq_epi8(_mm_max_epu8(chunk, control), control));
+                unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(special));
+                if (mask) {
+                    m_cur += LowestBit(mask);
+                    return;
+                }
+
+                m_cur += 16;
+            }
+#endif
+            while (m_cur != m_end) {
+                unsigned char c = static_cast<unsigned char>(*m_cur);
+                if (c == '"' || c == '\\' || c < 0x20)
+                    return;
+                ++m_cur;
+            }
+        }
+
+        // Scan a string, at its opening quote
+        bool scanString() {
+            ++m_cur;
+            for (;;) {
+                skipStringContent();
+                if (m_cur == m_end)
+                    return fail("unterminated string");
+
+                char c = *m_cur;
+                if (c == '"') {
+                    ++m_cur;
+                    return true;
+                }
+
+                if (c != '\\')
+                    return fail("unescaped control character in string");
+
+                if (++m_cur == m_end)
+                    return fail("unterminated string");
+
+                c = *m_cur;
+                if (c == 'u') {
+                    ++m_cur;
+                    for (int i = 0; i < 4; ++i, ++m_cur) {
+                        if (m_cur == m_end)
+                            return fail("unterminated string");
+
+                        c = *m_cur;
+                        if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F')))
+                            return fail("invalid unicode escape");
+                    }
+                }
+                else if (c == '"' || c == '\\' || c == '/' ||
+                         c == 'b' || c == 'f' || c == 'n' || c == 'r' || c == 't') {
+                    ++m_cur;
+                }
+                else {
+                    return fail("invalid escape sequence");
+                }
+            }
+        }
+
+        // Scan an object key and the following colon
+        bool scanKey() {
+            if (m_cur == m_end || *m_cur != '"')
+                return fail("expected object key string");
+
+            if (!scanString())
+                return false;
+
+            skipWhitespace();
+            if (m_cur == m_end || *m_cur != ':')
+                return fail("expected `:`");
+
+            ++m_cur;
+            skipWhitespace();
+            return true;
+        }
+
+        // Skip digits, returns false if there is none
+        bool skipDigits() {
+            const char* start = m_cur;
+            while (m_cur != m_end && *m_cur >= '0' && *m_cur <= '9')
+                ++m_cur;
+
+            return m_cur != start;
+        }
+
+        bool scanNumber() {
+            if (*m_cur == '-')
+                ++m_cur;
+
+            if (m_cur != m_end && *m_cur == '0')
+                ++m_cur;
+            else if (!skipDigits())
+                return fail("invalid number");
+
+            if (m_cur != m_end && *m_cur == '.') {
+                ++m_cur;
+                if (!skipDigits())
+                    return fail("invalid number");
+            }
+
+            if (m_cur != m_end && (*m_cur == 'e' || *m_cur == 'E')) {
+                ++m_cur;
+                if (m_cur != m_end && (*m_cur == '+' || *m_cur == '-'))
+                    ++m_cur;
+
+                if (!skipDigits())
+                    return fail("invalid number");
+            }
+
+            return true;
+        }
+
+        // Consume the literal if it is next
+        bool scanLiteral(const char* literal, size_t length) {
+            if (static_cast<size_t>(m_end - m_cur) < length ||
+                ::memcmp(m_cur, literal, length) != 0)
+                return false;
+
+            m_cur += length;
+            return true;
+        }
+    };
+
+    //
+    // Task checking a single body
+    //
+    class CheckJSONBodyTask : public Task {
+    public:
+        CheckJSONBodyTask(const SourceData& source, const JSONBody& body)
+        : m_source(source), m_body(body), m_wellFormed(true), m_line(0), m_reason(NULL) {}
+
+        virtual void run() {
+
+            const SourceDataBlock& sourceMap = m_body.bodySource.sourceMap;
+            if (sourceMap.empty()) {
+                check(m_body.body.data(), m_body.body.length());
+            }
+            else if (sourceMap.size() == 1) {
+                // Checked in place, the indentation left in is insignificant whitespace
+                check(m_source.data() + sourceMap.front().location, sourceMap.front().length);
+            }
+            else {
+                Asset body = MapAsset(m_source, m_body.bodySource);
+                check(body.data(), body.length());
+            }
+        }
+
+        bool wellFormed() const { return m_wellFormed; }
+        size_t line() const { return m_line; }
+        const char* reason() const { return m_reason; }
+
+    private:
+        const SourceData& m_source;
+        const JSONBody& m_body;
+        bool m_wellFormed;
+        size_t m_line;
+        const char* m_reason;
+
+        void check(const char* data, size_t length) {
+            size_t offset;
+            m_wellFormed = CheckJSON(data, length, offset, m_reason);
+            if (!m_wellFormed)
+                m_line = std::count(data, data + offset, '\n') + 1;
+        }
+    };
+}
+
+bool snowcrash::CheckJSON(const char* data, size_t length, size_t& errorOffset, const char*& errorReason)
+{
+    JSONScanner scanner(data, length);
+    if (scanner.scan())
+        return true;
+
+    errorOffset = scanner.errorOffset();
+    errorReason = scanner.errorReason();
+    return false;
+}
+
+bool snowcrash::IsJSONMediaType(const std::string& mediaType)
+{
+    // Type & subtype only, case-insensitive
+    std::string type = mediaType.substr(0, mediaType.find(';'));
+    TrimString(type);
+    for (std::string::iterator it = type.begin(); it != type.end(); ++it)
+        *it = static_cast<char>(::tolower(static_cast<unsigned char>(*it)));
+
+    static const std::string JSONType = "application/json";
+    static const std::string JSONSuffix = "+json";
+
+    if (type == JSONType)
+        return true;
+
+    return type.length() > JSONSuffix.length() &&
+           type.find('/') != std::string::npos &&
+           type.compare(type.length() - JSONSuffix.length(), JSONSuffix.length(), JSONSuffix) == 0;
+}
+
+std::string snowcrash::PayloadMediaType(const Payload& payload)
+{
+    static const char ContentType[] = "content-type";
+
+    for (Collection<Header>::const_iterator it = payload.headers.begin(); it != payload.headers.end(); ++it) {
+        if (it->first.length() != sizeof(ContentType) - 1)
+            continue;
+
+        size_t i = 0;
+        while (i < it->first.length() &&
+               ::tolower(static_cast<unsigned char>(it->first[i])) == ContentType[i])
+            ++i;
+
+        if (i == it->first.length())
+            return it->second;
+    }
+
+    return std::string();
+}
+
+void snowcrash::CheckJSONBodies(const SourceData& source, const std::vector<JSONBody>& bodies, Result& result)
+{
+    if (bodies.empty())
+        return;
+
+    std::vector<Task*> tasks;
+    size_t size = 0;
+    for (std::vector<JSONBody>::const_iterator it = bodies.begin(); it != bodies.end(); ++it) {
+        tasks.push_back(new CheckJSONBodyTask(source, *it));
+        size += it->body.length();
+        for (SourceDataBlock::const_iterator range = it->bodySource.sourceMap.begin();
+             range != it->bodySource.sourceMap.end();
+             ++range)
+            size += range->length;
+    }
+
+    // Starting threads costs more than scanning a few small bodies
+    size_t threads = std::min(tasks.size(), ThreadPool::HardwareConcurrency());
+    if (size >= ParallelCheckSize && threads > 1) {
+        ThreadPool pool(threads);
+        pool.run(tasks);
+    }
+    else {
+        for (std::vector<Task*>::iterator it = tasks.begin(); it != tasks.end(); ++it)
+            (*it)->run();
+    }
+
+    // Warn in the order of the bodies
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        CheckJSONBodyTask* task = static_cast<CheckJSONBodyTask*>(tasks[i]);
+        if (!task->wellFormed()) {
+            result.warnings.push_back(Warning(MalformedJSONBodyWarning,
+                                              0,
+                                              bodies[i].sourceMap,
+                                              bodies[i].mediaType,
+                                              task->reason(),
+                                              std::string(),
+                                              task->line()));
+        }
+
+        delete task;
+    }
+}
@@ -0,0 +1,64 @@
+//
+//  JSONCheck.h
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#ifndef SNOWCRASH_JSONCHECK_H
+#define SNOWCRASH_JSONCHECK_H
+
+#include <algorithm>
+#include <vector>
+#include "Blueprint.h"
+#include "ParserCore.h"
+
+namespace snowcrash {
+    
+    // Check the data is a single well-formed JSON value surrounded by whitespace
+    // only. Nothing is built, strings & whitespace are scanned 16 bytes at a time
+    // where SSE2 is available. UTF-8 encoding is not checked.
+    // Returns true if well-formed, false otherwise and sets the offset of the
+    // offending byte & the reason.
+    bool CheckJSON(const char* data, size_t length, size_t& errorOffset, const char*& errorReason);
+    
+    // True if the media type is JSON, i.e. `application/json` or `+json` suffixed
+    bool IsJSONMediaType(const std::string& mediaType);
+    
+    // Media type of a payload, its Content-Type header value
+    std::string PayloadMediaType(const Payload& payload);
+    
+    //
+    // Payload body to be checked, see CheckJSONBodiesOption
+    //
+    struct JSONBody {
+        
+        // Body, empty if kept as its source
+        Asset body;
+        
+        // Body source while the body has code blocks only, see AssetSource.h
+        AssetSource bodySource;
+        
+        // Media type of the body
+        std::string mediaType;
+        
+        // Body location, reported
+        SourceDataBlock sourceMap;
+        
+        // Exchange with another body without copying
+        void swap(JSONBody& other) {
+            body.swap(other.body);
+            std::swap(bodySource.source, other.bodySource.source);
+            bodySource.sourceMap.swap(other.bodySource.sourceMap);
+            std::swap(bodySource.indentation, other.bodySource.indentation);
+            mediaType.swap(other.mediaType);
+            sourceMap.swap(other.sourceMap);
+        }
+    };
+    
+    // Check the bodies and add a warning for every body that is not well-formed.
+    // Bodies are checked in parallel when there is enough of them to pay off.
+    void CheckJSONBodies(const SourceData& source, const std::vector<JSONBody>& bodies, Result& result);
+}
+
+#endif
@@ -101,7 +101,7 @@ namespace snowcrash {
         if (cur->type == ListItemBlockBeginType) {
 
             result.second = SkipToSectionEnd(cur, bounds.second, ListItemBlockBeginType, ListItemBlockEndType);
-            result.first.warnings.push_back(Warning("ignoring unrecognized list item",
+            result.first.warnings.push_back(Warning(IgnoringListItemWarning,
                                                     0,
                                                     result.second->sourceMap));
             result.second = CloseListItemBlock(result.second, bounds.second);
@@ -109,7 +109,7 @@ namespace snowcrash {
         else if (cur->type == ListBlockBeginType) {
 
             result.second = SkipToSectionEnd(cur, bounds.second, ListBlockBeginType, ListBlockEndType);
-            result.first.warnings.push_back(Warning("ignoring unrecognized list",
+            result.first.warnings.push_back(Warning(IgnoringListWarning,
                                                     0,
                                                     result.second->sourceMap));
             result.second = CloseListItemBlock(result.second, bounds.second);
@@ -121,7 +121,7 @@ namespace snowcrash {
             else {
                 ++result.second;
             }
-            result.first.warnings.push_back(Warning("ignoring unrecognized block, check indentation",
+            result.first.warnings.push_back(Warning(IgnoringBlockWarning,
                                                     0,
                                                     result.second->sourceMap));
         }
@@ -182,19 +182,20 @@ namespace snowcrash {
     
     
     
-    // Parse preformatted source data from block(s) of a list item block
+    // Parse preformatted source data from block(s) of a list item block.
+    // The data is appended to `data` unless it is NULL, `hasData` is set
+    // if there is any data.
     FORCEINLINE ParseSectionResult ParseListPreformattedBlock(const Section& section,
                                                               const BlockIterator& cur,
                                                               const SectionBounds& bounds,
                                                               BlueprintParserCore& parser,
-                                                              SourceData& data,
+                                                              SourceData* data,
+                                                              bool& hasData,
                                                               SourceDataBlock& sourceMap) {
         
-        static const std::string FormattingWarning = "content is expected to be preformatted code block";
-        
         ParseSectionResult result = std::make_pair(Result(), cur);
         BlockIterator sectionCur = cur;
-        std::stringstream dataStream;
+        hasData = false;
         
         if (sectionCur == bounds.first) {
             // Process first block of list, throw away first line - signature
@@ -203,22 +204,26 @@ namespace snowcrash {
             
             // Retrieve any extra lines after signature
             if (!content.empty()) {
-                dataStream << content;
+                hasData = true;
+                if (data)
+                    *data += content;
                 
                 // WARN: not a preformatted code block
                 BlockIterator nameBlock = ListItemNameBlock(sectionCur, bounds.second);
-                std::stringstream ss;
-                ss << SectionName(section) << " " << FormattingWarning;
-                result.first.warnings.push_back(Warning(ss.str(),
+                result.first.warnings.push_back(Warning(ContentFormattingWarning,
                                                         0,
-                                                        nameBlock->sourceMap));
+                                                        nameBlock->sourceMap,
+                                                        SectionName(section)));
             }
             
             sectionCur = FirstContentBlock(cur, bounds.second);
         }
         else if (sectionCur->type == CodeBlockType) {
 
-            dataStream << sectionCur->content; // well formatted content, stream it up
+            // well formatted content, stream it up
+            hasData = !sectionCur->content.empty();
+            if (data)
+                *data += sectionCur->content;
         }
         else {
             // Other blocks, process them but warn
@@ -231,17 +236,18 @@ namespace snowcrash {
             
             if (!CheckCursor(sectionCur, bounds, cur, result.first))
                 return result;
-            dataStream << MapSourceData(parser.sourceData, sectionCur->sourceMap);
+            
+            hasData = HasSourceData(parser.sourceData, sectionCur->sourceMap);
+            if (data)
+                *data += MapSourceData(parser.sourceData, sectionCur->sourceMap);
             
             // WARN: not a preformatted code block
-            std::stringstream ss;
-            ss << SectionName(section) << " " << FormattingWarning;
-            result.first.warnings.push_back(Warning(ss.str(),
+            result.first.warnings.push_back(Warning(ContentFormattingWarning,
                                                     0,
-                                                    sectionCur->sourceMap));
+                                                    sectionCur->sourceMap,
+                                                    SectionName(section)));
         }
         
-        data = dataStream.str();
         sourceMap = sectionCur->sourceMap;
         
         if (sectionCur != bounds.second)
@@ -250,6 +256,18 @@ namespace snowcrash {
         return result;
     }
     
+    // Parse preformatted source data from block(s) of a list item block
+    FORCEINLINE ParseSectionResult ParseListPreformattedBlock(const Section& section,
+                                                              const BlockIterator& cur,
+                                                              const SectionBounds& bounds,
+                                                              BlueprintParserCore& parser,
+                                                              SourceData& data,
+                                                              SourceDataBlock& sourceMap) {
+        data.clear();
+        bool hasData;
+        return ParseListPreformattedBlock(section, cur, bounds, parser, &data, hasData, sourceMap);
+    }
+    
     // Returns true if list item (begin) contains nested list block false otherwise
     // Look ahead. 
     FORCEINLINE bool HasNestedListBlock(const BlockIterator& begin,
@@ -266,13 +284,15 @@ namespace snowcrash {
         if (sectionBegin->type != ListItemBlockBeginType)
             return false;
         
-        BlockIterator sectionEnd = SkipToSectionEnd(sectionBegin,
-                                                    end,
-                                                    ListItemBlockBeginType,
-                                                    ListItemBlockEndType);
-        for (BlockIterator it = sectionBegin; it != sectionEnd; ++it) {
+        // Any nested list item is preceded by its list begin, therefore
+        // the first list item end without a list begin closes this item.
+        // Stop at whichever comes first, not to scan the whole item.
+        for (BlockIterator it = ++sectionBegin; it != end; ++it) {
             if (it->type == ListBlockBeginType)
                 return true;
+            
+            if (it->type == ListItemBlockEndType)
+                return false;
         }
         
         return false;
@@ -0,0 +1,50 @@
+//
+//  MappedFile.h
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#ifndef SNOWCRASH_MAPPEDFILE_H
+#define SNOWCRASH_MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+
+namespace snowcrash {
+
+    //
+    // Read-only memory mapped file
+    //
+    class MappedFile {
+    public:
+        MappedFile();
+        ~MappedFile();
+
+        // Map the whole file into memory
+        // returns true on success, false otherwise
+        bool open(const std::string& path);
+
+        // Unmap the file
+        void close();
+
+        // Mapped data or NULL when not mapped
+        const char* data() const { return m_data; }
+
+        // Size of the mapped data
+        size_t size() const { return m_size; }
+
+    private:
+        const char* m_data;
+        size_t m_size;
+
+        // Platform specific handles
+        void* m_file;
+        void* m_mapping;
+
+        MappedFile(const MappedFile&);
+        MappedFile& operator=(const MappedFile&);
+    };
+}
+
+#endif
@@ -33,6 +33,24 @@ std::string snowcrash::MapSourceData(const SourceData& source, const SourceDataB
     return ss.str();
 }
 
+bool snowcrash::HasSourceData(const SourceData& source, const SourceDataBlock& sourceMap)
+{
+    if (source.empty())
+        return false;
+    
+    size_t length = source.length();
+    bool hasData = false;
+    for (SourceDataBlock::const_iterator it = sourceMap.begin(); it != sourceMap.end(); ++it) {
+        
+        if (it->location + it->length > length)
+            return false;   // wrong map
+        
+        hasData = hasData || it->length;
+    }
+    
+    return hasData;
+}
+
 #ifdef DEBUG
 
 #include "Serialize.h"
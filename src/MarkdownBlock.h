@@ -74,6 +74,9 @@ namespace snowcrash {
 
     // Return source data using from source and source map
     std::string MapSourceData(const SourceData& source, const SourceDataBlock& sourceMap);
+    
+    // Returns true if the source data of the source map is not empty, without mapping it
+    bool HasSourceData(const SourceData& source, const SourceDataBlock& sourceMap);
         
 #ifdef DEBUG
     // Prints markdown block recursively to stdout
@@ -23,12 +23,28 @@ static std::string BufText(const struct buf *text)
 const size_t MarkdownParser::OutputUnitSize = 64;
 const size_t MarkdownParser::MaxNesting = 16;
 const int MarkdownParser::ParserExtensions = MKDEXT_FENCED_CODE | MKDEXT_NO_INTRA_EMPHASIS /*| MKDEXT_TABLES */;
+const size_t MarkdownParser::DeadlineCheckInterval = 64;
 
-void MarkdownParser::parse(const SourceData& source, Result& result, MarkdownBlock::Stack& markdown)
+MarkdownParser::MarkdownParser()
+: m_budget(NULL), m_blocks(0), m_nesting(0), m_outputBytes(0)
+{
+}
+
+void MarkdownParser::parse(const SourceData& source,
+                           Result& result,
+                           MarkdownBlock::Stack& markdown,
+                           const ParserBudget* budget)
 {
     // Push default render stack
     m_renderStack.clear();
     
+    // Reset budget use
+    m_budget = budget;
+    m_blocks = 0;
+    m_nesting = 0;
+    m_outputBytes = 0;
+    m_budgetError = Error();
+    
     // Build render callbacks & setup parser
     RenderCallbacks callbacks = renderCallbacks();
 	sd_markdown *sundown = sd_markdown_new(ParserExtensions, MaxNesting, &callbacks, renderCallbackData());
@@ -40,6 +56,9 @@ void MarkdownParser::parse(const SourceData& source, Result& result, MarkdownBlo
 
     bufrelease(output);
     sd_markdown_free(sundown);
+    
+    if (m_budgetError.code != Error::OK)
+        result.error = m_budgetError;
 
     // Compose final Markdown object
     markdown = m_renderStack; // FIXME: C++11 move
@@ -50,6 +69,35 @@ void MarkdownParser::parse(const SourceData& source, Result& result, MarkdownBlo
 
 }
 
+bool MarkdownParser::spendBudget(const struct buf *text, int nesting)
+{
+    if (!m_budget)
+        return true;
+    
+    if (m_budgetError.code != Error::OK)
+        return false;
+    
+    ++m_blocks;
+    if (text)
+        m_outputBytes += text->size;
+    
+    if (nesting > 0)
+        ++m_nesting;
+    else if (nesting < 0 && m_nesting)
+        --m_nesting;
+    
+    if (m_budget->maxBlocks && m_blocks > m_budget->maxBlocks)
+        m_budgetError = BudgetExceededError("blocks");
+    else if (m_budget->maxNesting && m_nesting > m_budget->maxNesting)
+        m_budgetError = BudgetExceededError("nesting");
+    else if (m_budget->maxOutputBytes && m_outputBytes > m_budget->maxOutputBytes)
+        m_budgetError = BudgetExceededError("output bytes");
+    else if (!(m_blocks % DeadlineCheckInterval) && IsPastDeadline(*m_budget))
+        m_budgetError = BudgetExceededError("deadline");
+    
+    return m_budgetError.code == Error::OK;
+}
+
 MarkdownParser::RenderCallbacks MarkdownParser::renderCallbacks()
 {
     // Custom callbacks
@@ -92,6 +140,9 @@ void MarkdownParser::renderHeader(struct buf *ob, const struct buf *text, int le
         return;
     
     MarkdownParser *p = static_cast<MarkdownParser *>(opaque);
+    if (!p->spendBudget(text, 0))
+        return;
+    
     p->renderHeader(BufText(text), level);
 }
 
@@ -106,6 +157,9 @@ void MarkdownParser::beginList(int flags, void *opaque)
         return;
     
     MarkdownParser *p = static_cast<MarkdownParser *>(opaque);
+    if (!p->spendBudget(NULL, 1))
+        return;
+    
     p->beginList(flags);
 }
 
@@ -120,6 +174,9 @@ void MarkdownParser::renderList(struct buf *ob, const struct buf *text, int flag
         return;
     
     MarkdownParser *p = static_cast<MarkdownParser *>(opaque);
+    if (!p->spendBudget(text, -1))
+        return;
+    
     p->renderList(BufText(text), flags);
 }
 
@@ -134,6 +191,9 @@ void MarkdownParser::beginListItem(int flags, void *opaque)
         return;
     
     MarkdownParser *p = static_cast<MarkdownParser *>(opaque);
+    if (!p->spendBudget(NULL, 1))
+        return;
+    
     p->beginListItem(flags);
 }
 
@@ -148,6 +208,9 @@ void MarkdownParser::renderListItem(struct buf *ob, const struct buf *text, int
         return;
     
     MarkdownParser *p = static_cast<MarkdownParser *>(opaque);
+    if (!p->spendBudget(text, -1))
+        return;
+    
     p->renderListItem(BufText(text), flags);
 }
 
@@ -162,6 +225,9 @@ void MarkdownParser::renderBlockCode(struct buf *ob, const struct buf *text, con
         return;
     
     MarkdownParser *p = static_cast<MarkdownParser *>(opaque);
+    if (!p->spendBudget(text, 0))
+        return;
+    
     p->renderBlockCode(BufText(text), BufText(lang));
 }
 
@@ -176,6 +242,9 @@ void MarkdownParser::renderParagraph(struct buf *ob, const struct buf *text, voi
         return;
     
     MarkdownParser *p = static_cast<MarkdownParser *>(opaque);
+    if (!p->spendBudget(text, 0))
+        return;
+    
     p->renderParagraph(BufText(text));
 }
 
@@ -190,6 +259,9 @@ void MarkdownParser::renderHorizontalRule(struct buf *ob, void *opaque)
         return;
     
     MarkdownParser *p = static_cast<MarkdownParser *>(opaque);
+    if (!p->spendBudget(NULL, 0))
+        return;
+    
     p->renderHorizontalRule();
 }
 
@@ -204,6 +276,9 @@ void MarkdownParser::renderHTML(struct buf *ob, const struct buf *text, void *op
         return;
     
     MarkdownParser *p = static_cast<MarkdownParser *>(opaque);
+    if (!p->spendBudget(text, 0))
+        return;
+    
     p->renderHTML(BufText(text));
 }
 
@@ -218,6 +293,9 @@ void MarkdownParser::beginQuote(void *opaque)
         return;
     
     MarkdownParser *p = static_cast<MarkdownParser *>(opaque);
+    if (!p->spendBudget(NULL, 1))
+        return;
+    
     p->beginQuote();
 }
 
@@ -232,6 +310,9 @@ void MarkdownParser::renderQuote(struct buf *ob, const struct buf *text, void *o
         return;
     
     MarkdownParser *p = static_cast<MarkdownParser *>(opaque);
+    if (!p->spendBudget(text, -1))
+        return;
+    
     p->renderQuote(BufText(text));
 }
 
@@ -257,7 +338,7 @@ void MarkdownParser::blockDidParse(const src_map* map, const uint8_t *txt_data,
 
 void MarkdownParser::blockDidParse(const SourceDataBlock& sourceMap)
 {
-    if (m_renderStack.empty()) {
+    if (m_renderStack.empty() || m_budgetError.code != Error::OK) {
         return;
     }
     
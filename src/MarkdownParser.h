@@ -11,6 +11,7 @@
 
 #include "ParserCore.h"
 #include "MarkdownBlock.h"
+#include "ParserBudget.h"
 #include "markdown.h"
 
 namespace snowcrash {
@@ -24,9 +25,16 @@ namespace snowcrash {
         static const size_t OutputUnitSize; // = 64;
         static const size_t MaxNesting;// = 16;
         static const int ParserExtensions;// = MKDEXT_FENCED_CODE | MKDEXT_NO_INTRA_EMPHASIS /*| MKDEXT_TABLES */;
+        static const size_t DeadlineCheckInterval; // = 64; blocks
         
-        // Parse source Markdown into Markdown AST
-        void parse(const SourceData& source, Result& result, MarkdownBlock::Stack& markdown);
+        MarkdownParser();
+        
+        // Parse source Markdown into Markdown AST.
+        // If budget is set, rendering stops once it is exceeded.
+        void parse(const SourceData& source,
+                   Result& result,
+                   MarkdownBlock::Stack& markdown,
+                   const ParserBudget* budget = NULL);
     
     private:
         typedef sd_callbacks RenderCallbacks;
@@ -37,6 +45,17 @@ namespace snowcrash {
         
         MarkdownBlock::Stack m_renderStack;
         
+        // Budget & its use so far
+        const ParserBudget* m_budget;
+        size_t m_blocks;
+        size_t m_nesting;
+        size_t m_outputBytes;
+        Error m_budgetError;
+        
+        // Account a block of text opening (+1), closing (-1) or keeping
+        // (0) the nesting level, returns false if it is not to be rendered
+        bool spendBudget(const struct buf *text, int nesting);
+        
         // Header
         static void renderHeader(struct buf *ob, const struct buf *text, int level, void *opaque);
         void renderHeader(const std::string& text, int level);
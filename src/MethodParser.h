@@ -195,7 +195,9 @@ namespace snowcrash {
                 
                 if (!CheckCursor(sectionCur, bounds, cur, result.first))
                     return result;
-                method.description += MapSourceData(parser.sourceData, sectionCur->sourceMap);
+                
+                if (!(parser.options & SkipDescriptionsOption))
+                    method.description += MapSourceData(parser.sourceData, sectionCur->sourceMap);
             }
             
             result.second = ++sectionCur;
@@ -213,40 +215,49 @@ namespace snowcrash {
             if (result.first.error.code != Error::OK)
                 return result;
             
-            if (IsPayloadDuplicate(section, payload, method)) {
+            if (IsPayloadDuplicate(section, payload, parser)) {
                 // WARN: duplicate payload
-                std::stringstream ss;
-                ss << SectionName(section) << " payload `" << payload.name << "`";
-                ss << " already defined for `" << method.method << "` method";
                 BlockIterator nameBlock = ListItemNameBlock(begin, end);
-                result.first.warnings.push_back(Warning(ss.str(),
+                result.first.warnings.push_back(Warning(DuplicatePayloadWarning,
                                                         0,
-                                                        nameBlock->sourceMap));
+                                                        nameBlock->sourceMap,
+                                                        SectionName(section),
+                                                        payload.name,
+                                                        method.method));
                 
             }
             
-            if (section == RequestSection)
-                method.requests.push_back(payload);
-            else if (section == ResponseSection)
-                method.responses.push_back(payload);
+            QueueJSONBody(parser, payload);
+            ProjectPayload(parser.options, payload);
             
             BlockIterator nameBlock = ListItemNameBlock(begin, end);
             CheckHeaderDuplicates(method, payload, nameBlock->sourceMap, result.first);
             
+            Collection<Payload>::type& payloads = (section == RequestSection) ? method.requests : method.responses;
+            if (parser.options & ValidateOnlyOption) {
+                // Keep only the header keys the resource checks need
+                payloads.push_back(Payload());
+                payloads.back().headers.swap(payload.headers);
+            }
+            else {
+                payloads.push_back(payload);
+            }
+            
             return result;
         }
         
-        // Checks whether given section payload has duplicate.
+        // Checks whether given section payload has duplicate in the method
+        // being parsed, adds the payload to the method index otherwise.
         // Returns true when a duplicate is found, false otherwise.
-        static bool IsPayloadDuplicate(const Section& section, const Payload& payload, Method& method) {
+        static bool IsPayloadDuplicate(const Section& section, const Payload& payload, BlueprintParserCore& parser) {
             
             if (section == RequestSection) {
-                Collection<Request>::const_iterator duplicate = FindRequest(method, payload);
-                return duplicate != method.requests.end();
+                CountLookup();
+                return !parser.requestIndex.insert(payload.name).second;
             }
             else if (section == ResponseSection) {
-                Collection<Response>::const_iterator duplicate = FindResponse(method, payload);
-                return duplicate != method.responses.end();
+                CountLookup();
+                return !parser.responseIndex.insert(payload.name).second;
             }
 
             return false;
@@ -0,0 +1,109 @@
+//
+//  OutputBuffer.h
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#ifndef SNOWCRASH_OUTPUTBUFFER_H
+#define SNOWCRASH_OUTPUTBUFFER_H
+
+#include <cstring>
+#include <string>
+#include <ostream>
+#include "Platform.h"
+
+namespace snowcrash {
+
+    //
+    // Serializer output buffer
+    //
+    // Output is collected in a fixed buffer and written into the stream
+    // in large chunks rather than by many small stream inserts.
+    //
+    class OutputBuffer {
+    public:
+        // Buffer size
+        static const size_t Capacity = 16 * 1024;
+
+        // Longest indentation served from the indentation table
+        static const size_t MaxIndentation = 64;
+
+        explicit OutputBuffer(std::ostream& os)
+        : m_os(os), m_length(0), m_written(0) {}
+
+        ~OutputBuffer() {
+            flush();
+        }
+
+        FORCEINLINE void append(const char* data, size_t length) {
+            if (length > Capacity - m_length) {
+                flush();
+                if (length >= Capacity) {
+                    m_os.write(data, length);
+                    m_written += length;
+                    return;
+                }
+            }
+
+            ::memcpy(m_buffer + m_length, data, length);
+            m_length += length;
+        }
+
+        FORCEINLINE void append(const std::string& str) {
+            append(str.data(), str.length());
+        }
+
+        FORCEINLINE void append(char c) {
+            if (m_length == Capacity)
+                flush();
+
+            m_buffer[m_length++] = c;
+        }
+
+        // Append a string literal
+        template <size_t N>
+        FORCEINLINE void append(const char (&literal)[N]) {
+            append(literal, N - 1);
+        }
+
+        // Append count spaces
+        FORCEINLINE void indent(size_t count) {
+            static const char Spaces[MaxIndentation + 1] =
+                "                                                                ";
+
+            while (count > MaxIndentation) {
+                append(Spaces, MaxIndentation);
+                count -= MaxIndentation;
+            }
+
+            append(Spaces, count);
+        }
+
+        // Write buffered output into the stream
+        void flush() {
+            if (!m_length)
+                return;
+
+            m_os.write(m_buffer, m_length);
+            m_written += m_length;
+            m_length = 0;
+        }
+
+        // Number of bytes appended so far
+        size_t size() const {
+            return m_written + m_length;
+        }
+
+    private:
+        std::ostream& m_os;
+        char m_buffer[Capacity];
+        size_t m_length;
+        size_t m_written;
+
+        OutputBuffer(const OutputBuffer&);
+        OutputBuffer& operator=(const OutputBuffer&);
+    };
+}
+
+#endif
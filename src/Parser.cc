@@ -11,6 +11,7 @@
 #include "Parser.h"
 #include "MarkdownParser.h"
 #include "BlueprintParser.h"
+#include "RegexMatch.h"
 
 using namespace snowcrash;
 
@@ -39,24 +40,53 @@ static bool CheckSource(const SourceData& source, Result& result)
     return true;
 }
 
-void Parser::parse(const SourceData& source, BlueprintParserOptions options, Result& result, Blueprint& blueprint)
+void Parser::parse(const SourceData& source,
+                   BlueprintParserOptions options,
+                   Result& result,
+                   Blueprint& blueprint,
+                   BlueprintParserDelegate* delegate,
+                   ParserStatistics* statistics,
+                   Trace* trace,
+                   const ParserBudget* budget)
 {
+    TraceSpan parseSpan(trace, "parse", "phase");
+    
+    if (statistics)
+        statistics->bytes += source.length();
+    
+    RegexEvaluationScope regexEvaluations(statistics ? &statistics->regexEvaluations : NULL);
+    
     try {
         
         // Sanity Check
-        if (!CheckSource(source, result))
-            return;
+        {
+            ParserPhaseScope phase(statistics, CheckSourcePhase);
+            TraceSpan span(trace, PhaseIdentifier(CheckSourcePhase), "phase");
+            if (!CheckSource(source, result))
+                return;
+        }
         
         // Parse Markdown
         MarkdownBlock::Stack markdown;
-        MarkdownParser markdownParser;
-        markdownParser.parse(source, result, markdown);
+        {
+            ParserPhaseScope phase(statistics, MarkdownPhase);
+            TraceSpan span(trace, PhaseIdentifier(MarkdownPhase), "phase");
+            MarkdownParser markdownParser;
+            markdownParser.parse(source, result, markdown, budget);
+        }
         
-        if (result.error.code != Error::OK)
-            return;
+        if (statistics) {
+            for (MarkdownBlock::Stack::const_iterator it = markdown.begin(); it != markdown.end(); ++it)
+                ++statistics->blocks[it->type];
+        }
         
-        // Parse Blueprint
-        BlueprintParser::Parse(source, markdown, options, result, blueprint);
+        if (result.error.code == Error::OK) {
+            
+            // Parse Blueprint
+            ParserPhaseScope phase(statistics, BlueprintPhase);
+            TraceSpan span(trace, PhaseIdentifier(BlueprintPhase), "phase");
+            BlueprintParser::Parse(source, markdown, options, result, blueprint, delegate, statistics, trace, budget);
+        }
     }
     catch (const std::exception& e) {
 
@@ -68,4 +98,7 @@ void Parser::parse(const SourceData& source, BlueprintParserOptions options, Res
         
         result.error = Error("parser exception has occured", 1);
     }
+    
+    if (statistics)
+        statistics->warnings += result.warnings.size();
 }
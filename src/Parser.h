@@ -12,6 +12,8 @@
 #include <functional>
 #include "Blueprint.h"
 #include "BlueprintParserCore.h"
+#include "ParserStatistics.h"
+#include "Trace.h"
 
 namespace snowcrash {
     
@@ -21,8 +23,19 @@ namespace snowcrash {
     class Parser {
     public:
         
-        // Parse source data into Blueprint AST
-        void parse(const SourceData& source, BlueprintParserOptions options, Result& result, Blueprint& blueprint);
+        // Parse source data into Blueprint AST.
+        // If delegate is set, resource groups are handed to it as they are parsed.
+        // If statistics are set, they are filled, see ParserStatistics.
+        // If trace is set, spans of phases & sections are recorded into it.
+        // If budget is set, parsing is aborted once it is exceeded, see ParserBudget.
+        void parse(const SourceData& source,
+                   BlueprintParserOptions options,
+                   Result& result,
+                   Blueprint& blueprint,
+                   BlueprintParserDelegate* delegate = NULL,
+                   ParserStatistics* statistics = NULL,
+                   Trace* trace = NULL,
+                   const ParserBudget* budget = NULL);
     };
 }
 
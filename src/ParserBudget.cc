@@ -0,0 +1,37 @@
+//
+//  ParserBudget.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include "ParserBudget.h"
+
+using namespace snowcrash;
+
+const int ParserBudget::ErrorCode = 4;
+
+ParserBudget::ParserBudget()
+: deadline(0), maxBlocks(0), maxNesting(0), maxWarnings(0), maxOutputBytes(0)
+{
+}
+
+Error snowcrash::BudgetExceededError(const char* limit, const SourceDataBlock& location)
+{
+    return Error(std::string("parser budget exceeded: ") + limit, ParserBudget::ErrorCode, location);
+}
+
+bool snowcrash::CheckBudget(const ParserBudget& budget, size_t warnings, Result& result, const SourceDataBlock& location)
+{
+    if (budget.maxWarnings && warnings > budget.maxWarnings) {
+        result.error = BudgetExceededError("warnings", location);
+        return false;
+    }
+    
+    if (IsPastDeadline(budget)) {
+        result.error = BudgetExceededError("deadline", location);
+        return false;
+    }
+    
+    return true;
+}
@@ -0,0 +1,64 @@
+//
+//  ParserBudget.h
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#ifndef SNOWCRASH_PARSERBUDGET_H
+#define SNOWCRASH_PARSERBUDGET_H
+
+#include "ParserCore.h"
+#include "Timer.h"
+
+namespace snowcrash {
+    
+    //
+    // Parser Budget
+    //
+    // Limits of the work done on a single source. The parser aborts
+    // with the `ErrorCode` error naming the limit once one is exceeded.
+    // Zero stands for no limit.
+    //
+    // Sundown cannot be interrupted: after the budget is exceeded during
+    // the markdown phase the rest of the source is only scanned, nothing
+    // more is rendered.
+    //
+    struct ParserBudget {
+        ParserBudget();
+        
+        // Error code of an exceeded budget
+        static const int ErrorCode; // = 4
+        
+        // Point in time to finish by, as returned by Now()
+        double deadline;
+        
+        // Markdown blocks rendered
+        size_t maxBlocks;
+        
+        // Nesting of markdown lists, list items & quotes, effective
+        // when lower than MarkdownParser::MaxNesting
+        size_t maxNesting;
+        
+        // Warnings reported in the whole source
+        size_t maxWarnings;
+        
+        // Bytes of text rendered into markdown blocks
+        size_t maxOutputBytes;
+    };
+    
+    // True if the budget deadline has passed
+    FORCEINLINE bool IsPastDeadline(const ParserBudget& budget) {
+        return budget.deadline > 0 && Now() > budget.deadline;
+    }
+    
+    // Error of an exceeded budget limit, e.g. "warnings"
+    Error BudgetExceededError(const char* limit, const SourceDataBlock& location = SourceDataBlock());
+    
+    // Check the deadline & the number of warnings reported in the whole
+    // source, sets the error of the result at location and returns false
+    // if exceeded
+    bool CheckBudget(const ParserBudget& budget, size_t warnings, Result& result, const SourceDataBlock& location);
+}
+
+#endif
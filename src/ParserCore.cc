@@ -6,6 +6,7 @@
 //  Copyright (c) 2013 Apiary Inc. All rights reserved.
 //
 
+#include <sstream>
 #include "ParserCore.h"
 
 using namespace snowcrash;
@@ -73,3 +74,102 @@ SourceDataBlockPair snowcrash::SplitSourceDataBlock(const SourceDataBlock& block
     
     return std::make_pair(first, second);
 }
+
+std::string snowcrash::WarningMessage(WarningKind kind,
+                                     const std::string& argument0,
+                                     const std::string& argument1,
+                                     const std::string& argument2,
+                                     size_t number)
+{
+    const std::string args[] = { argument0, argument1, argument2 };
+    switch (kind) {
+            
+        case ExpectedAPINameWarning:
+            return "expected API name, e.g. `# <API Name>`";
+            
+        case DuplicateResourceGroupWarning:
+            if (args[0].empty())
+                return "anonymous group is already defined";
+            return "group `" + args[0] + "` is already defined";
+            
+        case DuplicateMetadataWarning:
+            return "duplicate definition of `" + args[0] + "`";
+            
+        case MetadataFormattingWarning:
+            return "ignoring possible metadata, expected `<key> : <value>`, one one per line";
+            
+        case DuplicateHeaderWarning:
+            return "duplicate definition of `" + args[0] + "` header";
+            
+        case HeaderFormattingWarning:
+            return "unable to parse HTTP header, expected `<header name> : <header value>`, one header per line";
+            
+        case NoHeadersWarning:
+            return "no headers specified";
+            
+        case OvershadowingHeaderWarning:
+            return "overshadowing `" + args[0] + "` header definition";
+            
+        case IgnoringListItemWarning:
+            return "ignoring unrecognized list item";
+            
+        case IgnoringListWarning:
+            return "ignoring unrecognized list";
+            
+        case IgnoringBlockWarning:
+            return "ignoring unrecognized block, check indentation";
+            
+        case ContentFormattingWarning:
+            return args[0] + " content is expected to be preformatted code block";
+            
+        case DuplicatePayloadWarning:
+            return args[0] + " payload `" + args[1] + "` already defined for `" + args[2] + "` method";
+            
+        case EmptyAssetWarning:
+            return "empty " + args[0] + " asset";
+            
+        case DuplicateAssetWarning:
+            return "ignoring " + args[0] + " asset, asset already defined";
+            
+        case SymbolReferenceContentWarning:
+            return "ignoring extraneous content after symbol reference, expected symbol reference only e.g. `[" + args[0] + "][]`";
+            
+        case MissingStatusCodeWarning:
+            return "missing response HTTP status code, assuming `Response 200`";
+            
+        case ExpectedResourceGroupNameWarning:
+            return "expected resource group name, e.g. `# <Group Name>`";
+            
+        case DuplicateResourceWarning:
+            return "resource `" + args[0] + "` is already defined";
+            
+        case DuplicateObjectWarning:
+            return "ignoring additional object definiton for `" +
+                   (args[0].empty() ? args[1] : args[0] + "(" + args[1] + ")") +
+                   "` resource, a resource can be represented single (1) object only";
+            
+        case MethodHeaderContentWarning:
+            return "ignoring extraneous content in method header `" + args[0] + "`, expected method-only e.g. `# " + args[1] + "`";
+            
+        case DuplicateMethodWarning:
+            return "method `" + args[0] + "` already defined for resource `" + args[1] + "`";
+            
+        case NoResponseWarning:
+            return "no response defined for `" + args[0] + " " + args[1] + "`";
+            
+        case AmbiguousMethodWarning:
+            return "ambiguous method `" + args[0] + "`, check previous resource definition";
+            
+        case MalformedURITemplateWarning:
+            return "malformed URI template `" + args[0] + "`, expected RFC 6570 expressions e.g. `{id}`";
+            
+        case MalformedJSONBodyWarning: {
+            std::stringstream ss;
+            ss << "`" << args[0] << "` body is not valid JSON, " << args[1] << " on line " << number << " of the body";
+            return ss.str();
+        }
+            
+        default:
+            return std::string();
+    }
+}
@@ -43,6 +43,51 @@ namespace snowcrash {
     typedef std::pair<SourceDataBlock, SourceDataBlock> SourceDataBlockPair;
     SourceDataBlockPair SplitSourceDataBlock(const SourceDataBlock& block, size_t len);
     
+    //
+    // Warning Kind
+    //
+    // Identifies the cause of a warning, stable across versions. Messages
+    // of warnings with a kind are rendered from the kind & arguments (listed
+    // below), see WarningMessage().
+    //
+    enum WarningKind {
+        UnspecifiedWarning = 0,             // Message only
+        ExpectedAPINameWarning,
+        DuplicateResourceGroupWarning,      // group name, empty if anonymous
+        DuplicateMetadataWarning,           // metadata key
+        MetadataFormattingWarning,
+        DuplicateHeaderWarning,             // header name
+        HeaderFormattingWarning,
+        NoHeadersWarning,
+        OvershadowingHeaderWarning,         // header name
+        IgnoringListItemWarning,
+        IgnoringListWarning,
+        IgnoringBlockWarning,
+        ContentFormattingWarning,           // section name
+        DuplicatePayloadWarning,            // section name, payload name, HTTP method
+        EmptyAssetWarning,                  // section name
+        DuplicateAssetWarning,              // section name
+        SymbolReferenceContentWarning,      // symbol name
+        MissingStatusCodeWarning,
+        ExpectedResourceGroupNameWarning,
+        DuplicateResourceWarning,           // URI template
+        DuplicateObjectWarning,             // resource name, URI template
+        MethodHeaderContentWarning,         // header content, HTTP method
+        DuplicateMethodWarning,             // HTTP method, URI template
+        NoResponseWarning,                  // HTTP method, URI template
+        AmbiguousMethodWarning,             // header content
+        MalformedURITemplateWarning,        // URI template
+        MalformedJSONBodyWarning,           // media type, reason; body line number
+        WarningKindCount
+    };
+    
+    // Message of a warning of a kind, rendered from its arguments
+    std::string WarningMessage(WarningKind kind,
+                               const std::string& argument0 = std::string(),
+                               const std::string& argument1 = std::string(),
+                               const std::string& argument2 = std::string(),
+                               size_t number = 0);
+    
     //
     // Source module line anotation
     //
@@ -50,13 +95,14 @@ namespace snowcrash {
         
         static const int OK;
         
-        SourceAnnotation() : code(OK) {}
+        SourceAnnotation() : code(OK), kind(UnspecifiedWarning) {}
         
         SourceAnnotation(const SourceAnnotation& rhs) {
 
             this->message = rhs.message;
             this->code = rhs.code;
             this->location = rhs.location;
+            this->kind = rhs.kind;
         }
         
         SourceAnnotation(const std::string& message,
@@ -66,6 +112,22 @@ namespace snowcrash {
             this->message = message;
             this->code = code; 
             this->location = location;
+            this->kind = UnspecifiedWarning;
+        }
+        
+        // Warning of a kind, its message rendered from the arguments
+        SourceAnnotation(WarningKind kind,
+                         int code,
+                         const SourceDataBlock& location,
+                         const std::string& argument0 = std::string(),
+                         const std::string& argument1 = std::string(),
+                         const std::string& argument2 = std::string(),
+                         size_t number = 0) {
+            
+            this->message = WarningMessage(kind, argument0, argument1, argument2, number);
+            this->code = code;
+            this->location = location;
+            this->kind = kind;
         }
         
         ~SourceAnnotation() {}
@@ -74,6 +136,7 @@ namespace snowcrash {
             this->message = rhs.message;
             this->code = rhs.code;
             this->location = rhs.location;
+            this->kind = rhs.kind;
             return *this;
         }
         
@@ -85,6 +148,9 @@ namespace snowcrash {
         
         // Annotation message
         std::string message;
+        
+        // Warning kind
+        WarningKind kind;
     };
     
     typedef SourceAnnotation Error;
@@ -0,0 +1,234 @@
+//
+//  ParserStatistics.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <algorithm>
+#include <iomanip>
+#include "ParserStatistics.h"
+#include "Platform.h"
+
+using namespace snowcrash;
+
+// Lookup counter of the calling thread, NULL when not counting
+static THREADLOCAL size_t* s_lookups = NULL;
+
+// Names of parser phases, by ParserPhase
+static const char* const PhaseNames[ParserPhaseCount] = {
+    "check",
+    "markdown",
+    "blueprint",
+    "serialize"
+};
+
+// Names of markdown block types, by MarkdownBlockType
+static const char* const BlockTypeNames[MarkdownBlockTypeCount] = {
+    "undefined",
+    "code",
+    "quoteBegin",
+    "quoteEnd",
+    "html",
+    "header",
+    "hrule",
+    "listBegin",
+    "listEnd",
+    "listItemBegin",
+    "listItemEnd",
+    "paragraph",
+    "table",
+    "tableRow",
+    "tableCell"
+};
+
+// Names of blueprint sections, by Section
+static const char* const SectionNames[SectionCount] = {
+    "undefined",
+    "blueprint",
+    "resourceGroup",
+    "resource",
+    "resourceMethod",
+    "method",
+    "request",
+    "requestBody",
+    "response",
+    "responseBody",
+    "object",
+    "objectBody",
+    "body",
+    "schema",
+    "headers",
+    "foreign"
+};
+
+ParserStatistics::ParserStatistics()
+: bytes(0), regexEvaluations(0), lookups(0), warnings(0), astSize(0), peakASTSize(0)
+{
+    std::fill(time, time + ParserPhaseCount, 0.0);
+    std::fill(allocations, allocations + ParserPhaseCount, 0);
+    std::fill(allocatedBytes, allocatedBytes + ParserPhaseCount, 0);
+    std::fill(peakLiveBytes, peakLiveBytes + ParserPhaseCount, 0);
+    std::fill(blocks, blocks + MarkdownBlockTypeCount, 0);
+    std::fill(sections, sections + SectionCount, 0);
+}
+
+ParserPhaseScope::ParserPhaseScope(ParserStatistics* statistics, ParserPhase phase)
+: m_statistics(statistics), m_phase(phase), m_timer(statistics ? &statistics->time[phase] : NULL)
+{
+    if (m_statistics && AllocationAccountingEnabled()) {
+        ResetPeakLiveBytes();
+        m_start = ThreadAllocationCounters();
+    }
+}
+
+ParserPhaseScope::~ParserPhaseScope()
+{
+    if (!m_statistics || !AllocationAccountingEnabled())
+        return;
+    
+    AllocationCounters counters = ThreadAllocationCounters();
+    m_statistics->allocations[m_phase] += counters.allocations - m_start.allocations;
+    m_statistics->allocatedBytes[m_phase] += counters.bytes - m_start.bytes;
+    
+    ptrdiff_t peak = counters.peakLiveBytes - m_start.liveBytes;
+    if (peak > 0)
+        m_statistics->peakLiveBytes[m_phase] = std::max(m_statistics->peakLiveBytes[m_phase], static_cast<size_t>(peak));
+}
+
+const char* snowcrash::PhaseIdentifier(ParserPhase phase)
+{
+    return (static_cast<size_t>(phase) < ParserPhaseCount) ? PhaseNames[phase] : "undefined";
+}
+
+const char* snowcrash::BlockTypeIdentifier(MarkdownBlockType type)
+{
+    return (static_cast<size_t>(type) < MarkdownBlockTypeCount) ? BlockTypeNames[type] : BlockTypeNames[UndefinedBlockType];
+}
+
+const char* snowcrash::SectionIdentifier(Section section)
+{
+    return (static_cast<size_t>(section) < SectionCount) ? SectionNames[section] : SectionNames[UndefinedSection];
+}
+
+size_t snowcrash::ASTSize(const ResourceGroup& resourceGroup)
+{
+    size_t size = 1;
+    for (Collection<Resource>::const_iterator resource = resourceGroup.resources.begin();
+         resource != resourceGroup.resources.end();
+         ++resource) {
+        
+        size += 1 + resource->methods.size();
+        for (Collection<Method>::const_iterator method = resource->methods.begin();
+             method != resource->methods.end();
+             ++method) {
+            
+            size += method->requests.size() + method->responses.size();
+        }
+    }
+    
+    return size;
+}
+
+void snowcrash::CountSection(ParserStatistics& statistics, Section section)
+{
+    if (static_cast<size_t>(section) < SectionCount)
+        ++statistics.sections[section];
+}
+
+size_t* snowcrash::SetLookupCounter(size_t* counter)
+{
+    size_t* previous = s_lookups;
+    s_lookups = counter;
+    return previous;
+}
+
+void snowcrash::CountLookup()
+{
+    if (s_lookups)
+        ++*s_lookups;
+}
+
+void snowcrash::CountASTSize(ParserStatistics& statistics, size_t parsed, size_t kept)
+{
+    statistics.peakASTSize = std::max(statistics.peakASTSize, statistics.astSize + parsed);
+    statistics.astSize += kept;
+}
+
+void snowcrash::PrintStatistics(const ParserStatistics& statistics, std::ostream& os)
+{
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << std::fixed << std::setprecision(3);
+    
+    os << "time (ms):\n";
+    for (size_t i = 0; i < ParserPhaseCount; ++i)
+        os << "  " << std::left << std::setw(16) << PhaseNames[i] << std::right << std::setw(12) << statistics.time[i] * 1e3 << "\n";
+    
+    if (AllocationAccountingEnabled()) {
+        os << "allocations:" << std::setw(18) << "count" << std::setw(14) << "bytes" << std::setw(14) << "peak bytes" << "\n";
+        for (size_t i = 0; i < ParserPhaseCount; ++i) {
+            os << "  " << std::left << std::setw(16) << PhaseNames[i] << std::right << std::setw(12) << statistics.allocations[i];
+            os << std::setw(14) << statistics.allocatedBytes[i] << std::setw(14) << statistics.peakLiveBytes[i] << "\n";
+        }
+    }
+    
+    os << "blocks:\n";
+    for (size_t i = 0; i < MarkdownBlockTypeCount; ++i) {
+        if (statistics.blocks[i])
+            os << "  " << std::left << std::setw(16) << BlockTypeNames[i] << std::right << std::setw(12) << statistics.blocks[i] << "\n";
+    }
+    
+    os << "sections:\n";
+    for (size_t i = 0; i < SectionCount; ++i) {
+        if (statistics.sections[i])
+            os << "  " << std::left << std::setw(16) << SectionNames[i] << std::right << std::setw(12) << statistics.sections[i] << "\n";
+    }
+    
+    os << std::left;
+    os << std::setw(18) << "bytes" << std::right << std::setw(12) << statistics.bytes << "\n" << std::left;
+    os << std::setw(18) << "regex evaluations" << std::right << std::setw(12) << statistics.regexEvaluations << "\n" << std::left;
+    os << std::setw(18) << "lookups" << std::right << std::setw(12) << statistics.lookups << "\n" << std::left;
+    os << std::setw(18) << "warnings" << std::right << std::setw(12) << statistics.warnings << "\n" << std::left;
+    os << std::setw(18) << "peak AST size" << std::right << std::setw(12) << statistics.peakASTSize << "\n";
+    
+    os.flags(flags);
+    os.precision(precision);
+}
+
+void snowcrash::PrintStatisticsJSON(const ParserStatistics& statistics, std::ostream& os)
+{
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << std::fixed << std::setprecision(6);
+    
+    os << "{\"time\":{";
+    for (size_t i = 0; i < ParserPhaseCount; ++i)
+        os << (i ? "," : "") << "\"" << PhaseNames[i] << "\":" << statistics.time[i];
+    
+    if (AllocationAccountingEnabled()) {
+        os << "},\"allocations\":{";
+        for (size_t i = 0; i < ParserPhaseCount; ++i) {
+            os << (i ? "," : "") << "\"" << PhaseNames[i] << "\":{\"count\":" << statistics.allocations[i];
+            os << ",\"bytes\":" << statistics.allocatedBytes[i] << ",\"peakBytes\":" << statistics.peakLiveBytes[i] << "}";
+        }
+    }
+    
+    os << "},\"blocks\":{";
+    for (size_t i = 0; i < MarkdownBlockTypeCount; ++i)
+        os << (i ? "," : "") << "\"" << BlockTypeNames[i] << "\":" << statistics.blocks[i];
+    
+    os << "},\"sections\":{";
+    for (size_t i = 0; i < SectionCount; ++i)
+        os << (i ? "," : "") << "\"" << SectionNames[i] << "\":" << statistics.sections[i];
+    
+    os << "},\"bytes\":" << statistics.bytes;
+    os << ",\"regexEvaluations\":" << statistics.regexEvaluations;
+    os << ",\"lookups\":" << statistics.lookups;
+    os << ",\"warnings\":" << statistics.warnings;
+    os << ",\"peakASTSize\":" << statistics.peakASTSize;
+    os << "}\n";
+    
+    os.flags(flags);
+    os.precision(precision);
+}
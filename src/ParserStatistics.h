@@ -0,0 +1,126 @@
+//
+//  ParserStatistics.h
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#ifndef SNOWCRASH_PARSERSTATISTICS_H
+#define SNOWCRASH_PARSERSTATISTICS_H
+
+#include <ostream>
+#include "MarkdownBlock.h"
+#include "BlueprintParserCore.h"
+#include "Allocation.h"
+#include "Timer.h"
+
+namespace snowcrash {
+    
+    //
+    // Parser Phase
+    //
+    enum ParserPhase {
+        CheckSourcePhase = 0,   // Source sanity check
+        MarkdownPhase,          // Markdown parsing (sundown)
+        BlueprintPhase,         // Blueprint parsing
+        SerializePhase,         // AST serialization, filled by the caller
+        ParserPhaseCount
+    };
+    
+    // Number of markdown block types
+    static const size_t MarkdownBlockTypeCount = TableCellBlockType + 1;
+    
+    // Number of blueprint sections
+    static const size_t SectionCount = ForeignSection + 1;
+    
+    //
+    // Parser Statistics
+    //
+    // Filled by the parser when passed in, collected otherwise.
+    //
+    struct ParserStatistics {
+        ParserStatistics();
+        
+        // Wall time in seconds, by phase
+        double time[ParserPhaseCount];
+        
+        // Heap allocations, allocated bytes and peak of live bytes over
+        // the live bytes at the phase start, by phase. Collected only by
+        // the allocation accounting build, see AllocationAccountingEnabled().
+        size_t allocations[ParserPhaseCount];
+        size_t allocatedBytes[ParserPhaseCount];
+        size_t peakLiveBytes[ParserPhaseCount];
+        
+        // Source data size in bytes
+        size_t bytes;
+        
+        // Markdown blocks parsed, by type
+        size_t blocks[MarkdownBlockTypeCount];
+        
+        // Section parser invocations, by section
+        size_t sections[SectionCount];
+        
+        // Regex evaluations
+        size_t regexEvaluations;
+        
+        // Duplicate check lookups, see CountLookup()
+        size_t lookups;
+        
+        // Warnings reported
+        size_t warnings;
+        
+        // Size of the AST (resource groups, resources, methods, requests
+        // & responses) held in the memory, current and peak
+        size_t astSize;
+        size_t peakASTSize;
+    };
+    
+    //
+    // Scoped Parser Phase
+    //
+    // Adds the wall time and the allocations of the calling thread between
+    // its construction and destruction to the phase statistics. Does nothing
+    // when the statistics are NULL. Phase scopes must not nest.
+    //
+    class ParserPhaseScope {
+    public:
+        ParserPhaseScope(ParserStatistics* statistics, ParserPhase phase);
+        ~ParserPhaseScope();
+        
+    private:
+        ParserStatistics* m_statistics;
+        ParserPhase m_phase;
+        AllocationCounters m_start;
+        Timer m_timer;
+        
+        ParserPhaseScope(const ParserPhaseScope&);
+        ParserPhaseScope& operator=(const ParserPhaseScope&);
+    };
+    
+    // Identifier of a parser phase, e.g. "markdown"
+    const char* PhaseIdentifier(ParserPhase phase);
+    
+    // Identifier of a markdown block type, e.g. "listItemBegin"
+    const char* BlockTypeIdentifier(MarkdownBlockType type);
+    
+    // Identifier of a section, e.g. "resourceGroup"
+    const char* SectionIdentifier(Section section);
+    
+    // Size of a resource group AST, see ParserStatistics::astSize
+    size_t ASTSize(const ResourceGroup& resourceGroup);
+    
+    // Add parsed section to statistics
+    void CountSection(ParserStatistics& statistics, Section section);
+    
+    // Add parsed resource group AST of `parsed` size, `kept` of which
+    // stays in the AST held in the memory
+    void CountASTSize(ParserStatistics& statistics, size_t parsed, size_t kept);
+    
+    // Write statistics in human readable format
+    void PrintStatistics(const ParserStatistics& statistics, std::ostream& os);
+    
+    // Write statistics as a JSON object
+    void PrintStatisticsJSON(const ParserStatistics& statistics, std::ostream& os);
+}
+
+#endif
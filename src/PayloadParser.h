@@ -30,6 +30,53 @@ static const std::string ObjectRegex("^[ \\t]*(" SYMBOL_IDENTIFIER ")[ \\t][Oo]b
 
 namespace snowcrash {
     
+    // Returns true if the payload asset of the section is left out of the
+    // projection and is not to be built, see BlueprintParserOption. Bodies
+    // to be checked for JSON are kept as their source for the check only.
+    FORCEINLINE bool IsAssetSkipped(BlueprintParserOptions options, const Section& section) {
+        if (section == BodySection)
+            return (options & SkipBodiesOption) != 0;
+        
+        if (section == SchemaSection)
+            return (options & SkipSchemasOption) != 0;
+        
+        return false;
+    }
+    
+    // Leave out payload assets not in the projection, see BlueprintParserOption.
+    // Only the assets built nevertheless are left to clear, see IsAssetSkipped().
+    FORCEINLINE void ProjectPayload(BlueprintParserOptions options, Payload& payload) {
+        if (options & SkipBodiesOption) {
+            payload.body.clear();
+            payload.bodySource = AssetSource();
+        }
+        
+        if (options & SkipSchemasOption) {
+            payload.schema.clear();
+            payload.schemaSource = AssetSource();
+        }
+    }
+    
+    // Queue the body of a parsed payload to be checked if its media type is JSON,
+    // see CheckJSONBodiesOption. The body is queued as its source ranges unless
+    // it has anything but code blocks, see AssetParser.
+    FORCEINLINE void QueueJSONBody(BlueprintParserCore& parser, const Payload& payload) {
+        if (parser.jsonBody.sourceMap.empty())
+            return;
+        
+        JSONBody body;
+        body.swap(parser.jsonBody);
+        if (body.body.empty() && body.bodySource.sourceMap.empty())
+            return;
+        
+        body.mediaType = PayloadMediaType(payload);
+        if (!IsJSONMediaType(body.mediaType))
+            return;
+        
+        parser.jsonBodies.push_back(JSONBody());
+        parser.jsonBodies.back().swap(body);
+    }
+    
     FORCEINLINE Collection<Request>::const_iterator FindRequest(const Method& method, const Request& request) {
         return std::find_if(method.requests.begin(),
                             method.requests.end(),
@@ -257,7 +304,9 @@ namespace snowcrash {
 
             if (sectionCur == bounds.first) {
                 // Signature
-                ProcessSignature(section, sectionCur, bounds.first, parser.sourceData, result.first, payload);
+                parser.skippedBody = false;
+                parser.skippedSchema = false;
+                ProcessSignature(section, sectionCur, bounds.first, parser, result.first, payload);
                 sectionCur = FirstContentBlock(cur, bounds.second);
             }
             else {
@@ -271,7 +320,9 @@ namespace snowcrash {
                 
                 if (!CheckCursor(sectionCur, bounds, cur, result.first))
                     return result;
-                payload.description += MapSourceData(parser.sourceData, sectionCur->sourceMap);
+                
+                if (!(parser.options & SkipDescriptionsOption))
+                    payload.description += MapSourceData(parser.sourceData, sectionCur->sourceMap);
             }
             
             if (sectionCur != bounds.second)
@@ -285,30 +336,55 @@ namespace snowcrash {
                                               const BlockIterator& end,
                                               BlueprintParserCore& parser,
                                               Payload& payload) {
+            // Asset left out of the projection is not built, only whether
+            // it has any content is kept for the empty & duplicate checks
+            bool skipped = IsAssetSkipped(parser.options, section);
+            bool skippedContent = false;
+            
             Asset asset;
+            AssetSource assetSource;
+            JSONBody checkedBody;
+            bool checked = (section == BodySection && (parser.options & CheckJSONBodiesOption));
+            parser.assetSource = (!skipped && (parser.options & AssetSourceOption)) ? &assetSource : NULL;
+            parser.skippedAssetContent = skipped ? &skippedContent : NULL;
+            parser.checkedBody = checked ? &checkedBody : NULL;
             ParseSectionResult result = AssetParser::Parse(begin, end, parser, asset);
+            parser.assetSource = NULL;
+            parser.skippedAssetContent = NULL;
+            parser.checkedBody = NULL;
             if (result.first.error.code != Error::OK)
                 return result;
             
-            if (asset.empty()) {
+            if (!skippedContent && asset.empty() && assetSource.sourceMap.empty()) {
                 // WARN: empty asset
                 BlockIterator nameBlock = ListItemNameBlock(begin, end);
-                std::stringstream ss;
-                ss << "empty " << SectionName(section) << " asset";
-                result.first.warnings.push_back(Warning(ss.str(),
+                result.first.warnings.push_back(Warning(EmptyAssetWarning,
                                                         0,
-                                                        nameBlock->sourceMap));
+                                                        nameBlock->sourceMap,
+                                                        SectionName(section)));
             }
             
             
-            if (!SetAsset(section, asset, payload)) {
+            bool set = skipped ? SetSkippedAsset(section, skippedContent, parser, payload) : SetAsset(section, asset, assetSource, parser, payload);
+            if (!set) {
                 // WARN: asset already set
                 BlockIterator nameBlock = ListItemNameBlock(begin, end);
-                std::stringstream ss;
-                ss << "ignoring " << SectionName(section) << " asset, asset already defined";
-                result.first.warnings.push_back(Warning(ss.str(),
+                result.first.warnings.push_back(Warning(DuplicateAssetWarning,
                                                         0,
-                                                        nameBlock->sourceMap));
+                                                        nameBlock->sourceMap,
+                                                        SectionName(section)));
+            }
+            else if (checked) {
+                // Body location is its code blocks, the list item name if there is none
+                for (BlockIterator it = begin; it != result.second; ++it) {
+                    if (it->type == CodeBlockType)
+                        AppendSourceDataBlock(checkedBody.sourceMap, it->sourceMap);
+                }
+                
+                if (checkedBody.sourceMap.empty())
+                    checkedBody.sourceMap = ListItemNameBlock(begin, end)->sourceMap;
+                
+                parser.jsonBody.swap(checkedBody);
             }
             
             return result;
@@ -320,6 +396,9 @@ namespace snowcrash {
                                                      const BlockIterator& end,
                                                      BlueprintParserCore& parser,
                                                      Payload& payload) {
+            parser.skippedBody = false;
+            parser.skippedSchema = false;
+            
             // Try to parse as a Symbol reference
             SymbolName symbol;
             SourceDataBlock symbolSourceMap;
@@ -348,7 +427,7 @@ namespace snowcrash {
             }
             
             // Retrieve signature
-            ProcessSignature(section, begin, end, parser.sourceData, result.first, payload);
+            ProcessSignature(section, begin, end, parser, result.first, payload);
             
             return result;
         }
@@ -407,10 +486,10 @@ namespace snowcrash {
                         cur = SkipToSectionEnd(cur, endCur, ListBlockBeginType, ListBlockEndType);
                     
                     // WARN: ignoring extraneous content after symbol reference
-                    std::stringstream ss;
-                    ss << "ignoring extraneous content after symbol reference";
-                    ss << ", expected symbol reference only e.g. `[" << symbolName << "][]`";
-                    result.first.warnings.push_back(Warning(ss.str(), 0, cur->sourceMap));
+                    result.first.warnings.push_back(Warning(SymbolReferenceContentWarning,
+                                                            0,
+                                                            cur->sourceMap,
+                                                            symbolName));
                 }
             }
             
@@ -424,7 +503,7 @@ namespace snowcrash {
         static void ProcessSignature(const Section& section,
                                      const BlockIterator& begin,
                                      const BlockIterator& end,
-                                     const SourceData& sourceData,
+                                     const BlueprintParserCore& parser,
                                      Result& result,
                                      Payload& payload) {
             
@@ -438,7 +517,8 @@ namespace snowcrash {
             // Add any extra lines to description unless abbreviated body
             if (!remainingContent.empty() &&
                 section != RequestBodySection &&
-                section != ResponseBodySection) {
+                section != ResponseBodySection &&
+                !(parser.options & SkipDescriptionsOption)) {
                 payload.description += remainingContent;
             }
             
@@ -446,7 +526,7 @@ namespace snowcrash {
             if (payload.name.empty() &&
                 (section == ResponseSection || section == ResponseBodySection)) {
                 BlockIterator nameBlock = ListItemNameBlock(begin, end);
-                result.warnings.push_back(Warning("missing response HTTP status code, assuming `Response 200`",
+                result.warnings.push_back(Warning(MissingStatusCodeWarning,
                                                   0,
                                                   nameBlock->sourceMap));
                 payload.name = "200";
@@ -459,24 +539,60 @@ namespace snowcrash {
             }
         }
         
+        // Returns true if payload section asset is set, built or skipped
+        static bool HasAsset(const Section& section,
+                             const BlueprintParserCore& parser,
+                             const Payload& payload) {
+            
+            if (section == BodySection)
+                return parser.skippedBody || !payload.body.empty() || !payload.bodySource.sourceMap.empty();
+            
+            if (section == SchemaSection)
+                return parser.skippedSchema || !payload.schema.empty() || !payload.schemaSource.sourceMap.empty();
+            
+            return false;
+        }
+        
         // Sets payload section asset. Returns true on success, false when asset is already set.
-        static bool SetAsset(const Section& section, const Asset& asset, Payload& payload) {
+        static bool SetAsset(const Section& section,
+                             const Asset& asset,
+                             const AssetSource& assetSource,
+                             const BlueprintParserCore& parser,
+                             Payload& payload) {
+            
+            if (HasAsset(section, parser, payload))
+                return false;
             
             if (section == BodySection) {
-                if (!payload.body.empty())
-                    return false;
-
                 payload.body = asset;
+                payload.bodySource = assetSource;
             }
             else if (section == SchemaSection) {
-                if (!payload.schema.empty())
-                    return false;
-                
                 payload.schema = asset;
+                payload.schemaSource = assetSource;
             }
             
             return true;
         }
+        
+        // Sets payload section asset left out of the projection, keeping
+        // only whether it has any content. Returns true on success, false
+        // when asset is already set.
+        static bool SetSkippedAsset(const Section& section,
+                                    bool content,
+                                    BlueprintParserCore& parser,
+                                    Payload& payload) {
+            
+            if (HasAsset(section, parser, payload))
+                return false;
+            
+            if (section == BodySection)
+                parser.skippedBody = content;
+            else if (section == SchemaSection)
+                parser.skippedSchema = content;
+            
+            return true;
+        }
     };
     
     typedef BlockParser<Payload, SectionParser<Payload> > PayloadParser;    
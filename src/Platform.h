@@ -17,4 +17,10 @@
 #   define FORCEINLINE inline
 #endif
 
+#if defined(_MSC_VER)
+#   define THREADLOCAL __declspec(thread)
+#else
+#   define THREADLOCAL __thread
+#endif
+
 #endif
@@ -27,6 +27,32 @@ namespace snowcrash {
     // Performs posix-regex
     // returns true if target string matches given expression, false otherwise
     bool RegexCapture(const std::string& target, const std::string& expression, CaptureGroups& captureGroups, size_t groupSize = 8);
+    
+    // Count regex evaluations of the calling thread into the counter,
+    // NULL stops counting. Returns the counter set before.
+    size_t* SetRegexEvaluationCounter(size_t* counter);
+    
+    //
+    // Scope counting regex evaluations of the calling thread, nothing
+    // is counted (nor costs more than a check) outside of any scope
+    //
+    class RegexEvaluationScope {
+    public:
+        explicit RegexEvaluationScope(size_t* counter)
+        : m_previous(counter ? SetRegexEvaluationCounter(counter) : NULL), m_active(counter != NULL) {}
+        
+        ~RegexEvaluationScope() {
+            if (m_active)
+                SetRegexEvaluationCounter(m_previous);
+        }
+        
+    private:
+        size_t* m_previous;
+        bool m_active;
+        
+        RegexEvaluationScope(const RegexEvaluationScope&);
+        RegexEvaluationScope& operator=(const RegexEvaluationScope&);
+    };
 }
 
 #endif
@@ -124,7 +124,7 @@ namespace snowcrash {
                 if (sectionCur == bounds.first) {
                     
                     // WARN: No Group name specified
-                    result.first.warnings.push_back(Warning("expected resource group name, e.g. `# <Group Name>`",
+                    result.first.warnings.push_back(Warning(ExpectedResourceGroupNameWarning,
                                                             0,
                                                             cur->sourceMap));
                 }
@@ -139,7 +139,9 @@ namespace snowcrash {
                 
                 if (!CheckCursor(sectionCur, bounds, cur, result.first))
                     return result;
-                group.description += MapSourceData(parser.sourceData, sectionCur->sourceMap);
+                
+                if (!(parser.options & SkipDescriptionsOption))
+                    group.description += MapSourceData(parser.sourceData, sectionCur->sourceMap);
             }
             
             result.second = ++sectionCur;
@@ -156,22 +158,22 @@ namespace snowcrash {
             if (result.first.error.code != Error::OK)
                 return result;
             
-            ResourceIterator duplicate = FindResource(group, resource);
-            ResourceIteratorPair globalDuplicate;
-            if (duplicate == group.resources.end())
-                globalDuplicate = FindResource(parser.blueprint, resource);
-            
-            if (duplicate != group.resources.end() ||
-                globalDuplicate.first != parser.blueprint.resourceGroups.end()) {
+            // Duplicate within the group or the blueprint
+            CountLookup();
+            if (!parser.resourceIndex.insert(resource.uriTemplate).second) {
                 
                 // WARN: duplicate resource
-                result.first.warnings.push_back(Warning("resource `" +
-                                                        resource.uriTemplate +
-                                                        "` is already defined",
+                result.first.warnings.push_back(Warning(DuplicateResourceWarning,
                                                         0,
-                                                        begin->sourceMap));
+                                                        begin->sourceMap,
+                                                        resource.uriTemplate));
             }
             
+            // Resources are checked against the index only
+            if (parser.options & ValidateOnlyOption)
+                return result;
+            
+            ProjectResource(parser.options, resource);
             group.resources.push_back(resource); // FIXME: C++11 move
             return result;
         }
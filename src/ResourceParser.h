@@ -15,6 +15,7 @@
 #include "MethodParser.h"
 #include "RegexMatch.h"
 #include "StringUtility.h"
+#include "URITemplate.h"
 
 static const std::string ResourceHeaderRegex("^[ \\t]*((" HTTP_METHODS ")[ \\t]+)?(" URI_TEMPLATE ")$");
 static const std::string NamedResourceHeaderRegex("^[ \\t]*(" SYMBOL_IDENTIFIER ")[ \\t]+\\[(" URI_TEMPLATE ")]$");
@@ -66,6 +67,26 @@ namespace snowcrash {
         return GetResourceSignature(block, name, uri, method) != NoResourceSignature;
     }
 
+    // Leave out headers not in the projection, see BlueprintParserOption.
+    // Headers are kept while the resource is parsed, for the duplicate checks.
+    FORCEINLINE void ProjectResource(BlueprintParserOptions options, Resource& resource) {
+        if (!(options & SkipHeadersOption))
+            return;
+        
+        resource.headers.clear();
+        resource.object.headers.clear();
+        for (Collection<Method>::iterator method = resource.methods.begin();
+             method != resource.methods.end();
+             ++method) {
+            
+            method->headers.clear();
+            for (Collection<Request>::iterator it = method->requests.begin(); it != method->requests.end(); ++it)
+                it->headers.clear();
+            for (Collection<Response>::iterator it = method->responses.begin(); it != method->responses.end(); ++it)
+                it->headers.clear();
+        }
+    }
+    
     // Resource iterator in its containment group
     typedef Collection<Resource>::const_iterator ResourceIterator;
     
@@ -213,6 +234,7 @@ namespace snowcrash {
                 // Retrieve URI
                 HTTPMethod method;
                 GetResourceSignature(*cur, resource.name, resource.uriTemplate, method);
+                CompileResourceURITemplate(cur, parser, resource, result.first);
             }
             else {
                 
@@ -225,7 +247,9 @@ namespace snowcrash {
                 
                 if (!CheckCursor(sectionCur, bounds, cur, result.first))
                     return result;
-                resource.description += MapSourceData(parser.sourceData, sectionCur->sourceMap);
+                
+                if (!(parser.options & SkipDescriptionsOption))
+                    resource.description += MapSourceData(parser.sourceData, sectionCur->sourceMap);
             }
             
             result.second = ++sectionCur;
@@ -242,25 +266,24 @@ namespace snowcrash {
             if (result.first.error.code != Error::OK)
                 return result;
             
+            QueueJSONBody(parser, payload);
+            ProjectPayload(parser.options, payload);
+            
             if (!resource.object.name.empty()) {
                 // WARN: object already defined
-                std::stringstream ss;
-                ss << "ignoring additional object definiton for `";
-                if (!resource.name.empty()) {
-                    ss << resource.name << "(" << resource.uriTemplate << ")";
-                }
-                else {
-                    ss << resource.uriTemplate;
-                }
-                ss << "` resource, a resource can be represented single (1) object only";
-                
                 BlockIterator nameBlock = ListItemNameBlock(begin, end);
-                result.first.warnings.push_back(Warning(ss.str(),
+                result.first.warnings.push_back(Warning(DuplicateObjectWarning,
                                                         0,
-                                                        nameBlock->sourceMap));
+                                                        nameBlock->sourceMap,
+                                                        resource.name,
+                                                        resource.uriTemplate));
             }
             else {
-                resource.object = payload;
+                // Validation keeps the name the duplicate check needs only
+                if (parser.options & ValidateOnlyOption)
+                    resource.object.name = payload.name;
+                else
+                    resource.object = payload;
                 
                 ResourceObjectSymbolTable::const_iterator it = parser.symbolTable.resourceObjects.find(payload.name);
                 if (it != parser.symbolTable.resourceObjects.end()) {
@@ -288,9 +311,32 @@ namespace snowcrash {
             // Retrieve URI template
             HTTPMethod method;
             GetResourceSignature(*cur, resource.name, resource.uriTemplate, method);
+            Result uriResult;
+            CompileResourceURITemplate(cur, parser, resource, uriResult);
             
             // Parse as a resource method abbreviation
-            return HandleMethod(cur, bounds.second, parser, resource, true);
+            ParseSectionResult result = HandleMethod(cur, bounds.second, parser, resource, true);
+            uriResult += result.first;
+            result.first = uriResult;
+            return result;
+        }
+        
+        // Compile URI template of a resource, warn if it is malformed.
+        // Validation checks the template without keeping it compiled.
+        static void CompileResourceURITemplate(const BlockIterator& cur,
+                                               BlueprintParserCore& parser,
+                                               Resource& resource,
+                                               Result& result) {
+            
+            CompiledURITemplate validated;
+            CompiledURITemplate& compiled = (parser.options & ValidateOnlyOption) ? validated : resource.compiledURITemplate;
+            if (!CompileURITemplate(resource.uriTemplate, compiled)) {
+                // WARN: malformed URI template
+                result.warnings.push_back(Warning(MalformedURITemplateWarning,
+                                                  0,
+                                                  cur->sourceMap,
+                                                  resource.uriTemplate));
+            }
         }
         
         static ParseSectionResult HandleMethod(const BlockIterator& begin,
@@ -300,6 +346,8 @@ namespace snowcrash {
                                                bool abbrev = false)
         {
             Method method;
+            parser.requestIndex.clear();
+            parser.responseIndex.clear();
             ParseSectionResult result = MethodParser::Parse(begin, end, parser, method);
             if (result.first.error.code != Error::OK)
                 return result;
@@ -310,10 +358,11 @@ namespace snowcrash {
                 MethodSignature methodSignature = GetMethodSignature(*begin, name, httpMethod);
                 if (methodSignature == MethodURIMethodSignature) {
                     // WARN: ignoring extraneous content in method header
-                    std::stringstream ss;
-                    ss << "ignoring extraneous content in method header `" << begin->content << "`";
-                    ss << ", expected method-only e.g. `# " << method.method << "`";
-                    result.first.warnings.push_back(Warning(ss.str(), 0, begin->sourceMap));
+                    result.first.warnings.push_back(Warning(MethodHeaderContentWarning,
+                                                            0,
+                                                            begin->sourceMap,
+                                                            begin->content,
+                                                            method.method));
                 }
             }
             
@@ -321,26 +370,30 @@ namespace snowcrash {
             if (duplicate != resource.methods.end()) {
                 
                 // WARN: duplicate method
-                result.first.warnings.push_back(Warning("method `" +
-                                                        method.method +
-                                                        "` already defined for resource `" +
-                                                        resource.uriTemplate +
-                                                        "`",
+                result.first.warnings.push_back(Warning(DuplicateMethodWarning,
                                                         0,
-                                                        begin->sourceMap));
+                                                        begin->sourceMap,
+                                                        method.method,
+                                                        resource.uriTemplate));
             }
             
             DeepCheckHeaderDuplicates(resource, method, begin->sourceMap, result.first);
             
             if (method.responses.empty()) {
                 // WARN: method has no response
-                result.first.warnings.push_back(Warning("no response defined for `" +
-                                                        method.method +
-                                                        " " +
-                                                        resource.uriTemplate +
-                                                        "`",
+                result.first.warnings.push_back(Warning(NoResponseWarning,
                                                         0,
-                                                        begin->sourceMap));
+                                                        begin->sourceMap,
+                                                        method.method,
+                                                        resource.uriTemplate));
+            }
+            
+            if (parser.options & ValidateOnlyOption) {
+                // Keep only what the duplicate check needs
+                Method skeleton;
+                skeleton.method = method.method;
+                resource.methods.push_back(skeleton);
+                return result;
             }
             
             resource.methods.push_back(method);
@@ -383,9 +436,10 @@ namespace snowcrash {
             if (methodSignature == MethodMethodSignature ||
                 methodSignature == NamedMethodSignature) {
                 // WARN: ignoring possible method header
-                std::stringstream ss;
-                ss << "ambiguous method `" << begin->content << "`, check previous resource definition";
-                result.warnings.push_back(Warning(ss.str(), 0, begin->sourceMap));
+                result.warnings.push_back(Warning(AmbiguousMethodWarning,
+                                                  0,
+                                                  begin->sourceMap,
+                                                  begin->content));
             }
         }
     };
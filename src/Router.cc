@@ -0,0 +1,499 @@
+//
+//  Router.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <algorithm>
+#include <cstring>
+#include "Router.h"
+
+using namespace snowcrash;
+
+const size_t Router::NoNode = static_cast<size_t>(-1);
+
+// Compare a string with a character range
+static int CompareRange(const std::string& str, const char* data, size_t length)
+{
+    size_t common = std::min(str.length(), length);
+    int result = (common) ? ::memcmp(str.data(), data, common) : 0;
+    if (result)
+        return result;
+
+    if (str.length() == length)
+        return 0;
+
+    return (str.length() < length) ? -1 : 1;
+}
+
+// Order literal edges by segment
+struct LiteralEdgeLess {
+    bool operator()(const std::pair<std::string, size_t>& lhs,
+                    const std::pair<std::string, size_t>& rhs) const {
+        return lhs.first < rhs.first;
+    }
+};
+
+// Find a character in a range, returns position or end
+static size_t FindChar(const char* data, size_t begin, size_t end, char c)
+{
+    const void* found = (begin < end) ? ::memchr(data + begin, c, end - begin) : NULL;
+    return (found) ? static_cast<const char*>(found) - data : end;
+}
+
+// Find a string in a range, returns position or end
+static size_t FindString(const char* data, size_t begin, size_t end, const std::string& str)
+{
+    if (str.empty())
+        return begin;
+
+    while (begin + str.length() <= end) {
+        begin = FindChar(data, begin, end, str[0]);
+        if (begin + str.length() > end)
+            break;
+
+        if (::memcmp(data + begin, str.data(), str.length()) == 0)
+            return begin;
+
+        ++begin;
+    }
+
+    return end;
+}
+
+void RouteMatch::getVariables(const std::string& path, Collection<KeyValuePair>::type& variables) const
+{
+    variables.clear();
+    for (std::vector<RouteVariable>::const_iterator it = this->variables.begin();
+         it != this->variables.end();
+         ++it) {
+
+        variables.push_back(std::make_pair(*it->name, path.substr(it->offset, it->length)));
+    }
+}
+
+Router::Router()
+{
+    clear();
+}
+
+Router::Router(const Blueprint& blueprint)
+{
+    build(blueprint);
+}
+
+void Router::build(const Blueprint& blueprint)
+{
+    clear();
+
+    LiteralIndex index;
+    for (Collection<ResourceGroup>::const_iterator group = blueprint.resourceGroups.begin();
+         group != blueprint.resourceGroups.end();
+         ++group) {
+
+        for (Collection<Resource>::const_iterator resource = group->resources.begin();
+             resource != group->resources.end();
+             ++resource) {
+
+            add(*resource, &index);
+        }
+    }
+
+    // Literal edges were appended unordered while building
+    for (std::vector<Node>::iterator it = m_nodes.begin(); it != m_nodes.end(); ++it) {
+        std::sort(it->literals.begin(), it->literals.end(), LiteralEdgeLess());
+    }
+}
+
+void Router::add(const Resource& resource)
+{
+    add(resource, NULL);
+}
+
+void Router::clear()
+{
+    m_routes.clear();
+    m_nodes.clear();
+    m_nodes.push_back(Node());
+}
+
+void Router::ParseTemplate(const CompiledURITemplate& uriTemplate,
+                           std::vector<Segment>& segments,
+                           std::vector<std::string>& queryVariables)
+{
+    segments.clear();
+    queryVariables.clear();
+    segments.push_back(Segment());
+
+    bool query = false;
+    for (Collection<URITemplatePart>::const_iterator part = uriTemplate.parts.begin();
+         part != uriTemplate.parts.end();
+         ++part) {
+
+        if (part->type == LiteralURITemplatePartType) {
+            for (std::string::const_iterator c = part->literal.begin(); c != part->literal.end(); ++c) {
+                if (*c == '#')
+                    break;
+
+                if (*c == '?')
+                    query = true;
+                else if (!query && *c == '/')
+                    segments.push_back(Segment());
+                else if (!query)
+                    segments.back().literals.back() += *c;
+            }
+
+            if (part->literal.find('#') != std::string::npos)
+                break;
+
+            continue;
+        }
+
+        const Collection<URITemplateVariable>::type& variables = part->variables;
+        if (part->op == '?' || part->op == '&') {
+            for (Collection<URITemplateVariable>::const_iterator it = variables.begin(); it != variables.end(); ++it)
+                queryVariables.push_back(it->name);
+
+            query = true;
+            continue;
+        }
+
+        if (part->op == '#')
+            break;
+
+        if (query)
+            continue;
+
+        // Expression ends the path part of the template
+        Collection<URITemplatePart>::const_iterator next = part + 1;
+        bool last = (next == uriTemplate.parts.end() ||
+                     (next->type == LiteralURITemplatePartType && !next->literal.empty() && std::strchr("?#", next->literal[0])) ||
+                     (next->type == ExpressionURITemplatePartType && next->op && std::strchr("?&#", next->op)));
+
+        for (size_t j = 0; j < variables.size(); ++j) {
+
+            if (part->op == '/')
+                segments.push_back(Segment());
+            else if (part->op == '.')
+                segments.back().literals.back() += ".";
+            else if (part->op == ';')
+                segments.back().literals.back() += ";" + variables[j].name + "=";
+            else if (j > 0)
+                segments.back().literals.back() += ",";
+
+            Segment& segment = segments.back();
+            segment.variables.push_back(variables[j].name);
+            segment.literals.push_back(std::string());
+
+            if (last && j == variables.size() - 1 &&
+                (part->op == '+' || (part->op == '/' && variables[j].explode)))
+                segment.rest = true;
+        }
+    }
+
+    // Templates are rooted at `/`
+    if (segments.size() > 1 &&
+        segments.front().variables.empty() &&
+        segments.front().literals.front().empty()) {
+
+        segments.erase(segments.begin());
+    }
+}
+
+void Router::add(const Resource& resource, LiteralIndex* index)
+{
+    std::vector<Segment> segments;
+    Route route;
+    route.resource = &resource;
+
+    // Resources not coming from the parser may lack the compiled template
+    const CompiledURITemplate* uriTemplate = &resource.compiledURITemplate;
+    CompiledURITemplate compiled;
+    if (uriTemplate->parts.empty() && !resource.uriTemplate.empty()) {
+        CompileURITemplate(resource.uriTemplate, compiled);
+        uriTemplate = &compiled;
+    }
+
+    ParseTemplate(*uriTemplate, segments, route.queryVariables);
+
+    size_t routeIndex = m_routes.size();
+    size_t node = 0;
+    for (std::vector<Segment>::const_iterator it = segments.begin(); it != segments.end(); ++it) {
+
+        bool wildcard = (it->variables.size() == 1 &&
+                         it->literals.front().empty() &&
+                         it->literals.back().empty());
+
+        if (wildcard && it->rest && it + 1 == segments.end()) {
+            route.variables.push_back(it->variables.front());
+            m_nodes[node].restRoutes.push_back(routeIndex);
+            m_routes.push_back(route);
+            return;
+        }
+
+        if (it->variables.empty())
+            node = literalChild(node, it->literals.front(), index);
+        else if (wildcard)
+            node = wildcardChild(node);
+        else
+            node = patternChild(node, it->literals);
+
+        route.variables.insert(route.variables.end(), it->variables.begin(), it->variables.end());
+    }
+
+    m_nodes[node].routes.push_back(routeIndex);
+    m_routes.push_back(route);
+}
+
+size_t Router::literalChild(size_t node, const std::string& segment, LiteralIndex* index)
+{
+    if (index) {
+        LiteralIndex::key_type key(node, segment);
+        LiteralIndex::const_iterator found = index->find(key);
+        if (found != index->end())
+            return found->second;
+
+        size_t child = m_nodes.size();
+        m_nodes.push_back(Node());
+        m_nodes[node].literals.push_back(std::make_pair(segment, child));
+        (*index)[key] = child;
+        return child;
+    }
+
+    LiteralEdge edge(segment, m_nodes.size());
+    std::vector<LiteralEdge>& literals = m_nodes[node].literals;
+    std::vector<LiteralEdge>::iterator it = std::lower_bound(literals.begin(), literals.end(), edge, LiteralEdgeLess());
+    if (it != literals.end() && it->first == segment)
+        return it->second;
+
+    literals.insert(it, edge);
+    m_nodes.push_back(Node());
+    return edge.second;
+}
+
+size_t Router::patternChild(size_t node, const std::vector<std::string>& literals)
+{
+    for (std::vector<PatternEdge>::const_iterator it = m_nodes[node].patterns.begin();
+         it != m_nodes[node].patterns.end();
+         ++it) {
+
+        if (it->literals == literals)
+            return it->node;
+    }
+
+    PatternEdge edge;
+    edge.literals = literals;
+    edge.node = m_nodes.size();
+    m_nodes[node].patterns.push_back(edge);
+    m_nodes.push_back(Node());
+    return edge.node;
+}
+
+size_t Router::wildcardChild(size_t node)
+{
+    if (m_nodes[node].wildcard == NoNode) {
+        m_nodes[node].wildcard = m_nodes.size();
+        m_nodes.push_back(Node());
+    }
+
+    return m_nodes[node].wildcard;
+}
+
+bool Router::match(const HTTPMethod& method, const std::string& path, RouteMatch& result) const
+{
+    return match(method.data(), method.length(), path.data(), path.length(), result);
+}
+
+bool Router::match(const char* method, size_t methodLength,
+                   const char* path, size_t pathLength,
+                   RouteMatch& result) const
+{
+    result.resource = NULL;
+    result.method = NULL;
+    result.variables.clear();
+
+    Lookup state;
+    state.method = method;
+    state.methodLength = methodLength;
+    state.path = path;
+
+    // Split off query & fragment
+    size_t fragment = FindChar(path, 0, pathLength, '#');
+    state.pathLength = FindChar(path, 0, fragment, '?');
+    state.queryOffset = (state.pathLength < fragment) ? state.pathLength + 1 : fragment;
+    state.queryLength = fragment - state.queryOffset;
+
+    if (!state.pathLength || path[0] != '/')
+        return false;
+
+    // Prefer a resource with the method, fall back to any resource
+    state.requireMethod = true;
+    if (lookup(0, 1, state, result))
+        return true;
+
+    state.requireMethod = false;
+    return lookup(0, 1, state, result);
+}
+
+bool Router::lookup(size_t node, size_t position, const Lookup& state, RouteMatch& result) const
+{
+    const Node& current = m_nodes[node];
+    size_t end = FindChar(state.path, position, state.pathLength, '/');
+    bool last = (end == state.pathLength);
+    size_t length = end - position;
+    size_t captured = result.variables.size();
+
+    // Literal segment
+    if (!current.literals.empty()) {
+        size_t low = 0;
+        size_t high = current.literals.size();
+        while (low < high) {
+            size_t mid = low + (high - low) / 2;
+            int comparison = CompareRange(current.literals[mid].first, state.path + position, length);
+            if (comparison < 0) {
+                low = mid + 1;
+            }
+            else if (comparison > 0) {
+                high = mid;
+            }
+            else {
+                size_t child = current.literals[mid].second;
+                if (last ? resolve(m_nodes[child].routes, state, result) : lookup(child, end + 1, state, result))
+                    return true;
+                break;
+            }
+        }
+    }
+
+    // Segment patterns
+    for (std::vector<PatternEdge>::const_iterator it = current.patterns.begin();
+         it != current.patterns.end();
+         ++it) {
+
+        const std::vector<std::string>& literals = it->literals;
+        size_t offset = position;
+        if (length < literals.front().length() ||
+            CompareRange(literals.front(), state.path + offset, literals.front().length()) != 0)
+            continue;
+
+        offset += literals.front().length();
+        bool matched = true;
+        for (size_t i = 1; i < literals.size() && matched; ++i) {
+
+            // Variables are non-empty and end at the first occurrence of the next literal,
+            // the last variable takes the rest of the segment but the trailing literal.
+            size_t next;
+            if (i == literals.size() - 1) {
+                next = end - literals[i].length();
+                matched = (next > offset && next <= end &&
+                           CompareRange(literals[i], state.path + next, literals[i].length()) == 0);
+            }
+            else {
+                next = FindString(state.path, offset + 1, end, literals[i]);
+                matched = (next < end);
+            }
+
+            if (!matched)
+                break;
+
+            RouteVariable variable;
+            variable.name = NULL;
+            variable.offset = offset;
+            variable.length = next - offset;
+            result.variables.push_back(variable);
+            offset = next + literals[i].length();
+        }
+
+        if (matched) {
+            if (last ? resolve(m_nodes[it->node].routes, state, result) : lookup(it->node, end + 1, state, result))
+                return true;
+        }
+
+        result.variables.resize(captured);
+    }
+
+    // Wildcard segment
+    if (current.wildcard != NoNode && length) {
+        RouteVariable variable;
+        variable.name = NULL;
+        variable.offset = position;
+        variable.length = length;
+        result.variables.push_back(variable);
+
+        if (last ? resolve(m_nodes[current.wildcard].routes, state, result) : lookup(current.wildcard, end + 1, state, result))
+            return true;
+
+        result.variables.resize(captured);
+    }
+
+    // Rest of the path
+    if (!current.restRoutes.empty() && position < state.pathLength) {
+        RouteVariable variable;
+        variable.name = NULL;
+        variable.offset = position;
+        variable.length = state.pathLength - position;
+        result.variables.push_back(variable);
+
+        if (resolve(current.restRoutes, state, result))
+            return true;
+
+        result.variables.resize(captured);
+    }
+
+    return false;
+}
+
+bool Router::resolve(const std::vector<size_t>& routes, const Lookup& state, RouteMatch& result) const
+{
+    for (std::vector<size_t>::const_iterator it = routes.begin(); it != routes.end(); ++it) {
+
+        const Route& route = m_routes[*it];
+        const Method* method = NULL;
+        for (Collection<Method>::const_iterator m = route.resource->methods.begin();
+             m != route.resource->methods.end();
+             ++m) {
+
+            if (CompareRange(m->method, state.method, state.methodLength) == 0) {
+                method = &*m;
+                break;
+            }
+        }
+
+        if (state.requireMethod && !method)
+            continue;
+
+        result.resource = route.resource;
+        result.method = method;
+
+        // Name path variables in capture order
+        for (size_t i = 0; i < route.variables.size() && i < result.variables.size(); ++i)
+            result.variables[i].name = &route.variables[i];
+
+        // Capture query variables
+        size_t queryEnd = state.queryOffset + state.queryLength;
+        for (std::vector<std::string>::const_iterator name = route.queryVariables.begin();
+             name != route.queryVariables.end();
+             ++name) {
+
+            size_t pair = state.queryOffset;
+            while (pair < queryEnd) {
+                size_t pairEnd = FindChar(state.path, pair, queryEnd, '&');
+                size_t equals = FindChar(state.path, pair, pairEnd, '=');
+                if (CompareRange(*name, state.path + pair, equals - pair) == 0) {
+                    RouteVariable variable;
+                    variable.name = &*name;
+                    variable.offset = (equals < pairEnd) ? equals + 1 : pairEnd;
+                    variable.length = pairEnd - variable.offset;
+                    result.variables.push_back(variable);
+                    break;
+                }
+                pair = pairEnd + 1;
+            }
+        }
+
+        return true;
+    }
+
+    return false;
+}
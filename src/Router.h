@@ -0,0 +1,168 @@
+//
+//  Router.h
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#ifndef SNOWCRASH_ROUTER_H
+#define SNOWCRASH_ROUTER_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include "Blueprint.h"
+#include "URITemplate.h"
+
+namespace snowcrash {
+
+    // URI template variable captured by a route match
+    typedef URITemplateCapture RouteVariable;
+
+    //
+    // Result of a route lookup
+    //
+    struct RouteMatch {
+
+        RouteMatch() : resource(NULL), method(NULL) {}
+
+        // Matching resource, NULL if no URI template matches the path
+        const Resource* resource;
+
+        // Matching method of the resource, NULL if the resource has no such method
+        const Method* method;
+
+        // Captured variables
+        std::vector<RouteVariable> variables;
+
+        // Retrieve captured variables as key value pairs
+        void getVariables(const std::string& path, Collection<KeyValuePair>::type& variables) const;
+    };
+
+    //
+    // Routing index of resources in a blueprint
+    //
+    // URI templates are compiled into a trie keyed by path segments.
+    // Literal segments are looked up by binary search, template variables
+    // are wildcard edges. Query and fragment parts of both the templates
+    // and the looked-up paths are not used for routing but query variables
+    // are captured from the query string.
+    //
+    // Lookup is depth first, trying the literal edge, then the pattern and
+    // wildcard edges of a node. It backtracks when a branch does not match
+    // the rest of the path, so its cost is not strictly linear in the path
+    // length. Every edge consumes one path segment and every node has a
+    // single parent, hence a lookup visits each node at most once and is
+    // bounded by the nodes within the path's depth of the trie.
+    //
+    // The router refers to resources of the blueprint; the blueprint must
+    // outlive the router and must not be modified.
+    //
+    class Router {
+    public:
+        Router();
+        explicit Router(const Blueprint& blueprint);
+
+        // Build the index of all resources in a blueprint
+        void build(const Blueprint& blueprint);
+
+        // Add a resource into the index
+        void add(const Resource& resource);
+
+        // Remove all routes
+        void clear();
+
+        // Find resource & method for given HTTP method and request path.
+        // Returns true when a resource matches the path, false otherwise.
+        bool match(const HTTPMethod& method, const std::string& path, RouteMatch& result) const;
+
+        // Allocation-free variant of match(), reuses capacity of the result
+        bool match(const char* method, size_t methodLength,
+                   const char* path, size_t pathLength,
+                   RouteMatch& result) const;
+
+    private:
+
+        // Segment of a URI template, literals and variables alternate
+        // starting and ending with a literal (possibly empty)
+        struct Segment {
+            Segment() : literals(1), rest(false) {}
+
+            // Literal parts, one more than variables
+            std::vector<std::string> literals;
+
+            // Variable names
+            std::vector<std::string> variables;
+
+            // Variable matching the rest of the path, including slashes
+            bool rest;
+        };
+
+        // Indexed resource
+        struct Route {
+            const Resource* resource;
+            std::vector<std::string> variables;
+            std::vector<std::string> queryVariables;
+        };
+
+        // Segment pattern edge, e.g. `{id}.json`
+        struct PatternEdge {
+            std::vector<std::string> literals;
+            size_t node;
+        };
+
+        // Literal edge
+        typedef std::pair<std::string, size_t> LiteralEdge;
+
+        // Trie node
+        struct Node {
+            Node() : wildcard(NoNode) {}
+
+            std::vector<LiteralEdge> literals;  // sorted by segment
+            std::vector<PatternEdge> patterns;
+            size_t wildcard;
+            std::vector<size_t> routes;         // routes ending at this node
+            std::vector<size_t> restRoutes;     // routes capturing the rest of path at this node
+        };
+
+        static const size_t NoNode;
+
+        std::vector<Node> m_nodes;
+        std::vector<Route> m_routes;
+
+        // Split a URI template into path segments and query variable names
+        static void ParseTemplate(const CompiledURITemplate& uriTemplate,
+                                  std::vector<Segment>& segments,
+                                  std::vector<std::string>& queryVariables);
+
+        // Index of literal edges used while building, NULL when adding single resources
+        typedef std::map<std::pair<size_t, std::string>, size_t> LiteralIndex;
+
+        // Add resource using a literal edges index
+        void add(const Resource& resource, LiteralIndex* index);
+
+        // Find or create a child node
+        size_t literalChild(size_t node, const std::string& segment, LiteralIndex* index);
+        size_t patternChild(size_t node, const std::vector<std::string>& literals);
+        size_t wildcardChild(size_t node);
+
+        // Lookup state
+        struct Lookup {
+            const char* method;
+            size_t methodLength;
+            const char* path;
+            size_t pathLength;      // length of the path part, without query
+            size_t queryOffset;     // start of query string, pathLength if none
+            size_t queryLength;
+            bool requireMethod;     // match only routes having the method
+        };
+
+        // Depth first lookup of a path segment starting at position
+        bool lookup(size_t node, size_t position, const Lookup& state, RouteMatch& result) const;
+
+        // Pick a route of a node, name captured variables
+        bool resolve(const std::vector<size_t>& routes, const Lookup& state, RouteMatch& result) const;
+    };
+}
+
+#endif
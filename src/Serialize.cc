@@ -7,10 +7,14 @@
 //
 
 #include <string>
-#include <sstream>
 #include <algorithm>
 #include <iterator>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <new>
 #include "Serialize.h"
+#include "Thread.h"
 
 using namespace snowcrash;
 
@@ -32,11 +36,132 @@ const std::string SerializeKey::Object = "object";
 
 std::string snowcrash::EscapeNewlines(const std::string& input)
 {
-    std::ostringstream oss;
-    std::istringstream iss(input);
-    std::string line;
-    while (std::getline(iss, line))
-        oss << line << "\\n";
-    
-    return oss.str();
+    std::string output;
+    output.reserve(input.length() + 8);
+
+    for (std::string::const_iterator it = input.begin(); it != input.end(); ++it) {
+        if (*it == '\n')
+            output += "\\n";
+        else
+            output += *it;
+    }
+
+    // Every line is terminated, including the last one
+    if (!input.empty() && input[input.length() - 1] != '\n')
+        output += "\\n";
+
+    return output;
+}
+
+void snowcrash::EscapeNewlines(const std::string& input, OutputBuffer& output)
+{
+    const char* data = input.data();
+    const char* end = data + input.length();
+    while (data < end) {
+        const char* newline = static_cast<const char*>(::memchr(data, '\n', end - data));
+        if (!newline) {
+            output.append(data, end - data);
+            output.append("\\n");
+            return;
+        }
+
+        output.append(data, newline - data);
+        output.append("\\n");
+        data = newline + 1;
+    }
+}
+
+namespace {
+
+    // Serialization of one resource group
+    class SerializeResourceGroupTask : public Task {
+    public:
+        SerializeResourceGroupTask(const ResourceGroup& resourceGroup,
+                                   ResourceGroupSerializer serializer,
+                                   unsigned int options,
+                                   std::string& output)
+        : m_resourceGroup(resourceGroup), m_serializer(serializer), m_options(options), m_output(output),
+          m_failure(NoFailure) {}
+
+        // Tasks must not throw on a worker thread, a failure is kept
+        // to be rethrown on the calling thread, see rethrow()
+        virtual void run() {
+            try {
+                std::stringstream ss;
+                m_serializer(m_resourceGroup, ss, m_options);
+                m_output = ss.str();
+            }
+            catch (const std::bad_alloc&) {
+                m_failure = BadAllocFailure;
+            }
+            catch (const std::exception& e) {
+                m_failure = ExceptionFailure;
+                m_what = e.what();
+            }
+            catch (...) {
+                m_failure = ExceptionFailure;
+                m_what = "unknown exception serializing a resource group";
+            }
+        }
+
+        // Rethrow failure of run(), if any
+        void rethrow() const {
+            if (m_failure == BadAllocFailure)
+                throw std::bad_alloc();
+            if (m_failure == ExceptionFailure)
+                throw std::runtime_error(m_what);
+        }
+
+    private:
+        enum Failure {
+            NoFailure,
+            BadAllocFailure,
+            ExceptionFailure
+        };
+
+
+        const ResourceGroup& m_resourceGroup;
+        ResourceGroupSerializer m_serializer;
+        unsigned int m_options;
+        std::string& m_output;
+        Failure m_failure;
+        std::string m_what;
+    };
+}
+
+void snowcrash::SerializeResourceGroups(const Collection<ResourceGroup>::type& resourceGroups,
+                                        ResourceGroupSerializer serializer,
+                                        unsigned int options,
+                                        std::vector<std::string>& outputs)
+{
+    outputs.clear();
+    outputs.resize(resourceGroups.size());
+
+    if (resourceGroups.empty())
+        return;
+
+    std::vector<SerializeResourceGroupTask> tasks;
+    tasks.reserve(resourceGroups.size());
+    for (size_t i = 0; i < resourceGroups.size(); ++i)
+        tasks.push_back(SerializeResourceGroupTask(resourceGroups[i], serializer, options, outputs[i]));
+
+    // Starting threads costs more than serializing a single group
+    size_t threads = std::min(ThreadPool::HardwareConcurrency(), tasks.size());
+    if (threads > 1) {
+        std::vector<Task*> work;
+        work.reserve(tasks.size());
+        for (std::vector<SerializeResourceGroupTask>::iterator it = tasks.begin(); it != tasks.end(); ++it)
+            work.push_back(&*it);
+
+        ThreadPool pool(threads);
+        pool.run(work);
+    }
+    else {
+        for (std::vector<SerializeResourceGroupTask>::iterator it = tasks.begin(); it != tasks.end(); ++it)
+            it->run();
+    }
+
+    // Failures in the order of the groups
+    for (std::vector<SerializeResourceGroupTask>::const_iterator it = tasks.begin(); it != tasks.end(); ++it)
+        it->rethrow();
 }
@@ -10,10 +10,17 @@
 #define SNOWCRASH_SERIALIZE_H
 
 #include <string>
+#include <vector>
+#include <ostream>
+#include "Blueprint.h"
+#include "OutputBuffer.h"
 
 namespace snowcrash {
     
     std::string EscapeNewlines(const std::string& input);
+
+    // Single-pass variant of EscapeNewlines() appending into a buffer
+    void EscapeNewlines(const std::string& input, OutputBuffer& output);
     
     struct SerializeKey {
         static const std::string Metadata;
@@ -32,6 +39,36 @@ namespace snowcrash {
         static const std::string Headers;
         static const std::string Object;
     };
+
+    //
+    // Incremental serializer
+    //
+    // Blueprint is serialized one resource group at a time, the output is
+    // identical to serialization of the complete blueprint.
+    //
+    class StreamSerializer {
+    public:
+        virtual ~StreamSerializer() {}
+
+        // Serialize next resource group, the blueprint overview
+        // (metadata, name & description) is written with the first one
+        virtual void resourceGroup(const Blueprint& blueprint, const ResourceGroup& resourceGroup) = 0;
+
+        // Finish serialization, writes the overview if no group was written
+        virtual void end(const Blueprint& blueprint) = 0;
+    };
+
+    // Serializer of a single resource group, options are passed through
+    typedef void (*ResourceGroupSerializer)(const ResourceGroup& group, std::ostream& os, unsigned int options);
+
+    // Serialize resource groups on a thread pool, each group into its own output.
+    // Outputs are in the order of the groups. A single group is serialized on the
+    // calling thread. An exception of the serializer is rethrown on the calling
+    // thread, as std::bad_alloc or as std::runtime_error with its message.
+    void SerializeResourceGroups(const Collection<ResourceGroup>::type& resourceGroups,
+                                 ResourceGroupSerializer serializer,
+                                 unsigned int options,
+                                 std::vector<std::string>& outputs);
 }
 
 #endif
@@ -8,28 +8,122 @@
 
 #include "SerializeJSON.h"
 #include "Serialize.h"
+#include "AssetSource.h"
+#include "OutputBuffer.h"
 
 using namespace snowcrash;
 
-static const std::string IndentBlock = "  ";
-static const std::string NewLineItemBlock = ",\n";
+static const size_t IndentBlockSize = 2;
 
-/// \brief Serialize a JSON string.
+/// \brief JSON output, pretty-printed or compact.
+class JSONOutput {
+public:
+    JSONOutput(OutputBuffer& buffer, SerializeJSONOptions options)
+    : m_buffer(buffer), m_options(options), m_compact((options & CompactJSONOption) != 0) {}
+
+    /// \brief Serialization options.
+    SerializeJSONOptions options() const {
+        return m_options;
+    }
+
+    /// \brief Append raw data.
+    template <typename T>
+    void append(const T& data) {
+        m_buffer.append(data);
+    }
+
+    /// \brief Append raw data.
+    void append(const char* data, size_t length) {
+        m_buffer.append(data, length);
+    }
+
+    /// \brief Insert indentation.
+    /// \param level    Level of indentation
+    void indent(size_t level) {
+        if (!m_compact)
+            m_buffer.indent(level * IndentBlockSize);
+    }
+
+    /// \brief Insert new line.
+    void newLine() {
+        if (!m_compact)
+            m_buffer.append('\n');
+    }
+
+    /// \brief Open an object or array, followed by a new line.
+    void open(char bracket) {
+        m_buffer.append(bracket);
+        newLine();
+    }
+
+    /// \brief Separate items, each item on a new line.
+    void nextItem() {
+        m_buffer.append(',');
+        newLine();
+    }
+
+    /// \brief Separate a key from its value.
+    void keySeparator() {
+        if (m_compact)
+            m_buffer.append(':');
+        else
+            m_buffer.append(": ");
+    }
+
+private:
+    OutputBuffer& m_buffer;
+    SerializeJSONOptions m_options;
+    bool m_compact;
+};
+
+/// \brief Serialize a JSON string, escaping quotes, backslashes and control characters.
 /// \param value    JSON string to serialize
-/// \param os       An output stream to serialize into
-static void serialize(const std::string& value, std::ostream &os)
+/// \param os       An output to serialize into
+static void serialize(const std::string& value, JSONOutput &os)
 {
-    os << "\"" << value << "\"";
+    static const char HexDigits[] = "0123456789abcdef";
+
+    os.append('"');
+
+    const char* data = value.data();
+    const char* end = data + value.length();
+    const char* run = data;
+    for (; data < end; ++data) {
+        unsigned char c = static_cast<unsigned char>(*data);
+        if (c >= 0x20 && c != '"' && c != '\\')
+            continue;
+
+        os.append(run, data - run);
+        run = data + 1;
+
+        switch (c) {
+            case '"':  os.append("\\\""); break;
+            case '\\': os.append("\\\\"); break;
+            case '\n': os.append("\\n"); break;
+            case '\r': os.append("\\r"); break;
+            case '\t': os.append("\\t"); break;
+            case '\b': os.append("\\b"); break;
+            case '\f': os.append("\\f"); break;
+            default: {
+                char escape[] = "\\u00XX";
+                escape[4] = HexDigits[c >> 4];
+                escape[5] = HexDigits[c & 0xf];
+                os.append(escape, 6);
+            }
+        }
+    }
+
+    os.append(run, data - run);
+    os.append('"');
 }
 
-/// \brief Inserts indentation into an output stream.
-/// \brief level    Level of indentation
-/// \brief os       An output stream to serialize into
-static void indent(size_t level, std::ostream &os)
+/// \brief Serialize a key of an object.
+/// \param key      Key to serialize
+/// \param os       An output to serialize into
+static void serializeKey(const std::string& key, JSONOutput &os)
 {
-    for (size_t i = 0; i < level; ++i) {
-        os << IndentBlock;
-    }
+    serialize(key, os);
+    os.keySeparator();
 }
 
 /// \brief Serialize key value pair into output stream.
@@ -37,378 +131,433 @@ static void indent(size_t level, std::ostream &os)
 /// \param value    Value to serialize
 /// \param level    Indentation level
 /// \param object   Flag to indicate whether the pair should be serialized as an object
-/// \param os       An output stream to serialize into
-static void serialize(const std::string& key, const std::string& value, size_t level, bool object, std::ostream &os)
+/// \param os       An output to serialize into
+static void serialize(const std::string& key, const std::string& value, size_t level, bool object, JSONOutput &os)
 {
-    indent(level, os);
-    
+    os.indent(level);
+
     if (object) {
-        os << "{\n";
-        indent(level + 1, os);
+        os.open('{');
+        os.indent(level + 1);
     }
-    
-    serialize(key, os);
-    os << ": ";
-    
-    if (value.find("\n") != std::string::npos)
-        serialize(EscapeNewlines(value), os);
-    else
-        serialize(value, os);
-    
+
+    serializeKey(key, os);
+    serialize(value, os);
+
     if (object) {
-        os << "\n";
-        indent(level, os);
-        os << "}";
+        os.newLine();
+        os.indent(level);
+        os.append('}');
     }
 }
 
 /// \brief Serialize array of key value pairs.
 /// \param collection   Collection to serialize
 /// \param level        Level of indentation
-/// \param os           An output stream to serialize into
-static void serializeKeyValueCollection(const Collection<KeyValuePair>::type& collection, size_t level, std::ostream &os)
+/// \param os           An output to serialize into
+static void serializeKeyValueCollection(const Collection<KeyValuePair>::type& collection, size_t level, JSONOutput &os)
 {
-    os << "[\n";
+    os.open('[');
 
     size_t i = 0;
     for (Collection<KeyValuePair>::const_iterator it = collection.begin(); it != collection.end(); ++i, ++it) {
-        
+
         if (i > 0 && i < collection.size())
-            os << NewLineItemBlock;
-        
+            os.nextItem();
+
         serialize(it->first, it->second, level + 1, true, os);
     }
-    
+
     if (!collection.empty()) {
-        os << "\n";
-        indent(level, os);
+        os.newLine();
+        os.indent(level);
     }
 
-    os << "]";
+    os.append(']');
 }
 
 /// \brief Serialize Metadata into output stream.
 /// \brief metadata     Metadata to serialize
-/// \brief os           An output stream to serialize into
-static void serialize(const Collection<Metadata>::type& metadata, std::ostream &os)
+/// \brief os           An output to serialize into
+static void serialize(const Collection<Metadata>::type& metadata, JSONOutput &os)
 {
     if (metadata.empty())
         return;
-    
-    indent(1, os);
-    
-    serialize(SerializeKey::Metadata, os);
-    os << ": ";
-    
+
+    os.indent(1);
+    serializeKey(SerializeKey::Metadata, os);
     serializeKeyValueCollection(metadata, 1, os);
-    
-    os << NewLineItemBlock;
+    os.nextItem();
 }
 
 /// \brief Serialize HTTP headers into output stream.
 /// \param headers      Headers to serialize
 /// \param level        Level of indentation
-/// \brief os           An output stream to serialize into
-static void serialize(const Collection<Header>::type& headers, size_t level, std::ostream &os)
+/// \brief os           An output to serialize into
+static void serialize(const Collection<Header>::type& headers, size_t level, JSONOutput &os)
 {
-    indent(level, os);
-    serialize(SerializeKey::Headers, os);
-    os << ": ";
-    
+    os.indent(level);
+    serializeKey(SerializeKey::Headers, os);
     serializeKeyValueCollection(headers, level, os);
 }
 
 /// \brief Serialize a payload into output stream.
 /// \param payload      A payload to serialize
-/// \brief os           An output stream to serialize into
-static void serialize(const Payload& payload, size_t level, std::ostream &os)
+/// \brief os           An output to serialize into
+static void serialize(const Payload& payload, size_t level, JSONOutput &os)
 {
-//    indent(level, os);
-    os << "{\n";
-    
+    os.open('{');
+
     serialize(SerializeKey::Name, payload.name, level + 1, false, os);
-    os << NewLineItemBlock;
+    os.nextItem();
 
     serialize(SerializeKey::Description, payload.description, level + 1, false, os);
-    os << NewLineItemBlock;
-    
-    serialize(SerializeKey::Body, payload.body, level + 1, false, os);
-    os << NewLineItemBlock;
-    
-    serialize(SerializeKey::Schema, payload.schema, level + 1, false, os);
-    //os << NewLineItemBlock;
-    
+    os.nextItem();
+
+    Asset storage;
+    serialize(SerializeKey::Body, PayloadBody(payload, storage), level + 1, false, os);
+    os.nextItem();
+
+    serialize(SerializeKey::Schema, PayloadSchema(payload, storage), level + 1, false, os);
+
     if (!payload.headers.empty()) {
-        os << NewLineItemBlock;
+        os.nextItem();
         serialize(payload.headers, level + 1, os);
     }
-    
+
     // TODO: parameters
-    
-    os << "\n";
-    indent(level, os);
-    os << "}";
+
+    os.newLine();
+    os.indent(level);
+    os.append('}');
+}
+
+/// \brief Serialize a collection of payloads into output stream.
+/// \param key          Key of the collection
+/// \param payloads     Payloads to serialize
+/// \brief os           An output to serialize into
+static void serialize(const std::string& key, const Collection<Payload>::type& payloads, JSONOutput &os)
+{
+    os.indent(7);
+    serializeKey(key, os);
+    os.open('[');
+
+    size_t i = 0;
+    for (Collection<Payload>::const_iterator it = payloads.begin();
+         it != payloads.end();
+         ++i, ++it) {
+
+        if (i > 0 && i < payloads.size())
+            os.nextItem();
+
+        os.indent(8);
+        serialize(*it, 8, os);
+    }
+
+    os.newLine();
+    os.indent(7);
+    os.append(']');
 }
 
 /// \brief Serialize a method into output stream.
 /// \param method       A method to serialize
-/// \brief os           An output stream to serialize into
-static void serialize(const Method& method, std::ostream &os)
+/// \brief os           An output to serialize into
+static void serialize(const Method& method, JSONOutput &os)
 {
-    indent(6, os);
-    os << "{\n";
-    
+    os.indent(6);
+    os.open('{');
+
     serialize(SerializeKey::Method, method.method, 7, false, os);
-    os << NewLineItemBlock;
-    
+    os.nextItem();
+
     serialize(SerializeKey::Name, method.name, 7, false, os);
-    os << NewLineItemBlock;
-    
+    os.nextItem();
+
     serialize(SerializeKey::Description, method.description, 7, false, os);
-    
+
     // TODO: parameters
-    
+
     // Headers
     if (!method.headers.empty()) {
-        os << NewLineItemBlock;
+        os.nextItem();
         serialize(method.headers, 7, os);
     }
-    
+
     // Requests
     if (!method.requests.empty()) {
-        os << NewLineItemBlock;
-        indent(7, os);
-        serialize(SerializeKey::Requests, os);
-        os << ": ";
-        os << "[\n";
-        
-        size_t i = 0;
-        for (Collection<Request>::const_iterator it = method.requests.begin();
-             it != method.requests.end();
-             ++i, ++it) {
-            
-            if (i > 0 && i < method.requests.size())
-                os << NewLineItemBlock;
-            
-            indent(8, os);
-            serialize(*it, 8, os);
-        }
-        
-        os << "\n";
-        indent(7, os);
-        os << "]";
+        os.nextItem();
+        serialize(SerializeKey::Requests, method.requests, os);
     }
-    
+
     // Responses
     if (!method.responses.empty()) {
-        os << NewLineItemBlock;
-        indent(7, os);
-        serialize(SerializeKey::Responses, os);
-        os << ": ";
-        os << "[\n";
-        
-        size_t i = 0;
-        for (Collection<Response>::const_iterator it = method.responses.begin();
-             it != method.responses.end();
-             ++i, ++it) {
-            
-            if (i > 0 && i < method.responses.size())
-                os << NewLineItemBlock;
-            
-            indent(8, os);
-            serialize(*it, 8, os);
-        }
-        
-        os << "\n";
-        indent(7, os);
-        os << "]";
+        os.nextItem();
+        serialize(SerializeKey::Responses, method.responses, os);
     }
-    
+
     // Close the method
-    os << "\n";
-    indent(6, os);
-    os << "}";
+    os.newLine();
+    os.indent(6);
+    os.append('}');
 }
 
 /// \brief Serialize a resources into output stream.
 /// \param resource     A resource to serialize
-/// \brief os           An output stream to serialize into
-static void serialize(const Resource& resource, std::ostream &os)
+/// \brief os           An output to serialize into
+static void serialize(const Resource& resource, JSONOutput &os)
 {
-    indent(4, os);
-    os << "{\n";
+    os.indent(4);
+    os.open('{');
 
     // URI template
     serialize(SerializeKey::URITemplate, resource.uriTemplate, 5, false, os);
-    os << NewLineItemBlock;
-    
+    os.nextItem();
+
     // Name
     serialize(SerializeKey::Name, resource.name, 5, false, os);
-    os << NewLineItemBlock;
-    
+    os.nextItem();
+
     // Description
     serialize(SerializeKey::Description, resource.description, 5, false, os);
-    os << NewLineItemBlock;
-    
+    os.nextItem();
+
     // Object
-    indent(5, os);
-    serialize(SerializeKey::Object, os);
+    os.indent(5);
+    serializeKey(SerializeKey::Object, os);
     if (resource.object.name.empty()) {
-        os << ": {}";
+        os.append("{}");
     }
     else {
-        os << ": ";
-        
         serialize(resource.object, 6, os);
-        
-//        os << "\n";
-//        indent(5, os);
-//        os << "}";
     }
-    
+
     // Headers
     if (!resource.headers.empty()) {
-        os << NewLineItemBlock;
+        os.nextItem();
         serialize(resource.headers, 5, os);
     }
-    
+
     // Methods
     if (!resource.methods.empty()) {
-    
-        os << NewLineItemBlock;
-        indent(5, os);
-        serialize(SerializeKey::Methods, os);
-        os << ": ";
-        os << "[\n";
-        
+
+        os.nextItem();
+        os.indent(5);
+        serializeKey(SerializeKey::Methods, os);
+        os.open('[');
+
         size_t i = 0;
         for (Collection<Method>::const_iterator it = resource.methods.begin();
              it != resource.methods.end();
              ++i, ++it) {
-            
+
             if (i > 0 && i < resource.methods.size())
-                os << NewLineItemBlock;
-            
+                os.nextItem();
+
             serialize(*it, os);
         }
-        
-        os << "\n";
-        indent(5, os);    
-        os << "]";
+
+        os.newLine();
+        os.indent(5);
+        os.append(']');
     }
-    
+
     // Close the resource
-    os << "\n";
-    indent(4, os);
-    os << "}";    
+    os.newLine();
+    os.indent(4);
+    os.append('}');
 }
 
 /// \brief Serialize a group of resources into output stream.
 /// \param resourceGroup    A group to serialize
-/// \brief os               An output stream to serialize into
-static void serialize(const ResourceGroup& resourceGroup, std::ostream &os)
+/// \brief os               An output to serialize into
+static void serialize(const ResourceGroup& resourceGroup, JSONOutput &os)
 {
-    indent(2, os);
-    os << "{\n";
-    
+    os.indent(2);
+    os.open('{');
+
     // Name
     serialize(SerializeKey::Name, resourceGroup.name, 3, false, os);
-    os << NewLineItemBlock;
-    
+    os.nextItem();
+
     // Description
     serialize(SerializeKey::Description, resourceGroup.description, 3, false, os);
-    
+
     // Resources
     if (!resourceGroup.resources.empty()) {
 
-        os << NewLineItemBlock;
-        indent(3, os);
-        serialize(SerializeKey::Resources, os);
-        os << ": ";
-        os << "[\n";
-        
+        os.nextItem();
+        os.indent(3);
+        serializeKey(SerializeKey::Resources, os);
+        os.open('[');
+
         size_t i = 0;
         for (Collection<Resource>::const_iterator it = resourceGroup.resources.begin();
              it != resourceGroup.resources.end();
              ++i, ++it) {
-            
+
             if (i > 0 && i < resourceGroup.resources.size())
-                os << NewLineItemBlock;
-            
+                os.nextItem();
+
             serialize(*it, os);
         }
-        
-        if (!resourceGroup.resources.empty()) {
-            os << "\n";
-            indent(3, os);
-        }
-        
-        os << "]";
+
+        os.newLine();
+        os.indent(3);
+        os.append(']');
     }
-    
+
     // Close the group
-    os << "\n";
-    indent(2, os);
-    os << "}";
-    
+    os.newLine();
+    os.indent(2);
+    os.append('}');
+}
+
+/// \brief Serialize a group of resources into its own stream.
+/// \param resourceGroup    A group to serialize
+/// \param os               A stream to serialize into
+/// \param options          Serialization options
+static void serializeResourceGroup(const ResourceGroup& resourceGroup, std::ostream& os, unsigned int options)
+{
+    OutputBuffer buffer(os);
+    JSONOutput output(buffer, options);
+    serialize(resourceGroup, output);
+}
+
+/// \brief Open the collection of resource groups.
+/// \brief os               An output to serialize into
+static void serializeResourceGroupsBegin(JSONOutput &os)
+{
+    os.nextItem();
+    os.indent(1);
+    serializeKey(SerializeKey::ResourceGroups, os);
+    os.open('[');
+}
+
+/// \brief Close the collection of resource groups.
+/// \brief os               An output to serialize into
+static void serializeResourceGroupsEnd(JSONOutput &os)
+{
+    os.newLine();
+    os.indent(1);
+    os.append(']');
 }
 
 /// \brief Serialize Resource Group into output stream.
 /// \brief resourceGroup    Resource Groups to serialize
-/// \brief os               An output stream to serialize into
-static void serialize(const Collection<ResourceGroup>::type& resourceGroups, std::ostream &os)
+/// \brief os               An output to serialize into
+static void serialize(const Collection<ResourceGroup>::type& resourceGroups, JSONOutput &os)
 {
     if (resourceGroups.empty())
         return;
-    
-    indent(1, os);
-    serialize(SerializeKey::ResourceGroups, os);
-    os << ": ";
-    os << "[\n";
-    
-    size_t i = 0;
-    for (Collection<ResourceGroup>::const_iterator it = resourceGroups.begin(); it != resourceGroups.end(); ++i, ++it) {
-        
-        if (i > 0 && i < resourceGroups.size())
-            os << NewLineItemBlock;
-        
-        serialize(*it, os);
+
+    serializeResourceGroupsBegin(os);
+
+    if ((os.options() & ParallelJSONOption) && resourceGroups.size() > 1) {
+
+        // Groups are serialized independently, join them in order
+        std::vector<std::string> outputs;
+        SerializeResourceGroups(resourceGroups, serializeResourceGroup, os.options(), outputs);
+
+        for (size_t i = 0; i < outputs.size(); ++i) {
+            if (i > 0)
+                os.nextItem();
+
+            os.append(outputs[i]);
+        }
     }
-    
-    if (!resourceGroups.empty()) {
-        os << "\n";
-        indent(1, os);
+    else {
+        size_t i = 0;
+        for (Collection<ResourceGroup>::const_iterator it = resourceGroups.begin(); it != resourceGroups.end(); ++i, ++it) {
+
+            if (i > 0 && i < resourceGroups.size())
+                os.nextItem();
+
+            serialize(*it, os);
+        }
     }
-    
-    os << "]";
-    
+
+    serializeResourceGroupsEnd(os);
 }
 
-static void serialize(const Blueprint& blueprint, std::ostream &os)
+/// \brief Open the blueprint and serialize its overview.
+/// \brief blueprint        A blueprint to serialize
+/// \brief os               An output to serialize into
+static void serializeBlueprintBegin(const Blueprint& blueprint, JSONOutput &os)
 {
-    os << "{\n";
-    
+    os.open('{');
+
     // Metadata
     serialize(blueprint.metadata, os);
 
     // Name
     serialize(SerializeKey::Name, blueprint.name, 1, false, os);
-    os << NewLineItemBlock;
+    os.nextItem();
 
     // Description
     serialize(SerializeKey::Description, blueprint.description, 1, false, os);
+}
+
+/// \brief Close the blueprint.
+/// \brief os               An output to serialize into
+static void serializeBlueprintEnd(JSONOutput &os)
+{
+    os.newLine();
+    os.append('}');
+    os.newLine();
+}
+
+static void serialize(const Blueprint& blueprint, JSONOutput &os)
+{
+    serializeBlueprintBegin(blueprint, os);
 
     // Resource Groups
-    if (!blueprint.resourceGroups.empty()) {
-        os << NewLineItemBlock;
-        
-        serialize(blueprint.resourceGroups, os);
+    serialize(blueprint.resourceGroups, os);
+
+    serializeBlueprintEnd(os);
+}
+
+void snowcrash::SerializeJSON(const snowcrash::Blueprint& blueprint, std::ostream &os, SerializeJSONOptions options)
+{
+    OutputBuffer buffer(os);
+    JSONOutput output(buffer, options);
+    serialize(blueprint, output);
+    buffer.flush();
+    os.flush();
+}
+
+JSONStreamSerializer::JSONStreamSerializer(std::ostream &os, SerializeJSONOptions options)
+: m_os(os), m_buffer(os), m_options(options), m_resourceGroups(0)
+{
+}
+
+void JSONStreamSerializer::resourceGroup(const Blueprint& blueprint, const ResourceGroup& resourceGroup)
+{
+    JSONOutput output(m_buffer, m_options);
+    if (!m_resourceGroups) {
+        serializeBlueprintBegin(blueprint, output);
+        serializeResourceGroupsBegin(output);
+    }
+    else {
+        output.nextItem();
     }
-    
-    os << "\n}\n";
+
+    serialize(resourceGroup, output);
+    ++m_resourceGroups;
+
+    m_buffer.flush();
+    m_os.flush();
 }
 
-void snowcrash::SerializeJSON(const snowcrash::Blueprint& blueprint, std::ostream &os)
+void JSONStreamSerializer::end(const Blueprint& blueprint)
 {
-    serialize(blueprint, os);
+    JSONOutput output(m_buffer, m_options);
+    if (!m_resourceGroups)
+        serializeBlueprintBegin(blueprint, output);
+    else
+        serializeResourceGroupsEnd(output);
+
+    serializeBlueprintEnd(output);
+
+    m_buffer.flush();
+    m_os.flush();
 }
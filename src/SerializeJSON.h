@@ -11,11 +11,39 @@
 
 #include <ostream>
 #include "Blueprint.h"
+#include "Serialize.h"
+#include "OutputBuffer.h"
 
 namespace snowcrash {
 
+    //
+    // JSON Serialization Options
+    //
+    enum SerializeJSONOption {
+        CompactJSONOption = (1 << 0),   // Minified output, no indentation or new lines
+        ParallelJSONOption = (1 << 1)   // Serialize resource groups in parallel
+    };
+    typedef unsigned int SerializeJSONOptions;
+
     // Naive JSON serialization to ostream
-    void SerializeJSON(const snowcrash::Blueprint& blueprint, std::ostream &os);
+    void SerializeJSON(const snowcrash::Blueprint& blueprint, std::ostream &os, SerializeJSONOptions options = 0);
+
+    //
+    // Incremental JSON serialization to ostream, see StreamSerializer
+    //
+    class JSONStreamSerializer : public StreamSerializer {
+    public:
+        JSONStreamSerializer(std::ostream &os, SerializeJSONOptions options = 0);
+
+        virtual void resourceGroup(const Blueprint& blueprint, const ResourceGroup& resourceGroup);
+        virtual void end(const Blueprint& blueprint);
+
+    private:
+        std::ostream& m_os;
+        OutputBuffer m_buffer;
+        SerializeJSONOptions m_options;
+        size_t m_resourceGroups;
+    };
 }
 
 #endif 
@@ -0,0 +1,265 @@
+//
+//  SerializeMsgPack.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include "SerializeMsgPack.h"
+#include "Serialize.h"
+#include "AssetSource.h"
+#include "OutputBuffer.h"
+
+using namespace snowcrash;
+
+// MessagePack format bytes
+static const unsigned char FixMapFormat = 0x80;
+static const unsigned char FixArrayFormat = 0x90;
+static const unsigned char FixStrFormat = 0xa0;
+static const unsigned char Str8Format = 0xd9;
+static const unsigned char Str16Format = 0xda;
+static const unsigned char Str32Format = 0xdb;
+static const unsigned char Array16Format = 0xdc;
+static const unsigned char Array32Format = 0xdd;
+static const unsigned char Map16Format = 0xde;
+static const unsigned char Map32Format = 0xdf;
+
+/// \brief Write a format byte followed by a big-endian length.
+/// \param format   Format byte
+/// \param length   Length to write
+/// \param bytes    Size of the length in bytes, 1, 2 or 4
+/// \param out      Output buffer to write into
+static void writeHeader(unsigned char format, size_t length, size_t bytes, OutputBuffer& out)
+{
+    char header[5];
+    header[0] = static_cast<char>(format);
+    for (size_t i = 0; i < bytes; ++i)
+        header[bytes - i] = static_cast<char>((length >> (i * 8)) & 0xff);
+
+    out.append(header, bytes + 1);
+}
+
+/// \brief Write header of an array or map.
+/// \param fixFormat    Format byte of the fix variant
+/// \param format16     Format byte of the 16-bit variant
+/// \param format32     Format byte of the 32-bit variant
+/// \param size         Number of elements
+/// \param out          Output buffer to write into
+static void writeContainer(unsigned char fixFormat, unsigned char format16, unsigned char format32, size_t size, OutputBuffer& out)
+{
+    if (size < 16)
+        out.append(static_cast<char>(fixFormat | size));
+    else if (size <= 0xffff)
+        writeHeader(format16, size, 2, out);
+    else
+        writeHeader(format32, size, 4, out);
+}
+
+/// \brief Serialize a map header.
+static void serializeMap(size_t size, OutputBuffer& out)
+{
+    writeContainer(FixMapFormat, Map16Format, Map32Format, size, out);
+}
+
+/// \brief Serialize an array header.
+static void serializeArray(size_t size, OutputBuffer& out)
+{
+    writeContainer(FixArrayFormat, Array16Format, Array32Format, size, out);
+}
+
+/// \brief Serialize a string.
+/// \param value    String to serialize
+/// \param out      Output buffer to write into
+static void serialize(const std::string& value, OutputBuffer& out)
+{
+    size_t length = value.length();
+    if (length < 32)
+        out.append(static_cast<char>(FixStrFormat | length));
+    else if (length <= 0xff)
+        writeHeader(Str8Format, length, 1, out);
+    else if (length <= 0xffff)
+        writeHeader(Str16Format, length, 2, out);
+    else
+        writeHeader(Str32Format, length, 4, out);
+
+    out.append(value);
+}
+
+/// \brief Serialize key value pair.
+/// \param key      Key to serialize
+/// \param value    Value to serialize
+/// \param out      Output buffer to write into
+static void serialize(const std::string& key, const std::string& value, OutputBuffer& out)
+{
+    serialize(key, out);
+    serialize(value, out);
+}
+
+/// \brief Serialize array of key value pairs, each pair as a single-entry map.
+/// \param key          Key of the collection
+/// \param collection   Collection to serialize
+/// \param out          Output buffer to write into
+static void serialize(const std::string& key, const Collection<KeyValuePair>::type& collection, OutputBuffer& out)
+{
+    serialize(key, out);
+    serializeArray(collection.size(), out);
+
+    for (Collection<KeyValuePair>::const_iterator it = collection.begin(); it != collection.end(); ++it) {
+        serializeMap(1, out);
+        serialize(it->first, it->second, out);
+    }
+}
+
+/// \brief Serialize a payload.
+/// \param payload  A payload to serialize
+/// \param out      Output buffer to write into
+static void serialize(const Payload& payload, OutputBuffer& out)
+{
+    serializeMap(payload.headers.empty() ? 4 : 5, out);
+
+    serialize(SerializeKey::Name, payload.name, out);
+    serialize(SerializeKey::Description, payload.description, out);
+    Asset storage;
+    serialize(SerializeKey::Body, PayloadBody(payload, storage), out);
+    serialize(SerializeKey::Schema, PayloadSchema(payload, storage), out);
+
+    if (!payload.headers.empty())
+        serialize(SerializeKey::Headers, payload.headers, out);
+
+    // TODO: parameters
+}
+
+/// \brief Serialize a collection of payloads.
+/// \param key          Key of the collection
+/// \param payloads     Payloads to serialize
+/// \param out          Output buffer to write into
+static void serialize(const std::string& key, const Collection<Payload>::type& payloads, OutputBuffer& out)
+{
+    serialize(key, out);
+    serializeArray(payloads.size(), out);
+
+    for (Collection<Payload>::const_iterator it = payloads.begin(); it != payloads.end(); ++it)
+        serialize(*it, out);
+}
+
+/// \brief Serialize a method.
+/// \param method   A method to serialize
+/// \param out      Output buffer to write into
+static void serialize(const Method& method, OutputBuffer& out)
+{
+    size_t size = 3;
+    if (!method.headers.empty())
+        ++size;
+    if (!method.requests.empty())
+        ++size;
+    if (!method.responses.empty())
+        ++size;
+
+    serializeMap(size, out);
+
+    serialize(SerializeKey::Method, method.method, out);
+    serialize(SerializeKey::Name, method.name, out);
+    serialize(SerializeKey::Description, method.description, out);
+
+    // TODO: parameters
+
+    if (!method.headers.empty())
+        serialize(SerializeKey::Headers, method.headers, out);
+
+    if (!method.requests.empty())
+        serialize(SerializeKey::Requests, method.requests, out);
+
+    if (!method.responses.empty())
+        serialize(SerializeKey::Responses, method.responses, out);
+}
+
+/// \brief Serialize a resource.
+/// \param resource     A resource to serialize
+/// \param out          Output buffer to write into
+static void serialize(const Resource& resource, OutputBuffer& out)
+{
+    size_t size = 4;
+    if (!resource.headers.empty())
+        ++size;
+    if (!resource.methods.empty())
+        ++size;
+
+    serializeMap(size, out);
+
+    serialize(SerializeKey::URITemplate, resource.uriTemplate, out);
+    serialize(SerializeKey::Name, resource.name, out);
+    serialize(SerializeKey::Description, resource.description, out);
+
+    // Object, empty map if there is none
+    serialize(SerializeKey::Object, out);
+    if (resource.object.name.empty())
+        serializeMap(0, out);
+    else
+        serialize(resource.object, out);
+
+    if (!resource.headers.empty())
+        serialize(SerializeKey::Headers, resource.headers, out);
+
+    if (!resource.methods.empty()) {
+        serialize(SerializeKey::Methods, out);
+        serializeArray(resource.methods.size(), out);
+
+        for (Collection<Method>::const_iterator it = resource.methods.begin(); it != resource.methods.end(); ++it)
+            serialize(*it, out);
+    }
+}
+
+/// \brief Serialize a group of resources.
+/// \param resourceGroup    A group to serialize
+/// \param out              Output buffer to write into
+static void serialize(const ResourceGroup& resourceGroup, OutputBuffer& out)
+{
+    serializeMap(resourceGroup.resources.empty() ? 2 : 3, out);
+
+    serialize(SerializeKey::Name, resourceGroup.name, out);
+    serialize(SerializeKey::Description, resourceGroup.description, out);
+
+    if (!resourceGroup.resources.empty()) {
+        serialize(SerializeKey::Resources, out);
+        serializeArray(resourceGroup.resources.size(), out);
+
+        for (Collection<Resource>::const_iterator it = resourceGroup.resources.begin(); it != resourceGroup.resources.end(); ++it)
+            serialize(*it, out);
+    }
+}
+
+/// \brief Serialize a blueprint.
+/// \param blueprint    A blueprint to serialize
+/// \param out          Output buffer to write into
+static void serialize(const Blueprint& blueprint, OutputBuffer& out)
+{
+    size_t size = 2;
+    if (!blueprint.metadata.empty())
+        ++size;
+    if (!blueprint.resourceGroups.empty())
+        ++size;
+
+    serializeMap(size, out);
+
+    if (!blueprint.metadata.empty())
+        serialize(SerializeKey::Metadata, blueprint.metadata, out);
+
+    serialize(SerializeKey::Name, blueprint.name, out);
+    serialize(SerializeKey::Description, blueprint.description, out);
+
+    if (!blueprint.resourceGroups.empty()) {
+        serialize(SerializeKey::ResourceGroups, out);
+        serializeArray(blueprint.resourceGroups.size(), out);
+
+        for (Collection<ResourceGroup>::const_iterator it = blueprint.resourceGroups.begin(); it != blueprint.resourceGroups.end(); ++it)
+            serialize(*it, out);
+    }
+}
+
+void snowcrash::SerializeMsgPack(const snowcrash::Blueprint& blueprint, std::ostream &os)
+{
+    OutputBuffer buffer(os);
+    serialize(blueprint, buffer);
+    buffer.flush();
+    os.flush();
+}
@@ -0,0 +1,24 @@
+//
+//  SerializeMsgPack.h
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#ifndef SNOWCRASH_SERIALIZE_MSGPACK_H
+#define SNOWCRASH_SERIALIZE_MSGPACK_H
+
+#include <ostream>
+#include "Blueprint.h"
+
+namespace snowcrash {
+
+    // MessagePack serialization to ostream.
+    //
+    // Follows the structure of JSON serialization (SerializeJSON.h) with
+    // the same keys (Serialize.h). Strings are written as-is with their length
+    // prefix (str 8/16/32 format), no escaping is performed.
+    void SerializeMsgPack(const snowcrash::Blueprint& blueprint, std::ostream &os);
+}
+
+#endif
@@ -0,0 +1,185 @@
+//
+//  SerializeSnapshot.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <map>
+#include <limits>
+#include <cstring>
+#include "SerializeSnapshot.h"
+#include "Snapshot.h"
+#include "AssetSource.h"
+
+using namespace snowcrash;
+
+namespace {
+
+    // Longest string to be looked up for duplicates
+    const size_t MaxSharedStringLength = 64;
+
+    //
+    // Snapshot builder, lays out records bottom-up so every array
+    // is written as a contiguous block after its nested arrays.
+    //
+    class SnapshotWriter {
+    public:
+        SnapshotWriter()
+        : m_overflow(false) {
+
+            // Reserve header space, the header is filled in when done
+            m_records.resize(sizeof(SnapshotHeader));
+
+            // Shared empty string at offset 0
+            m_strings.push_back('\0');
+            m_stringOffsets[std::string()] = 0;
+        }
+
+        // Write the snapshot into an output stream
+        void write(const Blueprint& blueprint, std::ostream& os) {
+
+            SnapshotBlueprint root;
+            add(blueprint, root);
+
+            if (m_overflow ||
+                m_records.size() + m_strings.size() > std::numeric_limits<uint32_t>::max()) {
+                os.setstate(std::ios::failbit);
+                return;
+            }
+
+            SnapshotHeader header;
+            ::memcpy(header.magic, SnapshotMagic, sizeof(SnapshotMagic));
+            header.version = SnapshotVersion;
+            header.byteOrder = SnapshotByteOrder;
+            header.strings = static_cast<uint32_t>(m_records.size());
+            header.stringsLength = static_cast<uint32_t>(m_strings.size());
+            header.size = header.strings + header.stringsLength;
+            header.blueprint = root;
+            ::memcpy(&m_records[0], &header, sizeof(SnapshotHeader));
+
+            os.write(&m_records[0], m_records.size());
+            os.write(&m_strings[0], m_strings.size());
+        }
+
+    private:
+        std::vector<char> m_records;
+        std::vector<char> m_strings;
+        std::map<std::string, uint32_t> m_stringOffsets;
+        bool m_overflow;
+
+        // Add string into the pool, identical short strings
+        // (names, keys, media types) are stored once
+        SnapshotString add(const std::string& string) {
+
+            SnapshotString result;
+            result.length = checked(string.length());
+
+            bool shared = (string.length() <= MaxSharedStringLength);
+            if (shared) {
+                std::map<std::string, uint32_t>::const_iterator it = m_stringOffsets.find(string);
+                if (it != m_stringOffsets.end()) {
+                    result.offset = it->second;
+                    return result;
+                }
+            }
+
+            result.offset = checked(m_strings.size());
+            m_strings.insert(m_strings.end(), string.begin(), string.end());
+            m_strings.push_back('\0');
+
+            if (shared)
+                m_stringOffsets[string] = result.offset;
+
+            return result;
+        }
+
+        // Add records of a collection as one contiguous array
+        template <class R, class T>
+        SnapshotArray add(const std::vector<T>& collection) {
+
+            SnapshotArray result;
+            result.offset = 0;
+            result.count = checked(collection.size());
+            if (collection.empty())
+                return result;
+
+            std::vector<R> records(collection.size());
+            for (size_t i = 0; i < collection.size(); ++i)
+                add(collection[i], records[i]);
+
+            result.offset = checked(m_records.size());
+            const char* begin = reinterpret_cast<const char*>(&records[0]);
+            m_records.insert(m_records.end(), begin, begin + sizeof(R) * records.size());
+            return result;
+        }
+
+        void add(const KeyValuePair& in, SnapshotKeyValue& out) {
+            out.key = add(in.first);
+            out.value = add(in.second);
+        }
+
+        void add(const Parameter& in, SnapshotParameter& out) {
+            out.name = add(in.name);
+            out.description = add(in.description);
+        }
+
+        void add(const Payload& in, SnapshotPayload& out) {
+            out.name = add(in.name);
+            out.description = add(in.description);
+            out.parameters = add<SnapshotParameter>(in.parameters);
+            out.headers = add<SnapshotKeyValue>(in.headers);
+            Asset storage;
+            out.body = add(PayloadBody(in, storage));
+            out.schema = add(PayloadSchema(in, storage));
+        }
+
+        void add(const Method& in, SnapshotMethod& out) {
+            out.method = add(in.method);
+            out.name = add(in.name);
+            out.description = add(in.description);
+            out.parameters = add<SnapshotParameter>(in.parameters);
+            out.headers = add<SnapshotKeyValue>(in.headers);
+            out.requests = add<SnapshotPayload>(in.requests);
+            out.responses = add<SnapshotPayload>(in.responses);
+        }
+
+        void add(const Resource& in, SnapshotResource& out) {
+            out.uriTemplate = add(in.uriTemplate);
+            out.name = add(in.name);
+            out.description = add(in.description);
+            add(in.object, out.object);
+            out.parameters = add<SnapshotParameter>(in.parameters);
+            out.headers = add<SnapshotKeyValue>(in.headers);
+            out.methods = add<SnapshotMethod>(in.methods);
+        }
+
+        void add(const ResourceGroup& in, SnapshotResourceGroup& out) {
+            out.name = add(in.name);
+            out.description = add(in.description);
+            out.resources = add<SnapshotResource>(in.resources);
+        }
+
+        void add(const Blueprint& in, SnapshotBlueprint& out) {
+            out.metadata = add<SnapshotKeyValue>(in.metadata);
+            out.name = add(in.name);
+            out.description = add(in.description);
+            out.resourceGroups = add<SnapshotResourceGroup>(in.resourceGroups);
+        }
+
+        // Narrow a size to the 32-bit snapshot field, flags overflow
+        uint32_t checked(size_t value) {
+            if (value > std::numeric_limits<uint32_t>::max()) {
+                m_overflow = true;
+                return 0;
+            }
+            return static_cast<uint32_t>(value);
+        }
+    };
+}
+
+void snowcrash::SerializeSnapshot(const snowcrash::Blueprint& blueprint, std::ostream &os)
+{
+    SnapshotWriter writer;
+    writer.write(blueprint, os);
+}
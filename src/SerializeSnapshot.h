@@ -0,0 +1,21 @@
+//
+//  SerializeSnapshot.h
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#ifndef SNOWCRASH_SERIALIZE_SNAPSHOT_H
+#define SNOWCRASH_SERIALIZE_SNAPSHOT_H
+
+#include <ostream>
+#include "Blueprint.h"
+
+namespace snowcrash {
+
+    // Binary snapshot serialization to ostream, see Snapshot.h for the format.
+    // Sets failbit of the stream if the AST does not fit the format.
+    void SerializeSnapshot(const snowcrash::Blueprint& blueprint, std::ostream &os);
+}
+
+#endif
@@ -7,182 +7,243 @@
 //
 
 #include "Serialize.h"
+#include "AssetSource.h"
 #include "SerializeYAML.h"
+#include "OutputBuffer.h"
 
 using namespace snowcrash;
 
 // Serialize key: value, escaping strings with new lines
-static void serialize(const std::string& key, const std::string& value, size_t level, std::ostream &os)
+static void serialize(const std::string& key, const std::string& value, size_t level, OutputBuffer &out)
 {
     if (key.empty())
         return;
     
-    for (size_t i = 0; i < level; ++i)
-        os << "  ";
+    out.indent(level * 2);
+    out.append(key);
     
     if (!value.empty()) {
         
-        os << key << ": ";
+        out.append(": ");
 
-        if (value.find("\n") != std::string::npos)
-            os << "\"" << EscapeNewlines(value) << "\"";
-        else
-            os << value;
+        if (value.find('\n') != std::string::npos) {
+            out.append('"');
+            EscapeNewlines(value, out);
+            out.append('"');
+        }
+        else {
+            out.append(value);
+        }
         
-         os << std::endl;
+        out.append('\n');
     }
     else
-        os << key << ":\n";
+        out.append(":\n");
 }
 
-static void serializeKeyValueCollection(const Collection<KeyValuePair>::type& collection, size_t level, std::ostream &os)
+static void serializeKeyValueCollection(const Collection<KeyValuePair>::type& collection, size_t level, OutputBuffer &out)
 {
     for (Collection<KeyValuePair>::const_iterator it = collection.begin(); it != collection.end(); ++it) {
         
         if (it == collection.begin()) {
             
-            for (size_t i = 0; i < level; ++i)
-                os << "  ";
-            os << "- ";
+            out.indent(level * 2);
+            out.append("- ");
             
-            serialize(it->first, it->second, 0, os);
+            serialize(it->first, it->second, 0, out);
         }
         else {
-            serialize(it->first, it->second, level + 1, os);
+            serialize(it->first, it->second, level + 1, out);
         }
     }
 }
 
-static void serialize(const Collection<Metadata>::type& metadata, std::ostream &os)
+static void serialize(const Collection<Metadata>::type& metadata, OutputBuffer &out)
 {
     if (metadata.empty())
         return;
     
-    serialize(SerializeKey::Metadata, std::string(), 0, os);
-    serializeKeyValueCollection(metadata, 0, os);
+    serialize(SerializeKey::Metadata, std::string(), 0, out);
+    serializeKeyValueCollection(metadata, 0, out);
 }
 
-static void serialize(const Collection<Header>::type& headers, size_t level, std::ostream &os)
+static void serialize(const Collection<Header>::type& headers, size_t level, OutputBuffer &out)
 {
-    serialize(SerializeKey::Headers, std::string(), level, os);
-    serializeKeyValueCollection(headers, level, os);
+    serialize(SerializeKey::Headers, std::string(), level, out);
+    serializeKeyValueCollection(headers, level, out);
 }
 
-static void serialize(const Payload& payload, size_t level, bool array, std::ostream &os)
+static void serialize(const Payload& payload, size_t level, bool array, OutputBuffer &out)
 {
-    for (size_t i = 0; i < level - 1; i++) {
-        os << "  ";
-    }
+    out.indent((level - 1) * 2);
     
     if (array)
-        os << "- ";
+        out.append("- ");
     else
-        os << "  ";
+        out.append("  ");
     
-    serialize(SerializeKey::Name, payload.name, 0, os);
+    serialize(SerializeKey::Name, payload.name, 0, out);
     
-    serialize(SerializeKey::Description, payload.description, level, os);
-    serialize(SerializeKey::Body, payload.body, level, os);
-    serialize(SerializeKey::Schema, payload.schema, level, os);
+    serialize(SerializeKey::Description, payload.description, level, out);
+    Asset storage;
+    serialize(SerializeKey::Body, PayloadBody(payload, storage), level, out);
+    serialize(SerializeKey::Schema, PayloadSchema(payload, storage), level, out);
     
     if (!payload.headers.empty()) {
-        serialize(payload.headers, level, os);
+        serialize(payload.headers, level, out);
     }
     
     // TODO: parameters
 }
 
 // Serialize Method
-static void serialize(const Method& method, std::ostream &os)
+static void serialize(const Method& method, OutputBuffer &out)
 {
-    os << "    - ";   // indent 3
-    serialize(SerializeKey::Method, method.method, 0, os);
-    serialize(SerializeKey::Name, method.name, 3, os);
-    serialize(SerializeKey::Description, method.description, 3, os);
+    out.append("    - ");   // indent 3
+    serialize(SerializeKey::Method, method.method, 0, out);
+    serialize(SerializeKey::Name, method.name, 3, out);
+    serialize(SerializeKey::Description, method.description, 3, out);
     
     // TODO: parameters
     
     if (!method.headers.empty()) {
-        serialize(method.headers, 3, os);
+        serialize(method.headers, 3, out);
     }
     
     if (!method.requests.empty()) {
-        serialize(SerializeKey::Requests, std::string(), 3, os);
+        serialize(SerializeKey::Requests, std::string(), 3, out);
         for (Collection<Request>::const_iterator it = method.requests.begin(); it != method.requests.end(); ++it) {
-            serialize(*it, 4, true, os);
+            serialize(*it, 4, true, out);
         }
     }
 
     if (!method.responses.empty()) {
-        serialize(SerializeKey::Responses, std::string(), 3, os);
+        serialize(SerializeKey::Responses, std::string(), 3, out);
         for (Collection<Response>::const_iterator it = method.responses.begin(); it != method.responses.end(); ++it) {
-            serialize(*it, 4, true, os);
+            serialize(*it, 4, true, out);
         }
     }
 }
 
 // Serialize Resource
-static void serialize(const Resource& resource, std::ostream &os)
+static void serialize(const Resource& resource, OutputBuffer &out)
 {
-    os << "  - ";   // indent 2
-    serialize(SerializeKey::URITemplate, resource.uriTemplate, 0, os);
-    serialize(SerializeKey::Name, resource.name, 2, os);
-    serialize(SerializeKey::Description, resource.description, 2, os);
+    out.append("  - ");   // indent 2
+    serialize(SerializeKey::URITemplate, resource.uriTemplate, 0, out);
+    serialize(SerializeKey::Name, resource.name, 2, out);
+    serialize(SerializeKey::Description, resource.description, 2, out);
 
     // TODO: parameters
 
-    serialize(SerializeKey::Object, std::string(), 2, os);
+    serialize(SerializeKey::Object, std::string(), 2, out);
     if (!resource.object.name.empty())
-        serialize(resource.object, 3, false, os);
+        serialize(resource.object, 3, false, out);
     
     if (!resource.headers.empty())
-        serialize(resource.headers, 2, os);
+        serialize(resource.headers, 2, out);
 
     if (resource.methods.empty())
         return;
     
-    serialize(SerializeKey::Methods, std::string(), 2, os);
+    serialize(SerializeKey::Methods, std::string(), 2, out);
     for (Collection<Method>::const_iterator it = resource.methods.begin(); it != resource.methods.end(); ++it) {
-        serialize(*it, os);
+        serialize(*it, out);
     }
 }
 
 // Serialize Resource Group
-static void serialize(const ResourceGroup& group, std::ostream &os)
+static void serialize(const ResourceGroup& group, OutputBuffer &out)
 {
-    os << "- ";   // indent 1
-    serialize(SerializeKey::Name, group.name, 0, os);
-    serialize(SerializeKey::Description, group.description, 1, os);
+    out.append("- ");   // indent 1
+    serialize(SerializeKey::Name, group.name, 0, out);
+    serialize(SerializeKey::Description, group.description, 1, out);
 
     if (group.resources.empty())
         return;
     
-    serialize(SerializeKey::Resources, std::string(), 1, os);
+    serialize(SerializeKey::Resources, std::string(), 1, out);
     for (Collection<Resource>::const_iterator it = group.resources.begin(); it != group.resources.end(); ++it) {
-        serialize(*it, os);
+        serialize(*it, out);
     }
 }
 
+// Serialize Resource Group into its own stream
+static void serializeResourceGroup(const ResourceGroup& group, std::ostream& os, unsigned int options)
+{
+    OutputBuffer buffer(os);
+    serialize(group, buffer);
+}
+
+// Serialize Blueprint overview
+static void serializeOverview(const Blueprint& blueprint, OutputBuffer &out)
+{
+    serialize(blueprint.metadata, out);
+    serialize(SerializeKey::Name, blueprint.name, 0, out);
+    serialize(SerializeKey::Description, blueprint.description, 0, out);
+}
+
 // Serialize Blueprint
-static void serialize(const Blueprint& blueprint, std::ostream &os)
+static void serialize(const Blueprint& blueprint, SerializeYAMLOptions options, OutputBuffer &out)
 {
-    serialize(blueprint.metadata, os);
-    serialize(SerializeKey::Name, blueprint.name, 0, os);
-    serialize(SerializeKey::Description, blueprint.description, 0, os);
+    serializeOverview(blueprint, out);
     
     if (blueprint.resourceGroups.empty())
         return;
     
-    serialize(SerializeKey::ResourceGroups, std::string(), 0, os);
+    serialize(SerializeKey::ResourceGroups, std::string(), 0, out);
+
+    if ((options & ParallelYAMLOption) && blueprint.resourceGroups.size() > 1) {
+
+        // Groups are serialized independently, join them in order
+        std::vector<std::string> outputs;
+        SerializeResourceGroups(blueprint.resourceGroups, serializeResourceGroup, options, outputs);
+
+        for (std::vector<std::string>::const_iterator it = outputs.begin(); it != outputs.end(); ++it)
+            out.append(*it);
+
+        return;
+    }
+
     for (Collection<ResourceGroup>::type::const_iterator it = blueprint.resourceGroups.begin();
          it != blueprint.resourceGroups.end();
          ++it) {
         
-        serialize(*it, os);
+        serialize(*it, out);
     }
 }
 
-void snowcrash::SerializeYAML(const snowcrash::Blueprint& blueprint, std::ostream &os)
+void snowcrash::SerializeYAML(const snowcrash::Blueprint& blueprint, std::ostream &os, SerializeYAMLOptions options)
+{
+    OutputBuffer buffer(os);
+    serialize(blueprint, options, buffer);
+    buffer.flush();
+    os.flush();
+}
+
+YAMLStreamSerializer::YAMLStreamSerializer(std::ostream &os)
+: m_os(os), m_buffer(os), m_resourceGroups(0)
+{
+}
+
+void YAMLStreamSerializer::resourceGroup(const Blueprint& blueprint, const ResourceGroup& resourceGroup)
 {
-    serialize(blueprint, os);
+    if (!m_resourceGroups) {
+        serializeOverview(blueprint, m_buffer);
+        serialize(SerializeKey::ResourceGroups, std::string(), 0, m_buffer);
+    }
+
+    serialize(resourceGroup, m_buffer);
+    ++m_resourceGroups;
+
+    m_buffer.flush();
+    m_os.flush();
+}
+
+void YAMLStreamSerializer::end(const Blueprint& blueprint)
+{
+    if (!m_resourceGroups)
+        serializeOverview(blueprint, m_buffer);
+
+    m_buffer.flush();
+    m_os.flush();
 }
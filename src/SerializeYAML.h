@@ -11,11 +11,37 @@
 
 #include <ostream>
 #include "Blueprint.h"
+#include "Serialize.h"
+#include "OutputBuffer.h"
 
 namespace snowcrash {
     
+    //
+    // YAML Serialization Options
+    //
+    enum SerializeYAMLOption {
+        ParallelYAMLOption = (1 << 0)   // Serialize resource groups in parallel
+    };
+    typedef unsigned int SerializeYAMLOptions;
+
     // Naive YAML serialization to ostream
-    void SerializeYAML(const snowcrash::Blueprint& blueprint, std::ostream &os);
+    void SerializeYAML(const snowcrash::Blueprint& blueprint, std::ostream &os, SerializeYAMLOptions options = 0);
+
+    //
+    // Incremental YAML serialization to ostream, see StreamSerializer
+    //
+    class YAMLStreamSerializer : public StreamSerializer {
+    public:
+        explicit YAMLStreamSerializer(std::ostream &os);
+
+        virtual void resourceGroup(const Blueprint& blueprint, const ResourceGroup& resourceGroup);
+        virtual void end(const Blueprint& blueprint);
+
+    private:
+        std::ostream& m_os;
+        OutputBuffer m_buffer;
+        size_t m_resourceGroups;
+    };
 }
 
 #endif
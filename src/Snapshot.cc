@@ -0,0 +1,269 @@
+//
+//  Snapshot.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <cstring>
+#include "Snapshot.h"
+#include "URITemplate.h"
+
+using namespace snowcrash;
+
+const char snowcrash::SnapshotMagic[8] = { 'S', 'N', 'O', 'W', 'C', 'R', 'S', 'H' };
+const uint32_t snowcrash::SnapshotVersion = 1;
+const uint32_t snowcrash::SnapshotByteOrder = 0x01020304;
+
+//
+// Snapshot structure checks
+//
+namespace {
+
+    struct SnapshotValidator {
+
+        SnapshotValidator(const char* d, const SnapshotHeader& h)
+        : data(d), header(h), remaining(h.strings - sizeof(SnapshotHeader)) {}
+
+        const char* data;
+        const SnapshotHeader& header;
+
+        // Size of records left to check. Records of a well-formed snapshot
+        // are not shared, checking more than the record region would mean
+        // overlapping arrays and work not bounded by the snapshot size.
+        mutable size_t remaining;
+
+        bool check(const SnapshotString& string) const {
+            if (string.offset >= header.stringsLength ||
+                string.length >= header.stringsLength - string.offset)
+                return false;
+
+            // Strings must be terminated in place
+            return data[header.strings + string.offset + string.length] == '\0';
+        }
+
+        template <class T>
+        bool check(const SnapshotArray& array) const {
+            if (array.count == 0)
+                return true;
+
+            if (array.offset < sizeof(SnapshotHeader) ||
+                array.offset % sizeof(uint32_t) ||
+                array.offset > header.strings ||
+                array.count > (header.strings - array.offset) / sizeof(T) ||
+                array.count > remaining / sizeof(T))
+                return false;
+
+            remaining -= array.count * sizeof(T);
+
+            const T* records = reinterpret_cast<const T*>(data + array.offset);
+            for (uint32_t i = 0; i < array.count; ++i) {
+                if (!check(records[i]))
+                    return false;
+            }
+
+            return true;
+        }
+
+        bool check(const SnapshotKeyValue& keyValue) const {
+            return check(keyValue.key) && check(keyValue.value);
+        }
+
+        bool check(const SnapshotParameter& parameter) const {
+            return check(parameter.name) && check(parameter.description);
+        }
+
+        bool check(const SnapshotPayload& payload) const {
+            return check(payload.name) &&
+                   check(payload.description) &&
+                   check<SnapshotParameter>(payload.parameters) &&
+                   check<SnapshotKeyValue>(payload.headers) &&
+                   check(payload.body) &&
+                   check(payload.schema);
+        }
+
+        bool check(const SnapshotMethod& method) const {
+            return check(method.method) &&
+                   check(method.name) &&
+                   check(method.description) &&
+                   check<SnapshotParameter>(method.parameters) &&
+                   check<SnapshotKeyValue>(method.headers) &&
+                   check<SnapshotPayload>(method.requests) &&
+                   check<SnapshotPayload>(method.responses);
+        }
+
+        bool check(const SnapshotResource& resource) const {
+            return check(resource.uriTemplate) &&
+                   check(resource.name) &&
+                   check(resource.description) &&
+                   check(resource.object) &&
+                   check<SnapshotParameter>(resource.parameters) &&
+                   check<SnapshotKeyValue>(resource.headers) &&
+                   check<SnapshotMethod>(resource.methods);
+        }
+
+        bool check(const SnapshotResourceGroup& group) const {
+            return check(group.name) &&
+                   check(group.description) &&
+                   check<SnapshotResource>(group.resources);
+        }
+
+        bool check(const SnapshotBlueprint& blueprint) const {
+            return check<SnapshotKeyValue>(blueprint.metadata) &&
+                   check(blueprint.name) &&
+                   check(blueprint.description) &&
+                   check<SnapshotResourceGroup>(blueprint.resourceGroups);
+        }
+    };
+
+    //
+    // Snapshot to AST conversion
+    //
+    struct SnapshotMaterializer {
+
+        SnapshotMaterializer(const Snapshot& s)
+        : snapshot(s) {}
+
+        const Snapshot& snapshot;
+
+        void convert(const SnapshotString& in, std::string& out) const {
+            out.assign(snapshot.c_str(in), in.length);
+        }
+
+        template <class R, class T>
+        void convert(const SnapshotArray& in, std::vector<T>& out) const {
+            out.resize(in.count);
+            for (uint32_t i = 0; i < in.count; ++i)
+                convert(snapshot.at<R>(in, i), out[i]);
+        }
+
+        void convert(const SnapshotKeyValue& in, KeyValuePair& out) const {
+            convert(in.key, out.first);
+            convert(in.value, out.second);
+        }
+
+        void convert(const SnapshotParameter& in, Parameter& out) const {
+            convert(in.name, out.name);
+            convert(in.description, out.description);
+        }
+
+        void convert(const SnapshotPayload& in, Payload& out) const {
+            convert(in.name, out.name);
+            convert(in.description, out.description);
+            convert<SnapshotParameter>(in.parameters, out.parameters);
+            convert<SnapshotKeyValue>(in.headers, out.headers);
+            convert(in.body, out.body);
+            convert(in.schema, out.schema);
+        }
+
+        void convert(const SnapshotMethod& in, Method& out) const {
+            convert(in.method, out.method);
+            convert(in.name, out.name);
+            convert(in.description, out.description);
+            convert<SnapshotParameter>(in.parameters, out.parameters);
+            convert<SnapshotKeyValue>(in.headers, out.headers);
+            convert<SnapshotPayload>(in.requests, out.requests);
+            convert<SnapshotPayload>(in.responses, out.responses);
+        }
+
+        void convert(const SnapshotResource& in, Resource& out) const {
+            convert(in.uriTemplate, out.uriTemplate);
+            CompileURITemplate(out.uriTemplate, out.compiledURITemplate);
+            convert(in.name, out.name);
+            convert(in.description, out.description);
+            convert(in.object, out.object);
+            convert<SnapshotParameter>(in.parameters, out.parameters);
+            convert<SnapshotKeyValue>(in.headers, out.headers);
+            convert<SnapshotMethod>(in.methods, out.methods);
+        }
+
+        void convert(const SnapshotResourceGroup& in, ResourceGroup& out) const {
+            convert(in.name, out.name);
+            convert(in.description, out.description);
+            convert<SnapshotResource>(in.resources, out.resources);
+        }
+
+        void convert(const SnapshotBlueprint& in, Blueprint& out) const {
+            convert<SnapshotKeyValue>(in.metadata, out.metadata);
+            convert(in.name, out.name);
+            convert(in.description, out.description);
+            convert<SnapshotResourceGroup>(in.resourceGroups, out.resourceGroups);
+        }
+    };
+}
+
+Snapshot::Snapshot()
+: m_data(NULL), m_strings(NULL)
+{
+}
+
+bool Snapshot::open(const std::string& path)
+{
+    close();
+
+    if (!m_file.open(path))
+        return false;
+
+    if (!validate(m_file.data(), m_file.size())) {
+        m_file.close();
+        return false;
+    }
+
+    return true;
+}
+
+bool Snapshot::load(const char* data, size_t length)
+{
+    close();
+    return validate(data, length);
+}
+
+void Snapshot::close()
+{
+    m_file.close();
+    m_data = NULL;
+    m_strings = NULL;
+}
+
+const SnapshotBlueprint& Snapshot::blueprint() const
+{
+    return reinterpret_cast<const SnapshotHeader*>(m_data)->blueprint;
+}
+
+bool Snapshot::validate(const char* data, size_t length)
+{
+    // Records are read in place, their 32-bit fields must be aligned
+    if (!data ||
+        length < sizeof(SnapshotHeader) ||
+        reinterpret_cast<uintptr_t>(data) % sizeof(uint32_t))
+        return false;
+
+    SnapshotHeader header;
+    ::memcpy(&header, data, sizeof(SnapshotHeader));
+
+    if (::memcmp(header.magic, SnapshotMagic, sizeof(SnapshotMagic)) != 0 ||
+        header.version != SnapshotVersion ||
+        header.byteOrder != SnapshotByteOrder ||
+        header.size > length ||
+        header.strings < sizeof(SnapshotHeader) ||
+        header.strings > header.size ||
+        header.stringsLength > header.size - header.strings)
+        return false;
+
+    SnapshotValidator validator(data, header);
+    if (!validator.check(header.blueprint))
+        return false;
+
+    m_data = data;
+    m_strings = data + header.strings;
+    return true;
+}
+
+void Snapshot::materialize(Blueprint& blueprint) const
+{
+    if (!isValid())
+        return;
+
+    SnapshotMaterializer materializer(*this);
+    materializer.convert(this->blueprint(), blueprint);
+}
@@ -0,0 +1,180 @@
+//
+//  Snapshot.h
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#ifndef SNOWCRASH_SNAPSHOT_H
+#define SNOWCRASH_SNAPSHOT_H
+
+#include <string>
+#include <stdint.h>
+#include "Blueprint.h"
+#include "MappedFile.h"
+
+namespace snowcrash {
+
+    //
+    // Binary AST snapshot format
+    //
+    // A snapshot is a header followed by the record region and the string pool.
+    // Records are built of 32-bit fields only and refer to each other by offsets
+    // from the beginning of the snapshot. Strings are stored NUL-terminated in the
+    // string pool and referred to by offsets from the beginning of the pool.
+    // Snapshots are written in the host byte order.
+    //
+
+    // Snapshot magic, first 8 bytes of every snapshot
+    extern const char SnapshotMagic[8];
+
+    // Current snapshot format version, bump on any layout change
+    extern const uint32_t SnapshotVersion;
+
+    // Byte order mark
+    extern const uint32_t SnapshotByteOrder;
+
+    // String reference, offset into string pool
+    struct SnapshotString {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    // Array of records, offset of the first record from the beginning of the snapshot
+    struct SnapshotArray {
+        uint32_t offset;
+        uint32_t count;
+    };
+
+    // Key value pair record (Metadata, Header)
+    struct SnapshotKeyValue {
+        SnapshotString key;
+        SnapshotString value;
+    };
+
+    // Parameter record
+    struct SnapshotParameter {
+        SnapshotString name;
+        SnapshotString description;
+    };
+
+    // Payload record
+    struct SnapshotPayload {
+        SnapshotString name;
+        SnapshotString description;
+        SnapshotArray parameters;   // of SnapshotParameter
+        SnapshotArray headers;      // of SnapshotKeyValue
+        SnapshotString body;
+        SnapshotString schema;
+    };
+
+    // Method record
+    struct SnapshotMethod {
+        SnapshotString method;
+        SnapshotString name;
+        SnapshotString description;
+        SnapshotArray parameters;   // of SnapshotParameter
+        SnapshotArray headers;      // of SnapshotKeyValue
+        SnapshotArray requests;     // of SnapshotPayload
+        SnapshotArray responses;    // of SnapshotPayload
+    };
+
+    // Resource record
+    struct SnapshotResource {
+        SnapshotString uriTemplate;
+        SnapshotString name;
+        SnapshotString description;
+        SnapshotPayload object;
+        SnapshotArray parameters;   // of SnapshotParameter
+        SnapshotArray headers;      // of SnapshotKeyValue
+        SnapshotArray methods;      // of SnapshotMethod
+    };
+
+    // Resource Group record
+    struct SnapshotResourceGroup {
+        SnapshotString name;
+        SnapshotString description;
+        SnapshotArray resources;    // of SnapshotResource
+    };
+
+    // Blueprint record
+    struct SnapshotBlueprint {
+        SnapshotArray metadata;     // of SnapshotKeyValue
+        SnapshotString name;
+        SnapshotString description;
+        SnapshotArray resourceGroups;   // of SnapshotResourceGroup
+    };
+
+    // Snapshot header
+    struct SnapshotHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+        uint32_t size;              // size of the whole snapshot
+        uint32_t strings;           // offset of the string pool
+        uint32_t stringsLength;     // length of the string pool
+        SnapshotBlueprint blueprint;
+    };
+
+    //
+    // Snapshot loader
+    //
+    // Provides in-place read access to a snapshot. The snapshot is either
+    // memory mapped from a file or read from a caller-owned buffer.
+    //
+    class Snapshot {
+    public:
+        Snapshot();
+
+        // Map snapshot file and validate it
+        // returns true on success, false otherwise
+        bool open(const std::string& path);
+
+        // Use snapshot in a buffer, the buffer must outlive the snapshot
+        // and be aligned to 4 bytes, records are read in place.
+        // returns true on success, false otherwise
+        bool load(const char* data, size_t length);
+
+        // Release the snapshot
+        void close();
+
+        // Returns true if a valid snapshot is loaded, false otherwise
+        bool isValid() const { return m_data != NULL; }
+
+        // Snapshot root record
+        const SnapshotBlueprint& blueprint() const;
+
+        // Returns record at index of an array
+        template <class T>
+        const T& at(const SnapshotArray& array, size_t index) const {
+            return reinterpret_cast<const T*>(m_data + array.offset)[index];
+        }
+
+        // Returns NUL-terminated string data in place
+        const char* c_str(const SnapshotString& string) const {
+            return m_strings + string.offset;
+        }
+
+        // Returns copy of a string
+        std::string str(const SnapshotString& string) const {
+            return std::string(c_str(string), string.length);
+        }
+
+        // Build Blueprint AST from the snapshot
+        void materialize(Blueprint& blueprint) const;
+
+    private:
+        MappedFile m_file;
+        const char* m_data;
+        const char* m_strings;
+
+        // Check snapshot structure, returns true if all offsets are in bounds
+        // and no records are checked more than once
+        bool validate(const char* data, size_t length);
+
+        Snapshot(const Snapshot&);
+        Snapshot& operator=(const Snapshot&);
+    };
+}
+
+#endif
@@ -0,0 +1,68 @@
+//
+//  Thread.h
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#ifndef SNOWCRASH_THREAD_H
+#define SNOWCRASH_THREAD_H
+
+#include <vector>
+#include <cstddef>
+
+namespace snowcrash {
+
+    //
+    // Unit of work run by a thread pool
+    //
+    // run() must not throw, an exception leaving it on a worker thread
+    // terminates the program. Keep the failure in the task instead and
+    // act on it once ThreadPool::run() returns.
+    //
+    class Task {
+    public:
+        virtual ~Task() {}
+        virtual void run() = 0;
+    };
+
+    //
+    // Fixed size pool of worker threads
+    //
+    class ThreadPool {
+    public:
+        // Start worker threads, 0 uses one thread per processor
+        explicit ThreadPool(size_t threads = 0);
+
+        // Stop and join worker threads
+        ~ThreadPool();
+
+        // Run tasks and wait until all of them are done.
+        // The calling thread takes part in the work.
+        // Tasks may finish in any order. Concurrent calls are serialized.
+        void run(const std::vector<Task*>& tasks);
+
+        // Number of threads running tasks, including the calling thread
+        size_t size() const;
+
+        // Number of processors available
+        static size_t HardwareConcurrency();
+
+    private:
+        // Platform specific state
+        struct State;
+        State* m_state;
+
+        ThreadPool(const ThreadPool&);
+        ThreadPool& operator=(const ThreadPool&);
+    };
+
+    // Atomically replace target with desired if it equals expected.
+    // Returns true if replaced, false otherwise.
+    bool AtomicCompareAndSwap(void* volatile* target, void* expected, void* desired);
+
+    // Atomically increment value, returns the incremented value
+    long AtomicIncrement(volatile long* value);
+}
+
+#endif
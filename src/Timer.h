@@ -0,0 +1,41 @@
+//
+//  Timer.h
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#ifndef SNOWCRASH_TIMER_H
+#define SNOWCRASH_TIMER_H
+
+namespace snowcrash {
+    
+    // Monotonic wall clock in seconds, measured from an arbitrary point
+    double Now();
+    
+    //
+    // Scoped Timer
+    //
+    // Adds the wall time elapsed between its construction and destruction
+    // to the given counter. Does nothing when the counter is NULL.
+    //
+    class Timer {
+    public:
+        explicit Timer(double* elapsed)
+        : m_elapsed(elapsed), m_start(elapsed ? Now() : 0) {}
+        
+        ~Timer() {
+            if (m_elapsed)
+                *m_elapsed += Now() - m_start;
+        }
+        
+    private:
+        double* m_elapsed;
+        double m_start;
+        
+        Timer(const Timer&);
+        Timer& operator=(const Timer&);
+    };
+}
+
+#endif
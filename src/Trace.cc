@@ -0,0 +1,171 @@
+//
+//  Trace.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <vector>
+#include <iomanip>
+#include "Trace.h"
+#include "Thread.h"
+#include "Platform.h"
+#include "ParserStatistics.h"
+
+using namespace snowcrash;
+
+// Initial capacity of a thread buffer, in spans
+static const size_t BufferCapacity = 1024;
+
+// Number of traces ever created, source of trace ids
+static volatile long s_traces = 0;
+
+// Number of traces whose buffers a thread keeps at hand
+static const size_t CachedTraces = 4;
+
+// Buffers of the traces the calling thread recorded into last, by trace id
+static THREADLOCAL long s_traceIds[CachedTraces] = { 0 };
+static THREADLOCAL void* s_buffers[CachedTraces] = { NULL };
+static THREADLOCAL size_t s_nextSlot = 0;
+
+// Address unique to each running thread, marks the buffer owner
+static THREADLOCAL char s_threadTag = 0;
+
+struct Trace::Buffer {
+    Buffer* next;
+    long thread;
+    const void* owner;
+    std::vector<TraceEvent> events;
+};
+
+Trace::Trace()
+: m_buffers(NULL), m_threads(0)
+{
+    m_id = AtomicIncrement(&s_traces);
+    m_start = Now();
+}
+
+Trace::~Trace()
+{
+    Buffer* buffer = static_cast<Buffer*>(m_buffers);
+    while (buffer) {
+        Buffer* next = buffer->next;
+        delete buffer;
+        buffer = next;
+    }
+}
+
+Trace::Buffer* Trace::buffer()
+{
+    for (size_t i = 0; i < CachedTraces; ++i) {
+        if (s_traceIds[i] == m_id)
+            return static_cast<Buffer*>(s_buffers[i]);
+    }
+    
+    // Not cached, look for the buffer this thread created before. The list
+    // only grows while recording, a concurrent push does not disturb the walk.
+    Buffer* buffer = static_cast<Buffer*>(m_buffers);
+    while (buffer && buffer->owner != &s_threadTag)
+        buffer = buffer->next;
+    
+    if (!buffer) {
+        buffer = new Buffer;
+        buffer->thread = AtomicIncrement(&m_threads);
+        buffer->owner = &s_threadTag;
+        buffer->events.reserve(BufferCapacity);
+        
+        // Push to the list
+        void* head;
+        do {
+            head = m_buffers;
+            buffer->next = static_cast<Buffer*>(head);
+        } while (!AtomicCompareAndSwap(&m_buffers, head, buffer));
+    }
+    
+    // Replace the oldest cached trace, trace ids are never reused
+    size_t slot = s_nextSlot;
+    s_nextSlot = (slot + 1) % CachedTraces;
+    s_traceIds[slot] = m_id;
+    s_buffers[slot] = buffer;
+    return buffer;
+}
+
+void Trace::record(const TraceEvent& event)
+{
+    buffer()->events.push_back(event);
+}
+
+size_t Trace::size() const
+{
+    size_t size = 0;
+    for (const Buffer* buffer = static_cast<const Buffer*>(m_buffers); buffer; buffer = buffer->next)
+        size += buffer->events.size();
+    
+    return size;
+}
+
+void Trace::write(std::ostream& os) const
+{
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << std::fixed << std::setprecision(3);
+    
+    os << "{\"traceEvents\":[";
+    bool first = true;
+    for (const Buffer* buffer = static_cast<const Buffer*>(m_buffers); buffer; buffer = buffer->next) {
+        for (std::vector<TraceEvent>::const_iterator it = buffer->events.begin(); it != buffer->events.end(); ++it) {
+            
+            if (!first)
+                os << ",";
+            first = false;
+            
+            os << "\n{\"name\":\"" << it->name << "\",\"cat\":\"" << it->category << "\",\"ph\":\"X\"";
+            os << ",\"ts\":" << (it->begin - m_start) * 1e6;
+            os << ",\"dur\":" << (it->end - it->begin) * 1e6;
+            os << ",\"pid\":1,\"tid\":" << buffer->thread;
+            
+            if (it->source.length)
+                os << ",\"args\":{\"location\":" << it->source.location << ",\"length\":" << it->source.length << "}";
+            
+            os << "}";
+        }
+    }
+    os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    
+    os.flags(flags);
+    os.precision(precision);
+}
+
+void snowcrash::TraceSection(Trace& trace,
+                             Section section,
+                             double begin,
+                             const BlockIterator& first,
+                             const BlockIterator& last)
+{
+    TraceEvent event;
+    event.name = SectionIdentifier(section);
+    event.category = "section";
+    event.begin = begin;
+    event.end = Now();
+    event.source.location = 0;
+    event.source.length = 0;
+    
+    // Source range from the first to the last block parsed
+    BlockIterator from = first;
+    while (from != last && from->sourceMap.empty())
+        ++from;
+    
+    BlockIterator to = last;
+    while (to != from && (to - 1)->sourceMap.empty())
+        --to;
+    
+    if (from != to) {
+        const SourceDataRange& front = from->sourceMap.front();
+        const SourceDataRange& back = (to - 1)->sourceMap.back();
+        event.source.location = front.location;
+        if (back.location + back.length > front.location)
+            event.source.length = back.location + back.length - front.location;
+    }
+    
+    trace.record(event);
+}
@@ -0,0 +1,102 @@
+//
+//  Trace.h
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#ifndef SNOWCRASH_TRACE_H
+#define SNOWCRASH_TRACE_H
+
+#include <ostream>
+#include "ParserCore.h"
+#include "Timer.h"
+
+namespace snowcrash {
+    
+    //
+    // Recorded span
+    //
+    struct TraceEvent {
+        const char* name;           // Static string
+        const char* category;       // Static string
+        double begin;               // Now() at the span begin
+        double end;                 // Now() at the span end
+        SourceDataRange source;     // Source data of the span, zero length if none
+    };
+    
+    //
+    // Span Trace
+    //
+    // Records spans into a buffer owned by the recording thread, recording
+    // takes no locks. Buffers are written out in Chrome trace event format,
+    // a thread per buffer.
+    //
+    // Recording may be done from any number of threads at once, write()
+    // must not run while spans are being recorded. A thread may record into
+    // several live traces, each trace keeps a single buffer per thread.
+    //
+    class Trace {
+    public:
+        Trace();
+        ~Trace();
+        
+        // Record span from the calling thread
+        void record(const TraceEvent& event);
+        
+        // Number of spans recorded
+        size_t size() const;
+        
+        // Write spans as Chrome trace event JSON
+        void write(std::ostream& os) const;
+        
+    private:
+        struct Buffer;
+        
+        // Buffer of the calling thread, created on first use
+        Buffer* buffer();
+        
+        void* volatile m_buffers;   // Buffer list head
+        volatile long m_threads;    // Number of buffers
+        long m_id;                  // Unique id of this trace
+        double m_start;             // Now() at construction
+        
+        Trace(const Trace&);
+        Trace& operator=(const Trace&);
+    };
+    
+    //
+    // Scoped span, recorded at its destruction. Does nothing when trace is NULL.
+    //
+    class TraceSpan {
+    public:
+        TraceSpan(Trace* trace, const char* name, const char* category)
+        : m_trace(trace) {
+            if (!m_trace)
+                return;
+            
+            m_event.name = name;
+            m_event.category = category;
+            m_event.source.location = 0;
+            m_event.source.length = 0;
+            m_event.begin = Now();
+        }
+        
+        ~TraceSpan() {
+            if (!m_trace)
+                return;
+            
+            m_event.end = Now();
+            m_trace->record(m_event);
+        }
+        
+    private:
+        Trace* m_trace;
+        TraceEvent m_event;
+        
+        TraceSpan(const TraceSpan&);
+        TraceSpan& operator=(const TraceSpan&);
+    };
+}
+
+#endif
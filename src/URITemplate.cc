@@ -0,0 +1,440 @@
+//
+//  URITemplate.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <cstdlib>
+#include <cstring>
+#include "URITemplate.h"
+
+using namespace snowcrash;
+
+// Expression operators
+static const char* const URITemplateOperators = "+#./;?&";
+
+// Reserved characters, RFC 3986
+static const char* const ReservedCharacters = ":/?#[]@!$&'()*+,;=";
+
+// Expansion rules of an expression operator, RFC 6570 Appendix A
+struct OperatorRules {
+    char op;
+    char first;
+    char separator;
+    bool named;
+    const char* ifEmpty;
+    bool allowReserved;
+};
+
+static const OperatorRules Rules[] = {
+    { '\0', '\0', ',', false, "",  false },
+    { '+',  '\0', ',', false, "",  true  },
+    { '.',  '.',  '.', false, "",  false },
+    { '/',  '/',  '/', false, "",  false },
+    { ';',  ';',  ';', true,  "",  false },
+    { '?',  '?',  '&', true,  "=", false },
+    { '&',  '&',  '&', true,  "=", false },
+    { '#',  '#',  ',', false, "",  true  }
+};
+
+static const OperatorRules& GetOperatorRules(char op)
+{
+    for (size_t i = 1; i < sizeof(Rules) / sizeof(Rules[0]); ++i) {
+        if (Rules[i].op == op)
+            return Rules[i];
+    }
+
+    return Rules[0];
+}
+
+static bool IsUnreserved(char c)
+{
+    return (c >= 'a' && c <= 'z') ||
+           (c >= 'A' && c <= 'Z') ||
+           (c >= '0' && c <= '9') ||
+           c == '-' || c == '.' || c == '_' || c == '~';
+}
+
+static bool IsReserved(char c)
+{
+    return c && std::strchr(ReservedCharacters, c) != NULL;
+}
+
+static bool IsHexDigit(char c)
+{
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+// Variable name characters, RFC 6570 varchar (pct-encoded checked by the caller)
+static bool IsVariableCharacter(char c)
+{
+    return (c >= 'a' && c <= 'z') ||
+           (c >= 'A' && c <= 'Z') ||
+           (c >= '0' && c <= '9') ||
+           c == '_' || c == '.' || c == '%';
+}
+
+// Parse variable specification `name[:N|*]`
+static bool ParseVariable(const std::string& spec, URITemplateVariable& variable)
+{
+    variable.maxLength = 0;
+    variable.explode = false;
+
+    std::string::size_type end = spec.length();
+    if (end && spec[end - 1] == '*') {
+        variable.explode = true;
+        --end;
+    }
+    else {
+        std::string::size_type colon = spec.find(':');
+        if (colon != std::string::npos) {
+            std::string length = spec.substr(colon + 1);
+            if (length.empty() || length.length() > 4 ||
+                length.find_first_not_of("0123456789") != std::string::npos ||
+                length[0] == '0')
+                return false;
+
+            variable.maxLength = static_cast<size_t>(std::atoi(length.c_str()));
+            end = colon;
+        }
+    }
+
+    variable.name = spec.substr(0, end);
+    if (variable.name.empty())
+        return false;
+
+    for (size_t i = 0; i < variable.name.length(); ++i) {
+        if (!IsVariableCharacter(variable.name[i]))
+            return false;
+    }
+
+    return true;
+}
+
+bool snowcrash::CompileURITemplate(const URITemplate& uriTemplate, CompiledURITemplate& result)
+{
+    result.parts.clear();
+    result.prefix.clear();
+
+    bool valid = true;
+    std::string::size_type i = 0;
+    while (i < uriTemplate.length() && valid) {
+
+        URITemplatePart part;
+        part.op = '\0';
+
+        if (uriTemplate[i] != '{') {
+            std::string::size_type open = uriTemplate.find('{', i);
+            if (open == std::string::npos)
+                open = uriTemplate.length();
+
+            part.type = LiteralURITemplatePartType;
+            part.literal = uriTemplate.substr(i, open - i);
+            result.parts.push_back(part);
+            i = open;
+            continue;
+        }
+
+        std::string::size_type close = uriTemplate.find('}', i);
+        if (close == std::string::npos)
+            break;
+
+        part.type = ExpressionURITemplatePartType;
+        std::string::size_type start = i + 1;
+        if (start < close && std::strchr(URITemplateOperators, uriTemplate[start]))
+            part.op = uriTemplate[start++];
+
+        while (start <= close) {
+            std::string::size_type comma = uriTemplate.find(',', start);
+            if (comma == std::string::npos || comma > close)
+                comma = close;
+
+            URITemplateVariable variable;
+            if (!ParseVariable(uriTemplate.substr(start, comma - start), variable)) {
+                valid = false;
+                break;
+            }
+
+            part.variables.push_back(variable);
+            start = comma + 1;
+        }
+
+        if (valid)
+            result.parts.push_back(part);
+
+        i = close + 1;
+    }
+
+    if (!result.parts.empty() && result.parts.front().type == LiteralURITemplatePartType)
+        result.prefix = result.parts.front().literal;
+
+    return valid && i >= uriTemplate.length();
+}
+
+// Find value of a variable, NULL if undefined
+static const std::string* FindValue(const Collection<KeyValuePair>::type& values, const Name& name)
+{
+    for (Collection<KeyValuePair>::const_iterator it = values.begin(); it != values.end(); ++it) {
+        if (it->first == name)
+            return &it->second;
+    }
+
+    return NULL;
+}
+
+// Append a percent-encoded value, at most maxLength characters (0 = unlimited)
+static void AppendEncoded(const std::string& value, size_t maxLength, bool allowReserved, std::string& output)
+{
+    static const char* const HexDigits = "0123456789ABCDEF";
+
+    size_t characters = 0;
+    for (size_t i = 0; i < value.length(); ++i) {
+
+        unsigned char c = static_cast<unsigned char>(value[i]);
+
+        // Count characters, not UTF-8 continuation bytes
+        if ((c & 0xC0) != 0x80) {
+            if (maxLength && characters == maxLength)
+                break;
+            ++characters;
+        }
+
+        if (IsUnreserved(value[i]) || (allowReserved && IsReserved(value[i]))) {
+            output += value[i];
+        }
+        else if (allowReserved && c == '%' &&
+                 i + 2 < value.length() &&
+                 IsHexDigit(value[i + 1]) && IsHexDigit(value[i + 2])) {
+            output.append(value, i, 3);
+            i += 2;
+        }
+        else {
+            output += '%';
+            output += HexDigits[c >> 4];
+            output += HexDigits[c & 0x0F];
+        }
+    }
+}
+
+void snowcrash::ExpandURITemplate(const CompiledURITemplate& uriTemplate,
+                                  const Collection<KeyValuePair>::type& values,
+                                  std::string& output)
+{
+    for (Collection<URITemplatePart>::const_iterator part = uriTemplate.parts.begin();
+         part != uriTemplate.parts.end();
+         ++part) {
+
+        if (part->type == LiteralURITemplatePartType) {
+            output += part->literal;
+            continue;
+        }
+
+        const OperatorRules& rules = GetOperatorRules(part->op);
+        bool first = true;
+        for (Collection<URITemplateVariable>::const_iterator variable = part->variables.begin();
+             variable != part->variables.end();
+             ++variable) {
+
+            const std::string* value = FindValue(values, variable->name);
+            if (!value)
+                continue;
+
+            if (first) {
+                if (rules.first)
+                    output += rules.first;
+                first = false;
+            }
+            else {
+                output += rules.separator;
+            }
+
+            if (rules.named) {
+                output += variable->name;
+                if (value->empty()) {
+                    output += rules.ifEmpty;
+                    continue;
+                }
+                output += '=';
+            }
+
+            AppendEncoded(*value, variable->maxLength, rules.allowReserved, output);
+        }
+    }
+}
+
+// Whether a character may appear in an expanded value
+static bool IsValueCharacter(char c, bool allowReserved)
+{
+    return IsUnreserved(c) || c == '%' || (allowReserved && IsReserved(c));
+}
+
+// Find a string in a range, returns position or end
+static size_t FindString(const char* data, size_t begin, size_t end, const std::string& str)
+{
+    while (begin + str.length() <= end) {
+        const void* found = ::memchr(data + begin, str[0], end - begin);
+        if (!found)
+            break;
+
+        begin = static_cast<const char*>(found) - data;
+        if (begin + str.length() > end)
+            break;
+
+        if (::memcmp(data + begin, str.data(), str.length()) == 0)
+            return begin;
+
+        ++begin;
+    }
+
+    return end;
+}
+
+// Find variable of an expression by name in a range, NULL if none
+static const URITemplateVariable* FindVariable(const URITemplatePart& part, const char* name, size_t length)
+{
+    for (Collection<URITemplateVariable>::const_iterator it = part.variables.begin(); it != part.variables.end(); ++it) {
+        if (it->name.length() == length && ::memcmp(it->name.data(), name, length) == 0)
+            return &*it;
+    }
+
+    return NULL;
+}
+
+// Match query expression pairs `name=value` at position, in any order
+static size_t MatchQuery(const URITemplatePart& part,
+                         const char* uri,
+                         size_t position,
+                         size_t length,
+                         std::vector<URITemplateCapture>& captures)
+{
+    size_t pos = position + 1; // operator
+    while (pos < length) {
+        size_t end = pos;
+        while (end < length && uri[end] != '&' && uri[end] != '#')
+            ++end;
+
+        const char* equals = static_cast<const char*>(::memchr(uri + pos, '=', end - pos));
+        size_t nameEnd = (equals) ? equals - uri : end;
+        const URITemplateVariable* variable = FindVariable(part, uri + pos, nameEnd - pos);
+        if (!variable)
+            return (pos == position + 1) ? position : pos - 1;
+
+        URITemplateCapture capture;
+        capture.name = &variable->name;
+        capture.offset = (equals) ? nameEnd + 1 : end;
+        capture.length = end - capture.offset;
+        captures.push_back(capture);
+
+        if (end == length || uri[end] != '&')
+            return end;
+
+        pos = end + 1;
+    }
+
+    return pos;
+}
+
+bool snowcrash::MatchURITemplate(const CompiledURITemplate& uriTemplate,
+                                 const char* uri,
+                                 size_t length,
+                                 std::vector<URITemplateCapture>& captures)
+{
+    captures.clear();
+
+    // Quick rejection
+    if (length < uriTemplate.prefix.length() ||
+        ::memcmp(uri, uriTemplate.prefix.data(), uriTemplate.prefix.length()) != 0)
+        return false;
+
+    size_t pos = 0;
+    for (Collection<URITemplatePart>::const_iterator part = uriTemplate.parts.begin();
+         part != uriTemplate.parts.end();
+         ++part) {
+
+        if (part->type == LiteralURITemplatePartType) {
+            if (length - pos < part->literal.length() ||
+                ::memcmp(uri + pos, part->literal.data(), part->literal.length()) != 0)
+                return false;
+
+            pos += part->literal.length();
+            continue;
+        }
+
+        const OperatorRules& rules = GetOperatorRules(part->op);
+
+        // No first character, all variables undefined
+        if (rules.first && (pos == length || uri[pos] != rules.first))
+            continue;
+
+        if (part->op == '?' || part->op == '&') {
+            size_t end = MatchQuery(*part, uri, pos, length, captures);
+            if (end == pos)
+                return false;
+            pos = end;
+            continue;
+        }
+
+        if (rules.first)
+            ++pos;
+
+        // Character or literal following the expression
+        Collection<URITemplatePart>::const_iterator next = part + 1;
+        const std::string* nextLiteral = NULL;
+        char stop = '\0';
+        if (next != uriTemplate.parts.end()) {
+            if (next->type == LiteralURITemplatePartType) {
+                nextLiteral = &next->literal;
+                stop = next->literal[0];
+            }
+            else {
+                stop = GetOperatorRules(next->op).first;
+            }
+        }
+
+        for (size_t i = 0; i < part->variables.size(); ++i) {
+
+            const URITemplateVariable& variable = part->variables[i];
+            bool more = (i + 1 < part->variables.size());
+
+            if (i) {
+                if (pos == length || uri[pos] != rules.separator)
+                    break;
+                ++pos;
+            }
+
+            if (rules.named) {
+                if (length - pos < variable.name.length() ||
+                    ::memcmp(uri + pos, variable.name.data(), variable.name.length()) != 0)
+                    return false;
+
+                pos += variable.name.length();
+                if (pos == length || uri[pos] != '=')
+                    continue; // empty value
+                ++pos;
+            }
+
+            size_t start = pos;
+            if (rules.allowReserved && nextLiteral && !more) {
+                pos = FindString(uri, pos, length, *nextLiteral);
+            }
+            else {
+                while (pos < length &&
+                       IsValueCharacter(uri[pos], rules.allowReserved) &&
+                       uri[pos] != stop &&
+                       !(more && uri[pos] == rules.separator))
+                    ++pos;
+            }
+
+            if (pos > start) {
+                URITemplateCapture capture;
+                capture.name = &variable.name;
+                capture.offset = start;
+                capture.length = pos - start;
+                captures.push_back(capture);
+            }
+        }
+    }
+
+    return pos == length;
+}
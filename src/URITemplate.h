@@ -0,0 +1,58 @@
+//
+//  URITemplate.h
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#ifndef SNOWCRASH_URITEMPLATE_H
+#define SNOWCRASH_URITEMPLATE_H
+
+#include <string>
+#include <vector>
+#include "Platform.h"
+#include "Blueprint.h"
+
+namespace snowcrash {
+
+    //
+    // Variable value captured by matching a URI against a template.
+    // The value is a (still percent-encoded) range of the URI.
+    //
+    struct URITemplateCapture {
+
+        // Variable name
+        const Name* name;
+
+        // Value location in the URI
+        size_t offset;
+        size_t length;
+    };
+
+    // Compile a URI template into literals & expressions.
+    // Returns false if the template is malformed, the result
+    // then holds the template up to the malformed expression.
+    bool CompileURITemplate(const URITemplate& uriTemplate, CompiledURITemplate& result);
+
+    // Expand a compiled URI template with variable values (RFC 6570 level 3),
+    // the expansion is appended to output. Variables with no value are undefined.
+    void ExpandURITemplate(const CompiledURITemplate& uriTemplate,
+                           const Collection<KeyValuePair>::type& values,
+                           std::string& output);
+
+    // Match a URI against a compiled URI template, capturing variable values.
+    // A variable value ends at the first character that could follow it in
+    // the template, no backtracking is performed. Returns true on match.
+    bool MatchURITemplate(const CompiledURITemplate& uriTemplate,
+                          const char* uri,
+                          size_t length,
+                          std::vector<URITemplateCapture>& captures);
+
+    FORCEINLINE bool MatchURITemplate(const CompiledURITemplate& uriTemplate,
+                                      const std::string& uri,
+                                      std::vector<URITemplateCapture>& captures) {
+        return MatchURITemplate(uriTemplate, uri.data(), uri.length(), captures);
+    }
+}
+
+#endif
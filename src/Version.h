@@ -0,0 +1,17 @@
+//
+//  Version.h
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#ifndef SNOWCRASH_VERSION_H
+#define SNOWCRASH_VERSION_H
+
+#define SNOWCRASH_MAJOR_VERSION 0
+#define SNOWCRASH_MINOR_VERSION 4
+#define SNOWCRASH_PATCH_VERSION 0
+
+#define SNOWCRASH_VERSION_STRING "v0.4.0"
+
+#endif
@@ -9,6 +9,10 @@
 #include <regex.h>
 #include <cstring>
 #include "RegexMatch.h"
+#include "Platform.h"
+
+// Counter of regex evaluations performed by this thread, NULL if not counted
+static THREADLOCAL size_t* s_evaluations = NULL;
 
 // FIXME: Migrate to C++11.
 // Naive implementation of regex matching using POSIX regex
@@ -17,6 +21,9 @@ bool snowcrash::RegexMatch(const std::string& target, const std::string& express
     if (target.empty() || expression.empty())
         return false;
 
+    if (s_evaluations)
+        ++*s_evaluations;
+
     regex_t regex;
     int reti = ::regcomp(&regex, expression.c_str(), REG_EXTENDED | REG_NOSUB);
     if (reti) {
@@ -58,6 +65,9 @@ bool snowcrash::RegexCapture(const std::string& target, const std::string& expre
 {
     if (target.empty() || expression.empty())
         return false;
+
+    if (s_evaluations)
+        ++*s_evaluations;
     
     captureGroups.clear();
     
@@ -96,4 +106,9 @@ bool snowcrash::RegexCapture(const std::string& target, const std::string& expre
     return false;    
 }
 
-
+size_t* snowcrash::SetRegexEvaluationCounter(size_t* counter)
+{
+    size_t* previous = s_evaluations;
+    s_evaluations = counter;
+    return previous;
+}
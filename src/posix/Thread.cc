@@ -0,0 +1,142 @@
+//
+//  Thread.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <pthread.h>
+#include <unistd.h>
+#include "Thread.h"
+
+using namespace snowcrash;
+
+struct ThreadPool::State {
+    std::vector<pthread_t> threads;
+
+    pthread_mutex_t runMutex;       // serializes run() calls
+    pthread_mutex_t mutex;          // guards the fields below
+    pthread_cond_t work;            // signaled when tasks are available or stopping
+    pthread_cond_t done;            // signaled when the last task is done
+
+    const std::vector<Task*>* tasks;
+    size_t next;                    // next task to take
+    size_t finished;                // number of finished tasks
+    bool stopping;
+
+    // Take and run tasks until there are none left, mutex must be locked
+    void runTasks() {
+        while (tasks && next < tasks->size()) {
+            Task* task = (*tasks)[next++];
+            pthread_mutex_unlock(&mutex);
+            task->run();
+            pthread_mutex_lock(&mutex);
+
+            if (++finished == tasks->size())
+                pthread_cond_broadcast(&done);
+        }
+    }
+
+    // Worker thread entry point
+    static void* worker(void* context) {
+        State* state = static_cast<State*>(context);
+
+        pthread_mutex_lock(&state->mutex);
+        while (true) {
+            state->runTasks();
+            if (state->stopping)
+                break;
+
+            pthread_cond_wait(&state->work, &state->mutex);
+        }
+        pthread_mutex_unlock(&state->mutex);
+
+        return NULL;
+    }
+};
+
+ThreadPool::ThreadPool(size_t threads)
+: m_state(new State)
+{
+    if (!threads)
+        threads = HardwareConcurrency();
+
+    m_state->tasks = NULL;
+    m_state->next = 0;
+    m_state->finished = 0;
+    m_state->stopping = false;
+    pthread_mutex_init(&m_state->runMutex, NULL);
+    pthread_mutex_init(&m_state->mutex, NULL);
+    pthread_cond_init(&m_state->work, NULL);
+    pthread_cond_init(&m_state->done, NULL);
+
+    // The calling thread of run() is one of the threads
+    for (size_t i = 1; i < threads; ++i) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, State::worker, m_state) != 0)
+            break;
+
+        m_state->threads.push_back(thread);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    pthread_mutex_lock(&m_state->mutex);
+    m_state->stopping = true;
+    pthread_cond_broadcast(&m_state->work);
+    pthread_mutex_unlock(&m_state->mutex);
+
+    for (std::vector<pthread_t>::iterator it = m_state->threads.begin(); it != m_state->threads.end(); ++it)
+        pthread_join(*it, NULL);
+
+    pthread_cond_destroy(&m_state->done);
+    pthread_cond_destroy(&m_state->work);
+    pthread_mutex_destroy(&m_state->mutex);
+    pthread_mutex_destroy(&m_state->runMutex);
+    delete m_state;
+}
+
+void ThreadPool::run(const std::vector<Task*>& tasks)
+{
+    if (tasks.empty())
+        return;
+
+    pthread_mutex_lock(&m_state->runMutex);
+    pthread_mutex_lock(&m_state->mutex);
+
+    m_state->tasks = &tasks;
+    m_state->next = 0;
+    m_state->finished = 0;
+    pthread_cond_broadcast(&m_state->work);
+
+    m_state->runTasks();
+    while (m_state->finished < tasks.size())
+        pthread_cond_wait(&m_state->done, &m_state->mutex);
+
+    m_state->tasks = NULL;
+
+    pthread_mutex_unlock(&m_state->mutex);
+    pthread_mutex_unlock(&m_state->runMutex);
+}
+
+size_t ThreadPool::size() const
+{
+    return m_state->threads.size() + 1;
+}
+
+size_t ThreadPool::HardwareConcurrency()
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? static_cast<size_t>(count) : 1;
+}
+
+bool snowcrash::AtomicCompareAndSwap(void* volatile* target, void* expected, void* desired)
+{
+    return __sync_bool_compare_and_swap(target, expected, desired);
+}
+
+long snowcrash::AtomicIncrement(volatile long* value)
+{
+    return __sync_add_and_fetch(value, 1);
+}
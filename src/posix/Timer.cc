@@ -0,0 +1,23 @@
+//
+//  Timer.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <time.h>
+#include <sys/time.h>
+#include "Timer.h"
+
+double snowcrash::Now()
+{
+#if defined(CLOCK_MONOTONIC)
+    struct timespec now;
+    ::clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+#else
+    struct timeval now;
+    ::gettimeofday(&now, NULL);
+    return now.tv_sec + now.tv_usec * 1e-6;
+#endif
+}
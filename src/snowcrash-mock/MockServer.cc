@@ -0,0 +1,479 @@
+//
+//  MockServer.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <unistd.h>
+#include <fcntl.h>
+#include <strings.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include "MockServer.h"
+#include "AssetSource.h"
+
+using namespace snowcrash;
+
+const size_t MockServer::InputBufferSize = 16 * 1024;
+
+// Maximum number of events handled per epoll_wait
+static const int MaxEvents = 256;
+
+// Reason phrase of a status code
+static const char* ReasonPhrase(int status)
+{
+    switch (status) {
+        case 200: return "OK";
+        case 201: return "Created";
+        case 202: return "Accepted";
+        case 204: return "No Content";
+        case 301: return "Moved Permanently";
+        case 302: return "Found";
+        case 304: return "Not Modified";
+        case 400: return "Bad Request";
+        case 401: return "Unauthorized";
+        case 403: return "Forbidden";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 409: return "Conflict";
+        case 415: return "Unsupported Media Type";
+        case 422: return "Unprocessable Entity";
+        case 429: return "Too Many Requests";
+        case 500: return "Internal Server Error";
+        case 503: return "Service Unavailable";
+        default: return "";
+    }
+}
+
+// Build a complete response
+static std::string BuildRawResponse(int status,
+                                    const Collection<Header>::type& headers,
+                                    const std::string& body)
+{
+    std::stringstream ss;
+    ss << "HTTP/1.1 " << status << " " << ReasonPhrase(status) << "\r\n";
+    for (Collection<Header>::const_iterator it = headers.begin(); it != headers.end(); ++it) {
+        if (::strcasecmp(it->first.c_str(), "Content-Length") == 0)
+            continue;
+
+        ss << it->first << ": " << it->second << "\r\n";
+    }
+
+    ss << "Content-Length: " << body.length() << "\r\n\r\n";
+    ss << body;
+    return ss.str();
+}
+
+// Case-insensitive search of a header value, returns NULL if not present
+static const char* FindHeader(const char* head, size_t length, const char* name, size_t* valueLength)
+{
+    size_t nameLength = ::strlen(name);
+    const char* end = head + length;
+    const char* line = static_cast<const char*>(::memchr(head, '\n', length));
+
+    while (line && ++line < end) {
+        const char* lineEnd = static_cast<const char*>(::memchr(line, '\n', end - line));
+        if (!lineEnd)
+            lineEnd = end;
+
+        if (static_cast<size_t>(lineEnd - line) > nameLength &&
+            line[nameLength] == ':' &&
+            ::strncasecmp(line, name, nameLength) == 0) {
+
+            const char* value = line + nameLength + 1;
+            while (value < lineEnd && (*value == ' ' || *value == '\t'))
+                ++value;
+
+            const char* valueEnd = lineEnd;
+            while (valueEnd > value && (valueEnd[-1] == '\r' || valueEnd[-1] == ' '))
+                --valueEnd;
+
+            *valueLength = valueEnd - value;
+            return value;
+        }
+
+        line = lineEnd;
+    }
+
+    return NULL;
+}
+
+void MockServer::BuildResponse(const Method& method, std::string& response)
+{
+    if (method.responses.empty()) {
+        response = BuildRawResponse(200, Collection<Header>::type(), std::string());
+        return;
+    }
+
+    const Response& first = method.responses.front();
+    int status = std::atoi(first.name.c_str());
+    if (status < 100 || status > 599)
+        status = 200;
+
+    Asset storage;
+    response = BuildRawResponse(status, first.headers, PayloadBody(first, storage));
+}
+
+MockServer::MockServer(const Blueprint& blueprint)
+: m_router(blueprint), m_listener(-1), m_epoll(-1), m_port(0), m_running(false)
+{
+    for (Collection<ResourceGroup>::const_iterator group = blueprint.resourceGroups.begin();
+         group != blueprint.resourceGroups.end();
+         ++group) {
+
+        for (Collection<Resource>::const_iterator resource = group->resources.begin();
+             resource != group->resources.end();
+             ++resource) {
+
+            for (Collection<Method>::const_iterator method = resource->methods.begin();
+                 method != resource->methods.end();
+                 ++method) {
+
+                BuildResponse(*method, m_responses[&*method]);
+            }
+        }
+    }
+
+    m_notFound = BuildRawResponse(404, Collection<Header>::type(), std::string());
+    m_methodNotAllowed = BuildRawResponse(405, Collection<Header>::type(), std::string());
+
+    Collection<Header>::type close;
+    close.push_back(std::make_pair("Connection", "close"));
+    m_badRequest = BuildRawResponse(400, close, std::string());
+}
+
+MockServer::~MockServer()
+{
+    for (std::vector<Connection*>::iterator it = m_connections.begin(); it != m_connections.end(); ++it) {
+        if (*it)
+            close(**it);
+    }
+
+    if (m_epoll != -1)
+        ::close(m_epoll);
+
+    if (m_listener != -1)
+        ::close(m_listener);
+}
+
+bool MockServer::listen(unsigned short port, std::string& error)
+{
+    m_listener = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (m_listener == -1) {
+        error = std::string("unable to create socket, ") + ::strerror(errno);
+        return false;
+    }
+
+    int enable = 1;
+    ::setsockopt(m_listener, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    struct sockaddr_in address;
+    ::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+
+    if (::bind(m_listener, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) == -1 ||
+        ::listen(m_listener, SOMAXCONN) == -1) {
+        error = std::string("unable to listen, ") + ::strerror(errno);
+        return false;
+    }
+
+    socklen_t length = sizeof(address);
+    ::getsockname(m_listener, reinterpret_cast<struct sockaddr*>(&address), &length);
+    m_port = ntohs(address.sin_port);
+
+    m_epoll = ::epoll_create1(EPOLL_CLOEXEC);
+    if (m_epoll == -1) {
+        error = std::string("unable to create epoll instance, ") + ::strerror(errno);
+        return false;
+    }
+
+    struct epoll_event event;
+    ::memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = m_listener;
+    ::epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_listener, &event);
+    return true;
+}
+
+unsigned short MockServer::port() const
+{
+    return m_port;
+}
+
+void MockServer::stop()
+{
+    m_running = false;
+}
+
+bool MockServer::run(std::string& error)
+{
+    if (m_epoll == -1) {
+        error = "server is not listening";
+        return false;
+    }
+
+    struct epoll_event events[MaxEvents];
+    m_running = true;
+    while (m_running) {
+
+        // Wake up periodically to notice stop()
+        int count = ::epoll_wait(m_epoll, events, MaxEvents, 100);
+        if (count == -1) {
+            if (errno == EINTR)
+                continue;
+
+            error = std::string("epoll_wait failed, ") + ::strerror(errno);
+            return false;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == m_listener) {
+                accept();
+                continue;
+            }
+
+            // Closed while handling previous events
+            Connection* connection = m_connections[fd];
+            if (!connection)
+                continue;
+
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                close(*connection);
+                continue;
+            }
+
+            if (events[i].events & EPOLLOUT)
+                write(*connection);
+            else if (events[i].events & EPOLLIN)
+                read(*connection);
+        }
+    }
+
+    return true;
+}
+
+void MockServer::accept()
+{
+    while (true) {
+        int fd = ::accept4(m_listener, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd == -1)
+            return;
+
+        int enable = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+        Connection* connection = new Connection;
+        connection->fd = fd;
+        connection->input.resize(InputBufferSize);
+        connection->inputLength = 0;
+        connection->discard = 0;
+        connection->outputOffset = 0;
+        connection->waiting = false;
+        connection->closing = false;
+
+        if (static_cast<size_t>(fd) >= m_connections.size())
+            m_connections.resize(fd + 1, NULL);
+        m_connections[fd] = connection;
+
+        struct epoll_event event;
+        ::memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        ::epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &event);
+    }
+}
+
+void MockServer::close(Connection& connection)
+{
+    ::epoll_ctl(m_epoll, EPOLL_CTL_DEL, connection.fd, NULL);
+    ::close(connection.fd);
+    m_connections[connection.fd] = NULL;
+    delete &connection;
+}
+
+void MockServer::read(Connection& connection)
+{
+    while (true) {
+        size_t available = connection.input.size() - connection.inputLength;
+        if (!available) {
+            // Request head does not fit the buffer
+            connection.output.append(m_badRequest);
+            connection.closing = true;
+            break;
+        }
+
+        ssize_t received = ::recv(connection.fd, &connection.input[connection.inputLength], available, 0);
+        if (received == 0) {
+            close(connection);
+            return;
+        }
+
+        if (received == -1) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+            if (errno == EINTR)
+                continue;
+
+            close(connection);
+            return;
+        }
+
+        connection.inputLength += received;
+
+        // Skip rest of a request body
+        size_t skip = std::min(connection.discard, connection.inputLength);
+        if (skip) {
+            ::memmove(&connection.input[0], &connection.input[skip], connection.inputLength - skip);
+            connection.inputLength -= skip;
+            connection.discard -= skip;
+        }
+
+        size_t consumed = process(connection);
+        if (consumed) {
+            ::memmove(&connection.input[0], &connection.input[consumed], connection.inputLength - consumed);
+            connection.inputLength -= consumed;
+        }
+
+        if (connection.closing || static_cast<size_t>(received) < available)
+            break;
+    }
+
+    write(connection);
+}
+
+size_t MockServer::process(Connection& connection)
+{
+    const char* buffer = &connection.input[0];
+    size_t consumed = 0;
+
+    while (!connection.closing && consumed < connection.inputLength) {
+
+        const char* head = buffer + consumed;
+        size_t length = connection.inputLength - consumed;
+        const char* headEnd = static_cast<const char*>(::memmem(head, length, "\r\n\r\n", 4));
+        if (!headEnd)
+            break;
+
+        size_t headLength = headEnd - head + 4;
+
+        // Request line
+        const char* lineEnd = static_cast<const char*>(::memchr(head, '\r', headLength));
+        const char* methodEnd = static_cast<const char*>(::memchr(head, ' ', lineEnd - head));
+        const char* pathEnd = (methodEnd) ?
+            static_cast<const char*>(::memchr(methodEnd + 1, ' ', lineEnd - methodEnd - 1)) : NULL;
+
+        if (!methodEnd || !pathEnd) {
+            connection.output.append(m_badRequest);
+            connection.closing = true;
+            break;
+        }
+
+        // Keep-alive
+        size_t valueLength = 0;
+        const char* value = FindHeader(head, headLength, "Connection", &valueLength);
+        bool http10 = (lineEnd - pathEnd > 8 && ::memcmp(pathEnd + 1, "HTTP/1.0", 8) == 0);
+        if (value)
+            connection.closing = (valueLength == 5 && ::strncasecmp(value, "close", 5) == 0);
+        else
+            connection.closing = http10;
+
+        // Request body
+        size_t bodyLength = 0;
+        value = FindHeader(head, headLength, "Content-Length", &valueLength);
+        if (value)
+            bodyLength = static_cast<size_t>(::strtoul(value, NULL, 10));
+
+        connection.output.append(respond(head, methodEnd - head, methodEnd + 1, pathEnd - methodEnd - 1));
+
+        consumed += headLength;
+        size_t body = std::min(bodyLength, connection.inputLength - consumed);
+        consumed += body;
+        connection.discard = bodyLength - body;
+        if (connection.discard)
+            break;
+    }
+
+    return consumed;
+}
+
+const std::string& MockServer::respond(const char* method, size_t methodLength,
+                                       const char* path, size_t pathLength)
+{
+    if (!m_router.match(method, methodLength, path, pathLength, m_match))
+        return m_notFound;
+
+    if (!m_match.method)
+        return m_methodNotAllowed;
+
+    return m_responses.find(m_match.method)->second;
+}
+
+void MockServer::write(Connection& connection)
+{
+    while (connection.outputOffset < connection.output.length()) {
+        ssize_t sent = ::send(connection.fd,
+                              connection.output.data() + connection.outputOffset,
+                              connection.output.length() - connection.outputOffset,
+                              MSG_NOSIGNAL);
+        if (sent == -1) {
+            if (errno == EINTR)
+                continue;
+
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                // Wait until writable, stop reading meanwhile
+                struct epoll_event event;
+                ::memset(&event, 0, sizeof(event));
+                event.events = EPOLLOUT;
+                event.data.fd = connection.fd;
+                ::epoll_ctl(m_epoll, EPOLL_CTL_MOD, connection.fd, &event);
+                connection.waiting = true;
+                return;
+            }
+
+            close(connection);
+            return;
+        }
+
+        connection.outputOffset += sent;
+    }
+
+    connection.output.clear(); // keeps capacity
+    connection.outputOffset = 0;
+
+    if (connection.closing) {
+        close(connection);
+        return;
+    }
+
+    if (connection.waiting) {
+        connection.waiting = false;
+
+        struct epoll_event event;
+        ::memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN;
+        event.data.fd = connection.fd;
+        ::epoll_ctl(m_epoll, EPOLL_CTL_MOD, connection.fd, &event);
+
+        // Requests may be pending in the input buffer
+        if (connection.inputLength) {
+            size_t consumed = process(connection);
+            if (consumed) {
+                ::memmove(&connection.input[0], &connection.input[consumed], connection.inputLength - consumed);
+                connection.inputLength -= consumed;
+                write(connection);
+            }
+        }
+    }
+}
@@ -0,0 +1,98 @@
+//
+//  MockServer.h
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#ifndef SNOWCRASH_MOCKSERVER_H
+#define SNOWCRASH_MOCKSERVER_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include "Blueprint.h"
+#include "Router.h"
+
+namespace snowcrash {
+
+    //
+    // Loopback HTTP server answering requests with responses of a blueprint
+    //
+    // Complete response bytes are built once for every resource method using
+    // its first response (status code from the response name, headers & body).
+    // Requests are routed by URI templates of the blueprint. Connection buffers
+    // are allocated when a connection is accepted and reused for all requests
+    // on it, serving a request does not allocate.
+    //
+    // Linux only, uses epoll.
+    //
+    class MockServer {
+    public:
+        // Size of connection input buffer, longer request heads are rejected
+        static const size_t InputBufferSize; // = 16KB
+
+        // The blueprint must outlive the server
+        explicit MockServer(const Blueprint& blueprint);
+        ~MockServer();
+
+        // Listen on a loopback port, 0 picks a free port.
+        // Returns false and sets error on failure.
+        bool listen(unsigned short port, std::string& error);
+
+        // Port the server listens on
+        unsigned short port() const;
+
+        // Serve requests until stop() is called.
+        // Returns false and sets error on failure.
+        bool run(std::string& error);
+
+        // Stop serving, can be called from a signal handler
+        void stop();
+
+        // Build response bytes of a method
+        static void BuildResponse(const Method& method, std::string& response);
+
+    private:
+        struct Connection {
+            int fd;
+            std::vector<char> input;
+            size_t inputLength;
+            size_t discard;         // request body bytes to skip
+            std::string output;
+            size_t outputOffset;
+            bool waiting;           // waiting until writable
+            bool closing;
+        };
+
+        Router m_router;
+        std::map<const Method*, std::string> m_responses;
+        std::string m_notFound;
+        std::string m_methodNotAllowed;
+        std::string m_badRequest;
+        RouteMatch m_match;
+
+        int m_listener;
+        int m_epoll;
+        unsigned short m_port;
+        volatile bool m_running;
+        std::vector<Connection*> m_connections; // by file descriptor
+
+        void accept();
+        void read(Connection& connection);
+        void write(Connection& connection);
+        void close(Connection& connection);
+
+        // Handle complete requests in the input buffer, returns consumed bytes
+        size_t process(Connection& connection);
+
+        // Response for a request
+        const std::string& respond(const char* method, size_t methodLength,
+                                   const char* path, size_t pathLength);
+
+        MockServer(const MockServer&);
+        MockServer& operator=(const MockServer&);
+    };
+}
+
+#endif
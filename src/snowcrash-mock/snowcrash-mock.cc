@@ -0,0 +1,99 @@
+//
+//  snowcrash-mock.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <csignal>
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include "snowcrash.h"
+#include "MockServer.h"
+#include "cmdline.h"
+
+using snowcrash::Error;
+using snowcrash::MockServer;
+
+static const std::string PortArgument = "port";
+
+// Default port of the mock server
+static const int DefaultPort = 8080;
+
+// Server stopped on SIGINT & SIGTERM
+static MockServer* RunningServer = NULL;
+
+static void HandleSignal(int)
+{
+    if (RunningServer)
+        RunningServer->stop();
+}
+
+int main(int argc, const char *argv[])
+{
+    cmdline::parser argumentParser;
+
+    argumentParser.set_program_name("snowcrash-mock");
+    std::stringstream ss;
+    ss << "<input file>\n\n";
+    ss << "API Blueprint Mock Server\n";
+    ss << "Serves responses of the blueprint on a loopback port.\n";
+    argumentParser.footer(ss.str());
+
+    argumentParser.add<int>(PortArgument, 'p', "port to listen on", false, DefaultPort, cmdline::range(0, 65535));
+    argumentParser.add("help", 'h', "display this help message");
+
+    argumentParser.parse_check(argc, argv);
+    if (argumentParser.rest().size() != 1) {
+        std::cerr << "one input file expected, got " << argumentParser.rest().size() << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    // Input
+    std::stringstream inputStream;
+    std::ifstream inputFileStream;
+    std::string inputFileName = argumentParser.rest().front();
+    inputFileStream.open(inputFileName.c_str());
+    if (!inputFileStream.is_open()) {
+        std::cerr << "fatal: unable to open input file `" << inputFileName << "`\n";
+        exit(EXIT_FAILURE);
+    }
+
+    inputStream << inputFileStream.rdbuf();
+    inputFileStream.close();
+
+    // Parse
+    snowcrash::Result result;
+    snowcrash::Blueprint blueprint;
+    snowcrash::parse(inputStream.str(), 0, result, blueprint);
+
+    for (snowcrash::Warnings::const_iterator it = result.warnings.begin(); it != result.warnings.end(); ++it) {
+        std::cerr << "warning: " << it->message << std::endl;
+    }
+
+    if (result.error.code != Error::OK) {
+        std::cerr << "error: (" << result.error.code << ") " << result.error.message << std::endl;
+        exit(result.error.code);
+    }
+
+    // Serve
+    MockServer server(blueprint);
+    std::string error;
+    if (!server.listen(static_cast<unsigned short>(argumentParser.get<int>(PortArgument)), error)) {
+        std::cerr << "fatal: " << error << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    RunningServer = &server;
+    std::signal(SIGINT, HandleSignal);
+    std::signal(SIGTERM, HandleSignal);
+
+    std::cerr << "listening on 127.0.0.1:" << server.port() << std::endl;
+    if (!server.run(error)) {
+        std::cerr << "fatal: " << error << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -10,8 +10,27 @@
 
 using namespace snowcrash;
 
-void snowcrash::parse(const SourceData& source, BlueprintParserOptions options, Result& result, Blueprint& blueprint)
+void snowcrash::parse(const SourceData& source,
+                      BlueprintParserOptions options,
+                      Result& result,
+                      Blueprint& blueprint,
+                      BlueprintParserDelegate* delegate,
+                      ParserStatistics* statistics,
+                      Trace* trace,
+                      const ParserBudget* budget)
 {
     Parser p;
-    p.parse(source, options, result, blueprint);
+    p.parse(source, options, result, blueprint, delegate, statistics, trace, budget);
+}
+
+void snowcrash::validate(const SourceData& source,
+                         BlueprintParserOptions options,
+                         Result& result,
+                         ParserStatistics* statistics,
+                         Trace* trace,
+                         const ParserBudget* budget)
+{
+    Blueprint blueprint;
+    Parser p;
+    p.parse(source, options | ValidateOnlyOption, result, blueprint, NULL, statistics, trace, budget);
 }
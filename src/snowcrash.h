@@ -10,11 +10,28 @@
 #define SNOWCRASH_H
 
 #include "Parser.h"
+#include "Version.h"
 
 namespace snowcrash {
     
     // Convenience wrapper for Parser's parse method
-    void parse(const SourceData& source, BlueprintParserOptions options, Result& result, Blueprint& blueprint);
+    void parse(const SourceData& source,
+               BlueprintParserOptions options,
+               Result& result,
+               Blueprint& blueprint,
+               BlueprintParserDelegate* delegate = NULL,
+               ParserStatistics* statistics = NULL,
+               Trace* trace = NULL,
+               const ParserBudget* budget = NULL);
+    
+    // Check source data, reporting the same result as parse() would,
+    // without building the AST, see ValidateOnlyOption
+    void validate(const SourceData& source,
+                  BlueprintParserOptions options,
+                  Result& result,
+                  ParserStatistics* statistics = NULL,
+                  Trace* trace = NULL,
+                  const ParserBudget* budget = NULL);
 }
 
 #endif
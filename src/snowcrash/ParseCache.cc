@@ -0,0 +1,317 @@
+//
+//  ParseCache.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <stdint.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "ParseCache.h"
+#include "ParseOutput.h"
+
+#if defined(_WIN32)
+#   include <windows.h>
+#   include <direct.h>
+#   include <process.h>
+#   include <sys/utime.h>
+#   define getpid _getpid
+#else
+#   include <dirent.h>
+#   include <unistd.h>
+#   include <utime.h>
+#endif
+
+using namespace snowcrash;
+
+const size_t ParseCache::DefaultSizeLimit = 64 * 1024 * 1024;
+
+// Entry file signature
+static const std::string EntrySignature = "SNOWCRASH-CACHE 1";
+
+//
+// MurmurHash3, x64 128-bit variant
+// Credits: Austin Appleby, public domain
+//
+static inline uint64_t Rotl64(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t Fmix64(uint64_t k)
+{
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+static void MurmurHash128(const void* key, size_t length, uint64_t seed, uint64_t out[2])
+{
+    const uint8_t* data = static_cast<const uint8_t*>(key);
+    const size_t blocks = length / 16;
+    const uint64_t c1 = 0x87c37b91114253d5ULL;
+    const uint64_t c2 = 0x4cf5ad432745937fULL;
+
+    uint64_t h1 = seed;
+    uint64_t h2 = seed;
+
+    for (size_t i = 0; i < blocks; ++i) {
+        uint64_t k1, k2;
+        ::memcpy(&k1, data + i * 16, sizeof(k1));
+        ::memcpy(&k2, data + i * 16 + 8, sizeof(k2));
+
+        k1 *= c1; k1 = Rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+        h1 = Rotl64(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+
+        k2 *= c2; k2 = Rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+        h2 = Rotl64(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    const uint8_t* tail = data + blocks * 16;
+    uint64_t k1 = 0;
+    uint64_t k2 = 0;
+    size_t remaining = length & 15;
+
+    for (size_t i = remaining; i > 8; --i)
+        k2 ^= static_cast<uint64_t>(tail[i - 1]) << ((i - 9) * 8);
+
+    if (remaining > 8) {
+        k2 *= c2; k2 = Rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+    }
+
+    for (size_t i = std::min(remaining, static_cast<size_t>(8)); i > 0; --i)
+        k1 ^= static_cast<uint64_t>(tail[i - 1]) << ((i - 1) * 8);
+
+    if (remaining > 0) {
+        k1 *= c1; k1 = Rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+    }
+
+    h1 ^= length;
+    h2 ^= length;
+    h1 += h2;
+    h2 += h1;
+    h1 = Fmix64(h1);
+    h2 = Fmix64(h2);
+    h1 += h2;
+    h2 += h1;
+
+    out[0] = h1;
+    out[1] = h2;
+}
+
+// Cache entry file information
+struct CacheEntry {
+    std::string path;
+    size_t size;
+    time_t accessed;
+
+    bool operator<(const CacheEntry& rhs) const {
+        return accessed < rhs.accessed;
+    }
+};
+
+// True if the file name is an entry key, 32 hex digits, see ParseCache::Key()
+static bool IsEntryName(const std::string& name)
+{
+    if (name.length() != 32)
+        return false;
+
+    for (std::string::const_iterator it = name.begin(); it != name.end(); ++it) {
+        if (!((*it >= '0' && *it <= '9') || (*it >= 'a' && *it <= 'f')))
+            return false;
+    }
+
+    return true;
+}
+
+// True if the file starts with the entry signature
+static bool HasEntrySignature(const std::string& path)
+{
+    std::ifstream is(path.c_str(), std::ios::binary);
+    std::string signature;
+    return is.is_open() && std::getline(is, signature) && signature == EntrySignature;
+}
+
+// List entry files in a directory. Files not named by a key or not starting
+// with the entry signature are left out, they are never counted nor removed.
+static void ListEntries(const std::string& directory, std::vector<CacheEntry>& entries)
+{
+#if defined(_WIN32)
+    WIN32_FIND_DATAA data;
+    HANDLE find = ::FindFirstFileA((directory + "\\*").c_str(), &data);
+    if (find == INVALID_HANDLE_VALUE)
+        return;
+
+    do {
+        if ((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) || !IsEntryName(data.cFileName))
+            continue;
+
+        std::string path = directory + "/" + data.cFileName;
+        struct _stat info;
+        if (::_stat(path.c_str(), &info) != 0 || !HasEntrySignature(path))
+            continue;
+
+        CacheEntry entry;
+        entry.path = path;
+        entry.size = static_cast<size_t>(info.st_size);
+        entry.accessed = info.st_mtime;
+        entries.push_back(entry);
+
+    } while (::FindNextFileA(find, &data));
+
+    ::FindClose(find);
+#else
+    DIR* dir = ::opendir(directory.c_str());
+    if (!dir)
+        return;
+
+    while (struct dirent* item = ::readdir(dir)) {
+        if (!IsEntryName(item->d_name))
+            continue;
+
+        std::string path = directory + "/" + item->d_name;
+        struct stat info;
+        if (::stat(path.c_str(), &info) != 0 || !S_ISREG(info.st_mode) || !HasEntrySignature(path))
+            continue;
+
+        CacheEntry entry;
+        entry.path = path;
+        entry.size = static_cast<size_t>(info.st_size);
+        entry.accessed = info.st_mtime;
+        entries.push_back(entry);
+    }
+
+    ::closedir(dir);
+#endif
+}
+
+ParseCache::ParseCache(const std::string& directory, size_t sizeLimit)
+: m_directory(directory), m_sizeLimit(sizeLimit)
+{
+}
+
+std::string ParseCache::Key(const SourceData& source,
+                            BlueprintParserOptions options,
+                            const std::string& format)
+{
+    uint64_t sourceHash[2];
+    MurmurHash128(source.data(), source.length(), 0, sourceHash);
+
+    std::stringstream ss;
+    ss << SNOWCRASH_VERSION_STRING << "\n" << options << "\n" << format << "\n";
+    ss.write(reinterpret_cast<const char*>(sourceHash), sizeof(sourceHash));
+
+    std::string keyData = ss.str();
+    uint64_t keyHash[2];
+    MurmurHash128(keyData.data(), keyData.length(), 0, keyHash);
+
+    char hex[33];
+    ::sprintf(hex, "%016llx%016llx",
+              static_cast<unsigned long long>(keyHash[0]),
+              static_cast<unsigned long long>(keyHash[1]));
+    return std::string(hex);
+}
+
+std::string ParseCache::entryPath(const std::string& key) const
+{
+    return m_directory + "/" + key;
+}
+
+bool ParseCache::fetch(const std::string& key, std::string& output, Result& result)
+{
+    std::string path = entryPath(key);
+    std::ifstream is(path.c_str(), std::ios::binary);
+    if (!is.is_open())
+        return false;
+
+    std::string signature;
+    if (!std::getline(is, signature) || signature != EntrySignature)
+        return false;
+
+    Result entryResult;
+    std::string entryOutput;
+    if (!ReadParseOutput(is, entryOutput, entryResult))
+        return false;
+
+    is.close();
+
+    // Mark the entry as recently used
+    ::utime(path.c_str(), NULL);
+
+    output.swap(entryOutput);
+    result = entryResult;
+    return true;
+}
+
+bool ParseCache::store(const std::string& key, const std::string& output, const Result& result)
+{
+#if defined(_WIN32)
+    ::_mkdir(m_directory.c_str());
+#else
+    ::mkdir(m_directory.c_str(), 0755);
+#endif
+
+    std::string path = entryPath(key);
+    std::stringstream tmp;
+    tmp << path << ".tmp" << ::getpid();
+    std::string tmpPath = tmp.str();
+
+    std::ofstream os(tmpPath.c_str(), std::ios::binary);
+    if (!os.is_open())
+        return false;
+
+    os << EntrySignature << "\n";
+    WriteParseOutput(output, result, os);
+    os.close();
+
+    if (!os) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+
+    // Publish the entry atomically
+#if defined(_WIN32)
+    std::remove(path.c_str());
+#endif
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+
+    evict();
+    return true;
+}
+
+void ParseCache::evict()
+{
+    std::vector<CacheEntry> entries;
+    ListEntries(m_directory, entries);
+
+    size_t total = 0;
+    for (std::vector<CacheEntry>::const_iterator it = entries.begin(); it != entries.end(); ++it) {
+        total += it->size;
+    }
+
+    if (total <= m_sizeLimit)
+        return;
+
+    // Least recently used first
+    std::sort(entries.begin(), entries.end());
+    for (std::vector<CacheEntry>::const_iterator it = entries.begin();
+         it != entries.end() && total > m_sizeLimit;
+         ++it) {
+
+        if (std::remove(it->path.c_str()) == 0)
+            total -= it->size;
+    }
+}
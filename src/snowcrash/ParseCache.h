@@ -0,0 +1,57 @@
+//
+//  ParseCache.h
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#ifndef SNOWCRASH_PARSECACHE_H
+#define SNOWCRASH_PARSECACHE_H
+
+#include <string>
+#include "snowcrash.h"
+
+namespace snowcrash {
+
+    //
+    // Content-addressed cache of parser output
+    //
+    // Every entry is a single file named by the hash of its key. An entry holds
+    // the parser result (error & warnings) and the serialized AST. Recently used
+    // entries are kept, least recently used ones are evicted once the entries
+    // grow over the size limit. File modification time is used as access time.
+    // Only files named by a key and starting with the entry signature count as
+    // entries, other files in the directory are never touched.
+    //
+    class ParseCache {
+    public:
+        // Default cache size limit
+        static const size_t DefaultSizeLimit; // = 64MB
+
+        ParseCache(const std::string& directory, size_t sizeLimit = DefaultSizeLimit);
+
+        // Compute an entry key of given source, parser options, and output format.
+        // The key covers the library version too.
+        static std::string Key(const SourceData& source,
+                               BlueprintParserOptions options,
+                               const std::string& format);
+
+        // Retrieve an entry, returns true on hit, false otherwise
+        bool fetch(const std::string& key, std::string& output, Result& result);
+
+        // Store an entry, returns true on success, false otherwise
+        bool store(const std::string& key, const std::string& output, const Result& result);
+
+    private:
+        std::string m_directory;
+        size_t m_sizeLimit;
+
+        // Path to an entry file
+        std::string entryPath(const std::string& key) const;
+
+        // Remove least recently used entries over the size limit
+        void evict();
+    };
+}
+
+#endif
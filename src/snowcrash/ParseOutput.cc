@@ -0,0 +1,84 @@
+//
+//  ParseOutput.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include "ParseOutput.h"
+
+using namespace snowcrash;
+
+// Write source annotation
+static void WriteAnnotation(const SourceAnnotation& annotation, std::ostream& os)
+{
+    os << annotation.code << " " << annotation.location.size();
+    for (SourceDataBlock::const_iterator it = annotation.location.begin(); it != annotation.location.end(); ++it) {
+        os << " " << it->location << " " << it->length;
+    }
+    os << " " << annotation.message.length() << "\n" << annotation.message << "\n";
+}
+
+// Read source annotation
+static bool ReadAnnotation(std::istream& is, SourceAnnotation& annotation)
+{
+    size_t count = 0;
+    if (!(is >> annotation.code >> count))
+        return false;
+
+    annotation.location.clear();
+    for (size_t i = 0; i < count; ++i) {
+        SourceDataRange range;
+        if (!(is >> range.location >> range.length))
+            return false;
+        annotation.location.push_back(range);
+    }
+
+    size_t length = 0;
+    if (!(is >> length) || is.get() != '\n')
+        return false;
+
+    annotation.message.resize(length);
+    if (length && !is.read(&annotation.message[0], length))
+        return false;
+
+    return is.get() == '\n';
+}
+
+void snowcrash::WriteParseOutput(const std::string& output, const Result& result, std::ostream& os)
+{
+    WriteAnnotation(result.error, os);
+    os << result.warnings.size() << "\n";
+    for (Warnings::const_iterator it = result.warnings.begin(); it != result.warnings.end(); ++it) {
+        WriteAnnotation(*it, os);
+    }
+    os << output.length() << "\n";
+    os.write(output.data(), output.length());
+}
+
+bool snowcrash::ReadParseOutput(std::istream& is, std::string& output, Result& result)
+{
+    Result parsedResult;
+    size_t warnings = 0;
+    if (!ReadAnnotation(is, parsedResult.error) || !(is >> warnings))
+        return false;
+
+    for (size_t i = 0; i < warnings; ++i) {
+        Warning warning;
+        if (!ReadAnnotation(is, warning))
+            return false;
+        parsedResult.warnings.push_back(warning);
+    }
+
+    size_t length = 0;
+    if (!(is >> length) || is.get() != '\n')
+        return false;
+
+    std::string parsedOutput(length, '\0');
+    if (length && !is.read(&parsedOutput[0], length))
+        return false;
+
+    output.swap(parsedOutput);
+    result = parsedResult;
+    return true;
+}
@@ -0,0 +1,30 @@
+//
+//  ParseOutput.h
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#ifndef SNOWCRASH_PARSEOUTPUT_H
+#define SNOWCRASH_PARSEOUTPUT_H
+
+#include <string>
+#include <istream>
+#include <ostream>
+#include "snowcrash.h"
+
+namespace snowcrash {
+
+    //
+    // Parser output encoding
+    //
+    // The parser result (error & warnings) followed by the serialized AST,
+    // as stored in cache entries and sent by the parse daemon.
+    //
+    void WriteParseOutput(const std::string& output, const Result& result, std::ostream& os);
+
+    // Decode parser output, returns true on success, false otherwise
+    bool ReadParseOutput(std::istream& is, std::string& output, Result& result);
+}
+
+#endif
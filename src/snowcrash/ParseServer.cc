@@ -0,0 +1,480 @@
+//
+//  ParseServer.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <sstream>
+#include <vector>
+#include "ParseServer.h"
+#include "ParseOutput.h"
+#include "Thread.h"
+
+#if !defined(_WIN32)
+#   include <csignal>
+#   include <poll.h>
+#   include <pthread.h>
+#   include <sys/socket.h>
+#   include <sys/time.h>
+#   include <sys/un.h>
+#   include <unistd.h>
+#endif
+
+using namespace snowcrash;
+
+void snowcrash::EncodeParseFrameLength(size_t length, unsigned char prefix[ParseFramePrefixSize])
+{
+    prefix[0] = static_cast<unsigned char>(length >> 24);
+    prefix[1] = static_cast<unsigned char>(length >> 16);
+    prefix[2] = static_cast<unsigned char>(length >> 8);
+    prefix[3] = static_cast<unsigned char>(length);
+}
+
+size_t snowcrash::DecodeParseFrameLength(const unsigned char prefix[ParseFramePrefixSize])
+{
+    return (static_cast<size_t>(prefix[0]) << 24) |
+           (static_cast<size_t>(prefix[1]) << 16) |
+           (static_cast<size_t>(prefix[2]) << 8) |
+           static_cast<size_t>(prefix[3]);
+}
+
+std::string snowcrash::EncodeParseRequest(const ParseRequest& request)
+{
+    std::stringstream ss;
+    ss << request.options << "\n" << request.format << "\n" << request.source;
+    return ss.str();
+}
+
+bool snowcrash::DecodeParseRequest(const std::string& payload, ParseRequest& request)
+{
+    size_t optionsEnd = payload.find('\n');
+    if (optionsEnd == std::string::npos)
+        return false;
+
+    size_t formatEnd = payload.find('\n', optionsEnd + 1);
+    if (formatEnd == std::string::npos)
+        return false;
+
+    std::stringstream options(payload.substr(0, optionsEnd));
+    if (!(options >> request.options))
+        return false;
+
+    request.format = payload.substr(optionsEnd + 1, formatEnd - optionsEnd - 1);
+    request.source = payload.substr(formatEnd + 1);
+    return true;
+}
+
+#if defined(_WIN32)
+
+bool snowcrash::ServeParseRequests(const std::string& socketPath,
+                                   FormatSerializer serializer,
+                                   std::string& error)
+{
+    error = "parse daemon is not supported on this platform";
+    return false;
+}
+
+bool snowcrash::RequestParse(const std::string& socketPath,
+                             const ParseRequest& request,
+                             std::string& output,
+                             Result& result,
+                             std::string& error)
+{
+    error = "parse daemon is not supported on this platform";
+    return false;
+}
+
+#else
+
+// Seconds a connection may stall in a read or write
+static const int ConnectionTimeout = 30;
+
+// Least number of worker threads, a stalled connection must not stop the daemon
+static const size_t MinWorkerThreads = 2;
+
+// Do not raise SIGPIPE writing to a closed connection
+#if defined(MSG_NOSIGNAL)
+static const int SendFlags = MSG_NOSIGNAL;
+#else
+static const int SendFlags = 0;
+#endif
+
+// Set by the signal handler to stop serving
+static volatile sig_atomic_t s_stop = 0;
+
+static void StopServing(int)
+{
+    s_stop = 1;
+}
+
+// Read exactly `length` bytes, returns false on error or end of stream
+static bool ReadAll(int fd, char* data, size_t length)
+{
+    while (length) {
+        ssize_t n = ::read(fd, data, length);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+
+        data += n;
+        length -= n;
+    }
+
+    return true;
+}
+
+// Write exactly `length` bytes, returns false on error
+static bool WriteAll(int fd, const char* data, size_t length)
+{
+    while (length) {
+        ssize_t n = ::send(fd, data, length, SendFlags);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+
+        data += n;
+        length -= n;
+    }
+
+    return true;
+}
+
+// Read a length-prefixed frame
+static bool ReadFrame(int fd, std::string& payload)
+{
+    unsigned char prefix[ParseFramePrefixSize];
+    if (!ReadAll(fd, reinterpret_cast<char*>(prefix), sizeof(prefix)))
+        return false;
+
+    size_t length = DecodeParseFrameLength(prefix);
+    if (length > MaxParsePayloadSize)
+        return false;
+
+    payload.resize(length);
+    return !length || ReadAll(fd, &payload[0], length);
+}
+
+// Write a length-prefixed frame
+static bool WriteFrame(int fd, const std::string& payload)
+{
+    if (payload.length() > MaxParsePayloadSize)
+        return false;
+
+    unsigned char prefix[ParseFramePrefixSize];
+    EncodeParseFrameLength(payload.length(), prefix);
+
+    return WriteAll(fd, reinterpret_cast<const char*>(prefix), sizeof(prefix)) &&
+           WriteAll(fd, payload.data(), payload.length());
+}
+
+// Fill in a socket address, returns false if the path does not fit
+static bool SocketAddress(const std::string& socketPath, struct sockaddr_un& address)
+{
+    ::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.empty() || socketPath.length() >= sizeof(address.sun_path))
+        return false;
+
+    ::memcpy(address.sun_path, socketPath.c_str(), socketPath.length() + 1);
+    return true;
+}
+
+// Connect to a socket, returns the descriptor or -1 on error
+static int Connect(const std::string& socketPath)
+{
+    struct sockaddr_un address;
+    if (!SocketAddress(socketPath, address))
+        return -1;
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+
+    if (::connect(fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+// Limit the time a connection may stall, do not raise SIGPIPE on it
+static void ConfigureConnection(int fd)
+{
+#if defined(SO_NOSIGPIPE)
+    int noSignal = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &noSignal, sizeof(noSignal));
+#endif
+
+    struct timeval timeout;
+    timeout.tv_sec = ConnectionTimeout;
+    timeout.tv_usec = 0;
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+}
+
+// Read a request from the connection, parse it and write the response
+static void HandleConnection(int fd, FormatSerializer serializer)
+{
+    ConfigureConnection(fd);
+
+    std::string payload;
+    if (!ReadFrame(fd, payload))
+        return;
+
+    Result result;
+    std::string output;
+    ParseRequest request;
+    if (DecodeParseRequest(payload, request)) {
+        if (request.format.empty()) {
+            validate(request.source, request.options, result);
+        }
+        else {
+            Blueprint blueprint;
+            parse(request.source, request.options, result, blueprint);
+
+            std::stringstream serialization;
+            serializer(blueprint, request.format, serialization);
+            output = serialization.str();
+        }
+    }
+    else {
+        result.error = Error("invalid parse request", 1);
+    }
+
+    std::stringstream response;
+    WriteParseOutput(output, result, response);
+    WriteFrame(fd, response.str());
+}
+
+//
+// Queue of accepted connections
+//
+// Filled by the accepting thread, drained by the worker threads.
+// Connections still queued when the queue is closed are dropped.
+//
+class ConnectionQueue {
+public:
+    ConnectionQueue() : m_closed(false) {
+        pthread_mutex_init(&m_mutex, NULL);
+        pthread_cond_init(&m_available, NULL);
+    }
+
+    ~ConnectionQueue() {
+        for (std::deque<int>::iterator it = m_connections.begin(); it != m_connections.end(); ++it)
+            ::close(*it);
+
+        pthread_cond_destroy(&m_available);
+        pthread_mutex_destroy(&m_mutex);
+    }
+
+    // Queue an accepted connection
+    void push(int fd) {
+        pthread_mutex_lock(&m_mutex);
+        m_connections.push_back(fd);
+        pthread_mutex_unlock(&m_mutex);
+        pthread_cond_signal(&m_available);
+    }
+
+    // Wait for a connection, returns -1 once the queue is closed
+    int pop() {
+        pthread_mutex_lock(&m_mutex);
+        while (!m_closed && m_connections.empty())
+            pthread_cond_wait(&m_available, &m_mutex);
+
+        int fd = -1;
+        if (!m_closed) {
+            fd = m_connections.front();
+            m_connections.pop_front();
+        }
+        pthread_mutex_unlock(&m_mutex);
+
+        return fd;
+    }
+
+    // Stop handing out connections, wakes up all waiting workers
+    void close() {
+        pthread_mutex_lock(&m_mutex);
+        m_closed = true;
+        pthread_mutex_unlock(&m_mutex);
+        pthread_cond_broadcast(&m_available);
+    }
+
+private:
+    pthread_mutex_t m_mutex;        // guards the fields below
+    pthread_cond_t m_available;     // signaled when a connection is queued or closing
+    std::deque<int> m_connections;
+    bool m_closed;
+
+    ConnectionQueue(const ConnectionQueue&);
+    ConnectionQueue& operator=(const ConnectionQueue&);
+};
+
+// Worker thread state
+struct ConnectionWorker {
+    ConnectionQueue* queue;
+    FormatSerializer serializer;
+
+    // Worker thread entry point, handles connections until the queue is closed
+    static void* run(void* context) {
+        ConnectionWorker* worker = static_cast<ConnectionWorker*>(context);
+
+        int fd;
+        while ((fd = worker->queue->pop()) >= 0) {
+            HandleConnection(fd, worker->serializer);
+            ::close(fd);
+        }
+
+        return NULL;
+    }
+};
+
+// Bind and listen on a socket, replacing a stale socket file.
+// Returns the descriptor or -1 on error and sets the error message.
+static int Listen(const std::string& socketPath, std::string& error)
+{
+    struct sockaddr_un address;
+    if (!SocketAddress(socketPath, address)) {
+        error = "invalid socket path `" + socketPath + "`";
+        return -1;
+    }
+
+    // A socket nobody listens on is a leftover
+    int existing = Connect(socketPath);
+    if (existing >= 0) {
+        ::close(existing);
+        error = "socket `" + socketPath + "` is already being served";
+        return -1;
+    }
+    ::unlink(socketPath.c_str());
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        error = std::string("unable to create socket: ") + ::strerror(errno);
+        return -1;
+    }
+
+    if (::bind(fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(fd, SOMAXCONN) != 0) {
+        error = "unable to listen on `" + socketPath + "`: " + ::strerror(errno);
+        ::close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+bool snowcrash::ServeParseRequests(const std::string& socketPath,
+                                   FormatSerializer serializer,
+                                   std::string& error)
+{
+    int listener = Listen(socketPath, error);
+    if (listener < 0)
+        return false;
+
+    s_stop = 0;
+
+    // Keep the stop signals off the worker threads,
+    // only the accepting thread is to be interrupted
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, NULL);
+
+    ConnectionQueue queue;
+    ConnectionWorker worker;
+    worker.queue = &queue;
+    worker.serializer = serializer;
+
+    size_t threadCount = std::max(ThreadPool::HardwareConcurrency(), MinWorkerThreads);
+    std::vector<pthread_t> threads;
+    for (size_t i = 0; i < threadCount; ++i) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, ConnectionWorker::run, &worker) == 0)
+            threads.push_back(thread);
+    }
+
+    struct sigaction action, previousInterrupt, previousTerminate;
+    ::memset(&action, 0, sizeof(action));
+    action.sa_handler = StopServing;
+    sigemptyset(&action.sa_mask);
+    ::sigaction(SIGINT, &action, &previousInterrupt);
+    ::sigaction(SIGTERM, &action, &previousTerminate);
+    pthread_sigmask(SIG_UNBLOCK, &signals, NULL);
+
+    bool success = true;
+    if (threads.empty()) {
+        error = "unable to start worker threads";
+        success = false;
+    }
+
+    while (success && !s_stop) {
+
+        int fd = ::accept(listener, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+
+            error = std::string("unable to accept connection: ") + ::strerror(errno);
+            success = false;
+            break;
+        }
+
+        queue.push(fd);
+    }
+
+    // Let the workers finish the connections in progress
+    queue.close();
+    for (std::vector<pthread_t>::iterator it = threads.begin(); it != threads.end(); ++it)
+        pthread_join(*it, NULL);
+
+    ::sigaction(SIGINT, &previousInterrupt, NULL);
+    ::sigaction(SIGTERM, &previousTerminate, NULL);
+
+    ::close(listener);
+    ::unlink(socketPath.c_str());
+    return success;
+}
+
+bool snowcrash::RequestParse(const std::string& socketPath,
+                             const ParseRequest& request,
+                             std::string& output,
+                             Result& result,
+                             std::string& error)
+{
+    int fd = Connect(socketPath);
+    if (fd < 0) {
+        error = "unable to connect to `" + socketPath + "`";
+        return false;
+    }
+
+    ConfigureConnection(fd);
+
+    std::string payload;
+    bool success = WriteFrame(fd, EncodeParseRequest(request)) && ReadFrame(fd, payload);
+    ::close(fd);
+
+    if (!success) {
+        error = "no response from `" + socketPath + "`";
+        return false;
+    }
+
+    std::stringstream response(payload);
+    if (!ReadParseOutput(response, output, result)) {
+        error = "invalid response from `" + socketPath + "`";
+        return false;
+    }
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,77 @@
+//
+//  ParseServer.h
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#ifndef SNOWCRASH_PARSESERVER_H
+#define SNOWCRASH_PARSESERVER_H
+
+#include <string>
+#include "snowcrash.h"
+#include "SplitOutput.h"
+
+namespace snowcrash {
+
+    //
+    // Parse daemon
+    //
+    // Serves parse requests on a Unix domain socket, saving the process
+    // startup and static initialization of a `snowcrash` invocation.
+    // A connection carries a single request and its response, both framed
+    // as a 4-byte big-endian payload length followed by the payload.
+    //
+    // Request payload:  <options>\n<format>\n<source>
+    // Response payload: parser output, see WriteParseOutput()
+    //
+    // An empty format validates the source only, the response carries no AST.
+    // Accepted connections are queued and handled by worker threads draining
+    // the queue, the accepting thread never waits for a connection to finish.
+    //
+
+    // Parse request
+    struct ParseRequest {
+        ParseRequest() : options(0) {}
+
+        BlueprintParserOptions options;
+        std::string format;
+        SourceData source;
+    };
+
+    // Largest request or response payload accepted
+    static const size_t MaxParsePayloadSize = 64 * 1024 * 1024;
+    
+    // Size of the frame length prefix in bytes
+    static const size_t ParseFramePrefixSize = 4;
+
+    // Encode payload length as a frame prefix
+    void EncodeParseFrameLength(size_t length, unsigned char prefix[ParseFramePrefixSize]);
+
+    // Decode payload length from a frame prefix
+    size_t DecodeParseFrameLength(const unsigned char prefix[ParseFramePrefixSize]);
+
+    // Encode a request payload
+    std::string EncodeParseRequest(const ParseRequest& request);
+
+    // Decode a request payload. Returns true on success, false otherwise.
+    bool DecodeParseRequest(const std::string& payload, ParseRequest& request);
+
+    // Serve parse requests until interrupted (SIGINT or SIGTERM).
+    // The socket file is replaced if stale and removed on exit.
+    // Returns true on clean shutdown, false otherwise and sets the error message.
+    bool ServeParseRequests(const std::string& socketPath,
+                            FormatSerializer serializer,
+                            std::string& error);
+
+    // Send a request to the daemon listening on the socket and wait for
+    // its response. Returns true on success, false otherwise and sets
+    // the error message.
+    bool RequestParse(const std::string& socketPath,
+                      const ParseRequest& request,
+                      std::string& output,
+                      Result& result,
+                      std::string& error);
+}
+
+#endif
@@ -0,0 +1,173 @@
+//
+//  SplitOutput.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "SplitOutput.h"
+#include "Thread.h"
+
+#if defined(_WIN32)
+#   include <direct.h>
+#endif
+
+using namespace snowcrash;
+
+// File name extension of an output format
+static std::string FormatExtension(const std::string& format)
+{
+    if (format == "json-compact")
+        return "json";
+
+    return format;
+}
+
+// Path of a file in the directory
+static std::string FilePath(const std::string& directory, const std::string& name)
+{
+    if (directory.empty())
+        return name;
+
+    char last = directory[directory.length() - 1];
+    if (last == '/' || last == '\\')
+        return directory + name;
+
+    return directory + "/" + name;
+}
+
+// Serialize a blueprint into a file, returns true on success, false otherwise
+static bool WriteFile(const Blueprint& blueprint,
+                      const std::string& path,
+                      const std::string& format,
+                      FormatSerializer serializer)
+{
+    std::ofstream os(path.c_str(), std::ios::out | std::ios::binary);
+    if (!os.is_open())
+        return false;
+
+    serializer(blueprint, format, os);
+    os.close();
+    return !os.fail();
+}
+
+namespace {
+
+    // Write of one resource group file
+    class WriteResourceGroupTask : public Task {
+    public:
+        WriteResourceGroupTask(const Blueprint& blueprint,
+                               const ResourceGroup& resourceGroup,
+                               const std::string& path,
+                               const std::string& format,
+                               FormatSerializer serializer)
+        : m_blueprint(blueprint),
+          m_resourceGroup(resourceGroup),
+          m_path(path),
+          m_format(format),
+          m_serializer(serializer),
+          m_succeeded(false) {}
+
+        virtual void run() {
+            Blueprint shard;
+            shard.name = m_blueprint.name;
+            shard.resourceGroups.push_back(m_resourceGroup);
+
+            m_succeeded = WriteFile(shard, m_path, m_format, m_serializer);
+        }
+
+        const std::string& path() const { return m_path; }
+        bool succeeded() const { return m_succeeded; }
+
+    private:
+        const Blueprint& m_blueprint;
+        const ResourceGroup& m_resourceGroup;
+        std::string m_path;
+        const std::string& m_format;
+        FormatSerializer m_serializer;
+        bool m_succeeded;
+    };
+}
+
+std::string snowcrash::SplitOutputFileName(size_t index, const std::string& format)
+{
+    std::stringstream ss;
+    ss << "group-" << std::setw(3) << std::setfill('0') << (index + 1) << "." << FormatExtension(format);
+    return ss.str();
+}
+
+std::string snowcrash::SplitOutputIndexFileName(const std::string& format)
+{
+    return "index." + FormatExtension(format);
+}
+
+bool snowcrash::WriteSplitOutput(const Blueprint& blueprint,
+                                 const std::string& directory,
+                                 const std::string& format,
+                                 FormatSerializer serializer,
+                                 std::string& error)
+{
+#if defined(_WIN32)
+    int status = ::_mkdir(directory.c_str());
+#else
+    int status = ::mkdir(directory.c_str(), 0755);
+#endif
+    if (status != 0 && errno != EEXIST) {
+        error = "unable to create directory `" + directory + "`: " + ::strerror(errno);
+        return false;
+    }
+
+    // Resource group files
+    std::vector<WriteResourceGroupTask> tasks;
+    tasks.reserve(blueprint.resourceGroups.size());
+    for (size_t i = 0; i < blueprint.resourceGroups.size(); ++i) {
+        tasks.push_back(WriteResourceGroupTask(blueprint,
+                                               blueprint.resourceGroups[i],
+                                               FilePath(directory, SplitOutputFileName(i, format)),
+                                               format,
+                                               serializer));
+    }
+
+    if (!tasks.empty()) {
+        std::vector<Task*> work;
+        for (std::vector<WriteResourceGroupTask>::iterator it = tasks.begin(); it != tasks.end(); ++it)
+            work.push_back(&*it);
+
+        ThreadPool pool(std::min(ThreadPool::HardwareConcurrency(), tasks.size()));
+        pool.run(work);
+    }
+
+    for (std::vector<WriteResourceGroupTask>::const_iterator it = tasks.begin(); it != tasks.end(); ++it) {
+        if (!it->succeeded()) {
+            error = "unable to write to file `" + it->path() + "`";
+            return false;
+        }
+    }
+
+    // Index, overview & resource groups without resources
+    Blueprint index;
+    index.metadata = blueprint.metadata;
+    index.name = blueprint.name;
+    index.description = blueprint.description;
+    index.resourceGroups.resize(blueprint.resourceGroups.size());
+    for (size_t i = 0; i < blueprint.resourceGroups.size(); ++i) {
+        index.resourceGroups[i].name = blueprint.resourceGroups[i].name;
+        index.resourceGroups[i].description = blueprint.resourceGroups[i].description;
+    }
+
+    std::string indexPath = FilePath(directory, SplitOutputIndexFileName(format));
+    if (!WriteFile(index, indexPath, format, serializer)) {
+        error = "unable to write to file `" + indexPath + "`";
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,47 @@
+//
+//  SplitOutput.h
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#ifndef SNOWCRASH_SPLITOUTPUT_H
+#define SNOWCRASH_SPLITOUTPUT_H
+
+#include <string>
+#include <ostream>
+#include "Blueprint.h"
+
+namespace snowcrash {
+
+    // Serialize a blueprint into given output format
+    typedef void (*FormatSerializer)(const Blueprint& blueprint, const std::string& format, std::ostream& os);
+
+    //
+    // Sharded AST output
+    //
+    // Writes an index file `index.<ext>` and a file per resource group
+    // `group-<n>.<ext>`, numbered from 1 in the order of the groups in the
+    // index. Every file is a serialized blueprint: the index holds the
+    // blueprint overview (metadata, name & description) and the list of
+    // resource groups (their names & descriptions), a group file holds the
+    // blueprint name and the complete resource group.
+    //
+    // Group files are written concurrently. The directory is created if
+    // it does not exist. Returns true on success, false otherwise and sets
+    // the error message.
+    //
+    bool WriteSplitOutput(const Blueprint& blueprint,
+                          const std::string& directory,
+                          const std::string& format,
+                          FormatSerializer serializer,
+                          std::string& error);
+
+    // Name of a resource group file, index is zero-based
+    std::string SplitOutputFileName(size_t index, const std::string& format);
+
+    // Name of the index file
+    std::string SplitOutputIndexFileName(const std::string& format);
+}
+
+#endif
@@ -0,0 +1,335 @@
+//
+//  Watch.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <sstream>
+#include "Watch.h"
+#include "Thread.h"
+
+#if defined(__linux__)
+#   include <cerrno>
+#   include <cstring>
+#   include <dirent.h>
+#   include <poll.h>
+#   include <sys/inotify.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+using namespace snowcrash;
+
+// Format a diagnostic line
+static std::string AnnotationLine(const std::string& path, const std::string& kind, const SourceAnnotation& annotation)
+{
+    std::stringstream ss;
+    ss << path << ": " << kind << ":";
+
+    if (annotation.code != SourceAnnotation::OK)
+        ss << " (" << annotation.code << ")";
+
+    if (!annotation.message.empty())
+        ss << " " << annotation.message;
+
+    for (SourceDataBlock::const_iterator it = annotation.location.begin(); it != annotation.location.end(); ++it) {
+        ss << ((it == annotation.location.begin()) ? " :" : ";");
+        ss << it->location << ":" << it->length;
+    }
+
+    return ss.str();
+}
+
+void snowcrash::DiagnosticLines(const std::string& path, const Result& result, std::vector<std::string>& lines)
+{
+    lines.clear();
+
+    if (result.error.code != Error::OK)
+        lines.push_back(AnnotationLine(path, "error", result.error));
+
+    for (Warnings::const_iterator it = result.warnings.begin(); it != result.warnings.end(); ++it)
+        lines.push_back(AnnotationLine(path, "warning", *it));
+
+    std::sort(lines.begin(), lines.end());
+}
+
+void snowcrash::WriteDiagnosticsDelta(const std::vector<std::string>& before,
+                                      const std::vector<std::string>& after,
+                                      std::ostream& os)
+{
+    std::vector<std::string> removed;
+    std::set_difference(before.begin(), before.end(), after.begin(), after.end(), std::back_inserter(removed));
+
+    std::vector<std::string> added;
+    std::set_difference(after.begin(), after.end(), before.begin(), before.end(), std::back_inserter(added));
+
+    for (std::vector<std::string>::const_iterator it = removed.begin(); it != removed.end(); ++it)
+        os << "- " << *it << "\n";
+
+    for (std::vector<std::string>::const_iterator it = added.begin(); it != added.end(); ++it)
+        os << "+ " << *it << "\n";
+}
+
+#if !defined(__linux__)
+
+bool snowcrash::WatchFiles(const WatchOptions& options, std::ostream& os, std::string& error)
+{
+    error = "watch mode is not supported on this platform";
+    return false;
+}
+
+#else
+
+// Milliseconds to wait for more events of a change, e.g. an editor saving
+// by writing a temporary file and moving it over the original
+static const int SettleTime = 5;
+
+// Directory watched for changes of some or all of its blueprint files
+struct WatchedDirectory {
+    WatchedDirectory() : all(false) {}
+
+    std::string path;
+    bool all;
+
+    // Watched files, by name
+    std::map<std::string, std::string> files;
+};
+
+// Path of a file in a directory
+static std::string JoinPath(const std::string& directory, const std::string& name)
+{
+    if (directory.empty() || directory == ".")
+        return name;
+
+    return (directory[directory.length() - 1] == '/') ? directory + name : directory + "/" + name;
+}
+
+// True if the file name has a blueprint extension
+static bool IsBlueprintFile(const std::string& name)
+{
+    std::string::size_type dot = name.rfind('.');
+    if (dot == std::string::npos)
+        return false;
+
+    std::string extension = name.substr(dot);
+    return extension == ".apib" || extension == ".md";
+}
+
+// Path of a changed file if it is watched, empty otherwise
+static std::string WatchedFilePath(const WatchedDirectory& directory, const std::string& name)
+{
+    std::map<std::string, std::string>::const_iterator it = directory.files.find(name);
+    if (it != directory.files.end())
+        return it->second;
+
+    if (directory.all && IsBlueprintFile(name))
+        return JoinPath(directory.path, name);
+
+    return std::string();
+}
+
+//
+// Task parsing a single file
+//
+class ParseFileTask : public Task {
+public:
+    ParseFileTask(const std::string& path, const WatchOptions& options)
+    : m_path(path), m_options(options), m_exists(false) {}
+
+    virtual void run() {
+        std::ifstream is(m_path.c_str(), std::ios::binary);
+        if (!is.is_open())
+            return;
+
+        std::stringstream source;
+        source << is.rdbuf();
+        m_exists = true;
+
+        Result result;
+        if (m_options.format.empty()) {
+            validate(source.str(), m_options.parserOptions, result);
+        }
+        else {
+            Blueprint blueprint;
+            parse(source.str(), m_options.parserOptions, result, blueprint);
+
+            std::stringstream serialization;
+            m_options.serializer(blueprint, m_options.format, serialization);
+            m_output = serialization.str();
+        }
+
+        DiagnosticLines(m_path, result, m_diagnostics);
+    }
+
+    const std::string& path() const { return m_path; }
+    bool exists() const { return m_exists; }
+    const std::vector<std::string>& diagnostics() const { return m_diagnostics; }
+    const std::string& output() const { return m_output; }
+
+private:
+    std::string m_path;
+    const WatchOptions& m_options;
+    bool m_exists;
+    std::vector<std::string> m_diagnostics;
+    std::string m_output;
+};
+
+// Parse changed files and write the diagnostics delta
+static void ParseChangedFiles(const std::set<std::string>& paths,
+                              const WatchOptions& options,
+                              ThreadPool& pool,
+                              std::map<std::string, std::vector<std::string> >& diagnostics,
+                              std::ostream& os)
+{
+    std::vector<Task*> tasks;
+    for (std::set<std::string>::const_iterator it = paths.begin(); it != paths.end(); ++it)
+        tasks.push_back(new ParseFileTask(*it, options));
+
+    pool.run(tasks);
+
+    for (std::vector<Task*>::iterator it = tasks.begin(); it != tasks.end(); ++it) {
+        ParseFileTask* task = static_cast<ParseFileTask*>(*it);
+
+        std::vector<std::string>& fileDiagnostics = diagnostics[task->path()];
+        WriteDiagnosticsDelta(fileDiagnostics, task->diagnostics(), os);
+        fileDiagnostics = task->diagnostics();
+
+        if (task->exists() && !options.outputPath.empty()) {
+            std::ofstream outputStream(options.outputPath.c_str(), std::ios::out | std::ios::binary);
+            outputStream << task->output();
+        }
+
+        delete task;
+    }
+
+    os.flush();
+}
+
+// Read available events, adding the watched files changed
+static bool ReadEvents(int fd,
+                       const std::map<int, WatchedDirectory>& directories,
+                       std::set<std::string>& changed)
+{
+    union {
+        struct inotify_event event;
+        char data[64 * 1024];
+    } buffer;
+
+    ssize_t length = ::read(fd, buffer.data, sizeof(buffer.data));
+    if (length < 0)
+        return errno == EINTR;
+
+    for (ssize_t offset = 0; offset < length; ) {
+        const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(buffer.data + offset);
+        offset += sizeof(struct inotify_event) + event->len;
+
+        std::map<int, WatchedDirectory>::const_iterator directory = directories.find(event->wd);
+        if (!event->len || directory == directories.end())
+            continue;
+
+        std::string path = WatchedFilePath(directory->second, event->name);
+        if (!path.empty())
+            changed.insert(path);
+    }
+
+    return true;
+}
+
+bool snowcrash::WatchFiles(const WatchOptions& options, std::ostream& os, std::string& error)
+{
+    if (!options.outputPath.empty() && options.paths.size() != 1) {
+        error = "output file expects a single watched file";
+        return false;
+    }
+
+    int fd = ::inotify_init();
+    if (fd < 0) {
+        error = std::string("unable to watch files: ") + ::strerror(errno);
+        return false;
+    }
+
+    // Watch directories rather than files to see files replaced by editors
+    const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE;
+    std::map<int, WatchedDirectory> directories;
+    std::set<std::string> files;
+
+    for (std::vector<std::string>::const_iterator it = options.paths.begin(); it != options.paths.end(); ++it) {
+
+        struct stat info;
+        bool isDirectory = (::stat(it->c_str(), &info) == 0 && S_ISDIR(info.st_mode));
+        if (isDirectory && !options.outputPath.empty()) {
+            error = "output file expects a single watched file";
+            ::close(fd);
+            return false;
+        }
+
+        std::string directoryPath = *it;
+        std::string name;
+        if (!isDirectory) {
+            std::string::size_type slash = it->rfind('/');
+            directoryPath = (slash == std::string::npos) ? "." : it->substr(0, slash + 1);
+            name = (slash == std::string::npos) ? *it : it->substr(slash + 1);
+        }
+
+        int wd = ::inotify_add_watch(fd, directoryPath.c_str(), mask);
+        if (wd < 0) {
+            error = "unable to watch `" + directoryPath + "`: " + ::strerror(errno);
+            ::close(fd);
+            return false;
+        }
+
+        WatchedDirectory& directory = directories[wd];
+        directory.path = directoryPath;
+
+        if (!isDirectory) {
+            directory.files[name] = *it;
+            files.insert(*it);
+            continue;
+        }
+
+        directory.all = true;
+        if (DIR* dir = ::opendir(directoryPath.c_str())) {
+            while (struct dirent* item = ::readdir(dir)) {
+                if (IsBlueprintFile(item->d_name))
+                    files.insert(JoinPath(directoryPath, item->d_name));
+            }
+            ::closedir(dir);
+        }
+    }
+
+    ThreadPool pool;
+    std::map<std::string, std::vector<std::string> > diagnostics;
+    ParseChangedFiles(files, options, pool, diagnostics, os);
+
+    for (;;) {
+
+        std::set<std::string> changed;
+        if (!ReadEvents(fd, directories, changed))
+            break;
+
+        // Coalesce the events of a change
+        struct pollfd waiting;
+        waiting.fd = fd;
+        waiting.events = POLLIN;
+        waiting.revents = 0;
+        while (::poll(&waiting, 1, SettleTime) > 0) {
+            if (!ReadEvents(fd, directories, changed))
+                break;
+        }
+
+        if (!changed.empty())
+            ParseChangedFiles(changed, options, pool, diagnostics, os);
+    }
+
+    error = std::string("unable to read file changes: ") + ::strerror(errno);
+    ::close(fd);
+    return false;
+}
+
+#endif
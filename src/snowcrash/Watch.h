@@ -0,0 +1,58 @@
+//
+//  Watch.h
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#ifndef SNOWCRASH_WATCH_H
+#define SNOWCRASH_WATCH_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include "snowcrash.h"
+#include "SplitOutput.h"
+
+namespace snowcrash {
+
+    //
+    // Watch mode
+    //
+    // Parses the blueprint files and keeps their diagnostics in the memory.
+    // Whenever a file is written, moved in or removed, only the changed files
+    // are parsed again, concurrently on a pool of worker threads, and only
+    // the diagnostics that appeared (`+`) or disappeared (`-`) are written.
+    // A directory covers the `.apib` and `.md` files directly within it.
+    //
+    struct WatchOptions {
+        WatchOptions() : parserOptions(0), serializer(NULL) {}
+
+        // Files & directories to watch
+        std::vector<std::string> paths;
+
+        BlueprintParserOptions parserOptions;
+
+        // AST output format & file rewritten on every change,
+        // none when empty. A single file is expected to be watched.
+        std::string format;
+        std::string outputPath;
+        FormatSerializer serializer;
+    };
+
+    // Watch files until interrupted, writing diagnostics delta to `os`.
+    // Uses inotify, available on Linux only. Returns false on error
+    // and sets the error message.
+    bool WatchFiles(const WatchOptions& options, std::ostream& os, std::string& error);
+
+    // Diagnostics lines of a parser result
+    void DiagnosticLines(const std::string& path, const Result& result, std::vector<std::string>& lines);
+
+    // Write lines present in one of the sorted diagnostics only,
+    // prefixed by `-` when removed and `+` when added
+    void WriteDiagnosticsDelta(const std::vector<std::string>& before,
+                               const std::vector<std::string>& after,
+                               std::ostream& os);
+}
+
+#endif
@@ -11,16 +11,47 @@
 #include <fstream>
 #include "snowcrash.h"
 #include "SerializeJSON.h"
+#include "SerializeMsgPack.h"
 #include "SerializeYAML.h"
+#include "ParseCache.h"
+#include "ParseServer.h"
+#include "SplitOutput.h"
+#include "Watch.h"
 #include "cmdline.h"
 
 using snowcrash::SourceAnnotation;
 using snowcrash::Error;
+using snowcrash::ParseCache;
 
 static const std::string OutputArgument = "output";
 static const std::string FormatArgument = "format";
 static const std::string RenderArgument = "render";
 static const std::string ValidateArgument = "validate";
+static const std::string CacheDirArgument = "cache-dir";
+static const std::string CacheSizeArgument = "cache-size";
+static const std::string ParallelArgument = "parallel";
+static const std::string SplitOutputArgument = "split-output";
+static const std::string StatsArgument = "stats";
+static const std::string StatsFormatArgument = "stats-format";
+static const std::string TraceArgument = "trace";
+static const std::string ServeArgument = "serve";
+static const std::string ConnectArgument = "connect";
+static const std::string WatchArgument = "watch";
+
+/// \brief Hands resource groups over to a stream serializer as they are parsed.
+class StreamSerializerDelegate : public snowcrash::BlueprintParserDelegate {
+public:
+    explicit StreamSerializerDelegate(snowcrash::StreamSerializer& serializer)
+    : m_serializer(serializer) {}
+    
+    virtual void handleResourceGroup(const snowcrash::Blueprint& blueprint,
+                                     const snowcrash::ResourceGroup& resourceGroup) {
+        m_serializer.resourceGroup(blueprint, resourceGroup);
+    }
+    
+private:
+    snowcrash::StreamSerializer& m_serializer;
+};
 
 /// \enum Snow Crash AST output format.
 enum SerializationFormat {
@@ -28,6 +59,26 @@ enum SerializationFormat {
     JSONSerializationFormat
 };
 
+/// \brief Serialize blueprint AST.
+/// \param blueprint A blueprint to serialize
+/// \param format An output format
+/// \param os An output stream
+void SerializeBlueprint(const snowcrash::Blueprint& blueprint, const std::string& format, std::ostream& os)
+{
+    if (format == "json") {
+        SerializeJSON(blueprint, os);
+    }
+    else if (format == "json-compact") {
+        SerializeJSON(blueprint, os, snowcrash::CompactJSONOption);
+    }
+    else if (format == "yaml") {
+        SerializeYAML(blueprint, os);
+    }
+    else if (format == "msgpack") {
+        SerializeMsgPack(blueprint, os);
+    }
+}
+
 /// \brief Print Markdown source annotation.
 /// \param prefix A string prefix for the annotation
 /// \param annotation An annotation to print
@@ -83,12 +134,58 @@ int main(int argc, const char *argv[])
     argumentParser.footer(ss.str());
 
     argumentParser.add<std::string>(OutputArgument, 'o', "save output AST into file", false);
-    argumentParser.add<std::string>(FormatArgument, 'f', "output AST format", false, "yaml", cmdline::oneof<std::string>("yaml", "json"));
+    argumentParser.add<std::string>(FormatArgument, 'f', "output AST format", false, "yaml", cmdline::oneof<std::string>("yaml", "json", "json-compact", "msgpack"));
     // TODO: argumentParser.add("render", 'r', "render markdown descriptions");
     argumentParser.add("help", 'h', "display this help message");
     argumentParser.add(ValidateArgument, 'v', "validate input only, do not print AST");
+    argumentParser.add<std::string>(CacheDirArgument, 0, "reuse parser results cached in directory", false);
+    argumentParser.add<size_t>(CacheSizeArgument, 0, "cache size limit in MB", false, ParseCache::DefaultSizeLimit / (1024 * 1024));
+    argumentParser.add(ParallelArgument, 'j', "serialize resource groups in parallel");
+    argumentParser.add<std::string>(SplitOutputArgument, 0, "save output AST into directory, a file per resource group", false);
+    argumentParser.add<std::string>(TraceArgument, 0, "save Chrome trace of the parsing into file", false);
+    argumentParser.add(StatsArgument, 0, "print parser statistics to stderr");
+    argumentParser.add<std::string>(StatsFormatArgument, 0, "parser statistics format", false, "text", cmdline::oneof<std::string>("text", "json"));
+    argumentParser.add<std::string>(ServeArgument, 0, "serve parse requests on unix domain socket, do not parse input", false);
+    argumentParser.add<std::string>(ConnectArgument, 0, "parse by daemon serving on unix domain socket, if available", false);
+    argumentParser.add(WatchArgument, 0, "watch input files & directories, print diagnostics as they change");
     
     argumentParser.parse_check(argc, argv);
+    
+    // Parse daemon
+    std::string socketPath = argumentParser.get<std::string>(ServeArgument);
+    if (!socketPath.empty()) {
+        std::string error;
+        if (!snowcrash::ServeParseRequests(socketPath, SerializeBlueprint, error)) {
+            std::cerr << "fatal: " << error << "\n";
+            exit(EXIT_FAILURE);
+        }
+        
+        return EXIT_SUCCESS;
+    }
+    
+    // Watch mode
+    if (argumentParser.exist(WatchArgument)) {
+        if (argumentParser.rest().empty()) {
+            std::cerr << "input files or directories to watch expected" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        
+        snowcrash::WatchOptions watchOptions;
+        watchOptions.paths = argumentParser.rest();
+        watchOptions.outputPath = argumentParser.get<std::string>(OutputArgument);
+        if (!watchOptions.outputPath.empty() && !argumentParser.exist(ValidateArgument))
+            watchOptions.format = argumentParser.get<std::string>(FormatArgument);
+        watchOptions.serializer = SerializeBlueprint;
+        
+        std::string error;
+        if (!snowcrash::WatchFiles(watchOptions, std::cerr, error)) {
+            std::cerr << "fatal: " << error << "\n";
+            exit(EXIT_FAILURE);
+        }
+        
+        return EXIT_SUCCESS;
+    }
+    
     if (argumentParser.rest().size() > 1) {
         std::cerr << "one input file expected, got " << argumentParser.rest().size() << std::endl;
         exit(EXIT_FAILURE);
@@ -114,44 +211,160 @@ int main(int argc, const char *argv[])
         inputFileStream.close();
     }
 
-    // Parse
+    // Output format, none when validating
+    std::string format;
+    if (!argumentParser.exist(ValidateArgument))
+        format = argumentParser.get<std::string>(FormatArgument);
+    
+    // Parse, or retrieve cached results
     snowcrash::BlueprintParserOptions options = 0;  // Or snowcrash::RequireBlueprintNameOption
     snowcrash::Result result;
-    snowcrash::Blueprint blueprint;
-    snowcrash::parse(inputStream.str(), options, result, blueprint);
+    std::string output;
     
-    // Output
-    if (!argumentParser.exist(ValidateArgument)) {
+    // Output into directory, file or stdout
+    std::string splitDirectory;
+    if (!format.empty())
+        splitDirectory = argumentParser.get<std::string>(SplitOutputArgument);
+    
+    std::ofstream outputFileStream;
+    std::string outputFileName = argumentParser.get<std::string>(OutputArgument);
+    if (!format.empty() && splitDirectory.empty() && !outputFileName.empty()) {
+        outputFileStream.open(outputFileName.c_str(), std::ios::out | std::ios::binary);
+        if (!outputFileStream.is_open()) {
+            std::cerr << "fatal: unable to write to file `" <<  outputFileName << "`\n";
+            exit(EXIT_FAILURE);
+        }
+    }
+    std::ostream& outputStream = outputFileStream.is_open() ? outputFileStream : std::cout;
+    
+    // Statistics, collected only when requested, cached results are not used
+    snowcrash::ParserStatistics parserStatistics;
+    snowcrash::ParserStatistics* statistics = argumentParser.exist(StatsArgument) ? &parserStatistics : NULL;
+    
+    // Trace, recorded only when requested, cached results are not used
+    std::string traceFileName = argumentParser.get<std::string>(TraceArgument);
+    snowcrash::Trace parserTrace;
+    snowcrash::Trace* trace = traceFileName.empty() ? NULL : &parserTrace;
+    
+    std::string cacheDir = argumentParser.get<std::string>(CacheDirArgument);
+    ParseCache cache(cacheDir, argumentParser.get<size_t>(CacheSizeArgument) * 1024 * 1024);
+    std::string cacheKey;
+    if (!cacheDir.empty() && !statistics && !trace)
+        cacheKey = ParseCache::Key(inputStream.str(), options, format);
+    
+    bool parallel = argumentParser.exist(ParallelArgument);
+    
+    // Serialize resource groups as soon as they are parsed,
+    // unless the output is split, cached or serialized in parallel
+    snowcrash::JSONStreamSerializer jsonSerializer(outputStream, (format == "json-compact") ? snowcrash::CompactJSONOption : 0);
+    snowcrash::YAMLStreamSerializer yamlSerializer(outputStream);
+    snowcrash::StreamSerializer* streamSerializer = NULL;
+    if (splitDirectory.empty() && cacheKey.empty() && !parallel) {
+        if (format == "json" || format == "json-compact")
+            streamSerializer = &jsonSerializer;
+        else if (format == "yaml")
+            streamSerializer = &yamlSerializer;
+    }
+    
+    // Parse by the daemon if requested, in-process parsing is the fallback
+    bool parsedByDaemon = false;
+    std::string connectPath = argumentParser.get<std::string>(ConnectArgument);
+    if (!connectPath.empty() && splitDirectory.empty() && !statistics && !trace) {
+        snowcrash::ParseRequest request;
+        request.options = options;
+        request.format = format;
+        request.source = inputStream.str();
+        
+        std::string error;
+        parsedByDaemon = snowcrash::RequestParse(connectPath, request, output, result, error);
+    }
+    
+    if (parsedByDaemon) {
+        
+        // Output and result received from the daemon
+    }
+    else if (!splitDirectory.empty()) {
+        
+        snowcrash::Blueprint blueprint;
+        snowcrash::parse(inputStream.str(), options, result, blueprint, NULL, statistics, trace);
+        
+        std::string error;
+        snowcrash::ParserPhaseScope phase(statistics, snowcrash::SerializePhase);
+        snowcrash::TraceSpan span(trace, "serialize", "phase");
+        if (!snowcrash::WriteSplitOutput(blueprint, splitDirectory, format, SerializeBlueprint, error)) {
+            std::cerr << "fatal: " << error << "\n";
+            exit(EXIT_FAILURE);
+        }
+    }
+    else if (streamSerializer) {
         
-        std::stringstream outputStream;
+        snowcrash::Blueprint blueprint;
+        StreamSerializerDelegate delegate(*streamSerializer);
+        snowcrash::parse(inputStream.str(), options, result, blueprint, &delegate, statistics, trace);
+        
+        // Resource groups are serialized within the blueprint phase
+        snowcrash::ParserPhaseScope phase(statistics, snowcrash::SerializePhase);
+        snowcrash::TraceSpan span(trace, "serialize", "phase");
+        streamSerializer->end(blueprint);
+    }
+    else if (cacheKey.empty() || !cache.fetch(cacheKey, output, result)) {
+        
+        snowcrash::Blueprint blueprint;
+        if (format.empty())
+            snowcrash::validate(inputStream.str(), options, result, statistics, trace);
+        else
+            snowcrash::parse(inputStream.str(), options, result, blueprint, NULL, statistics, trace);
+        
+        snowcrash::ParserPhaseScope phase(statistics, snowcrash::SerializePhase);
+        snowcrash::TraceSpan span(trace, "serialize", "phase");
+        snowcrash::SerializeJSONOptions jsonOptions = parallel ? snowcrash::ParallelJSONOption : 0;
+        snowcrash::SerializeYAMLOptions yamlOptions = parallel ? snowcrash::ParallelYAMLOption : 0;
 
-        if (argumentParser.get<std::string>(FormatArgument) == "json") {
-            SerializeJSON(blueprint, outputStream);
+        std::stringstream serialization;
+        if (format == "json") {
+            SerializeJSON(blueprint, serialization, jsonOptions);
         }
-        else if (argumentParser.get<std::string>(FormatArgument) == "yaml") {
-            SerializeYAML(blueprint, outputStream);
+        else if (format == "json-compact") {
+            SerializeJSON(blueprint, serialization, jsonOptions | snowcrash::CompactJSONOption);
         }
-        
-        std::string outputFileName = argumentParser.get<std::string>(OutputArgument);
-        if (!outputFileName.empty()) {
-            // Serialize to file
-            std::ofstream outputFileStream;
-            outputFileStream.open(outputFileName.c_str());
-            if (!outputFileStream.is_open()) {
-                std::cerr << "fatal: unable to write to file `" <<  outputFileName << "`\n";
-                exit(EXIT_FAILURE);
-            }
-            
-            outputFileStream << outputStream.rdbuf();
-            outputFileStream.close();
+        else if (format == "yaml") {
+            SerializeYAML(blueprint, serialization, yamlOptions);
+        }
+        else if (format == "msgpack") {
+            SerializeMsgPack(blueprint, serialization);
         }
-        else {
-            // Serialize to stdout
-            std::cout << outputStream.rdbuf();
+        output = serialization.str();
+        
+        if (!cacheKey.empty())
+            cache.store(cacheKey, output, result);
+    }
+    
+    // Output
+    if (!format.empty() && splitDirectory.empty()) {
+        outputStream << output;
+        outputStream.flush();
+    }
+    
+    // Trace
+    if (trace) {
+        std::ofstream traceFileStream(traceFileName.c_str(), std::ios::out | std::ios::binary);
+        if (!traceFileStream.is_open()) {
+            std::cerr << "fatal: unable to write to file `" <<  traceFileName << "`\n";
+            exit(EXIT_FAILURE);
         }
+        trace->write(traceFileStream);
     }
     
     // Result
     PrintResult(result);
+    
+    if (statistics) {
+        std::cerr << std::endl;
+        if (argumentParser.get<std::string>(StatsFormatArgument) == "json")
+            snowcrash::PrintStatisticsJSON(*statistics, std::cerr);
+        else
+            snowcrash::PrintStatistics(*statistics, std::cerr);
+    }
+    
     return result.error.code;
 }
@@ -0,0 +1,78 @@
+//
+//  MappedFile.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <windows.h>
+#include "MappedFile.h"
+
+using namespace snowcrash;
+
+MappedFile::MappedFile()
+: m_data(NULL), m_size(0), m_file(NULL), m_mapping(NULL)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool MappedFile::open(const std::string& path)
+{
+    close();
+
+    HANDLE file = ::CreateFileA(path.c_str(),
+                                GENERIC_READ,
+                                FILE_SHARE_READ,
+                                NULL,
+                                OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL,
+                                NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    if (!::GetFileSizeEx(file, &size) || size.QuadPart <= 0) {
+        ::CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = ::CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mapping) {
+        ::CloseHandle(file);
+        return false;
+    }
+
+    void* data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data) {
+        ::CloseHandle(mapping);
+        ::CloseHandle(file);
+        return false;
+    }
+
+    m_data = static_cast<const char*>(data);
+    m_size = static_cast<size_t>(size.QuadPart);
+    m_file = file;
+    m_mapping = mapping;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (m_data)
+        ::UnmapViewOfFile(m_data);
+
+    if (m_mapping)
+        ::CloseHandle(static_cast<HANDLE>(m_mapping));
+
+    if (m_file)
+        ::CloseHandle(static_cast<HANDLE>(m_file));
+
+    m_data = NULL;
+    m_size = 0;
+    m_file = NULL;
+    m_mapping = NULL;
+}
@@ -9,6 +9,10 @@
 #include <regex>
 #include <cstring>
 #include "RegexMatch.h"
+#include "Platform.h"
+
+// Counter of regex evaluations performed by this thread, NULL if not counted
+static THREADLOCAL size_t* s_evaluations = NULL;
 
 //
 // A C++11 implementation
@@ -18,6 +22,9 @@ bool snowcrash::RegexMatch(const std::string& target, const std::string& express
 {
     if (target.empty() || expression.empty())
         return false;
+
+    if (s_evaluations)
+        ++*s_evaluations;
     
     try {
         std::regex pattern(expression, std::regex_constants::extended);
@@ -45,6 +52,9 @@ bool snowcrash::RegexCapture(const std::string& target, const std::string& expre
 {
     if (target.empty() || expression.empty())
         return false;
+
+    if (s_evaluations)
+        ++*s_evaluations;
     
     captureGroups.clear();
 
@@ -71,3 +81,10 @@ bool snowcrash::RegexCapture(const std::string& target, const std::string& expre
     
     return false;
 }
+
+size_t* snowcrash::SetRegexEvaluationCounter(size_t* counter)
+{
+    size_t* previous = s_evaluations;
+    s_evaluations = counter;
+    return previous;
+}
@@ -0,0 +1,142 @@
+//
+//  Thread.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <windows.h>
+#include "Thread.h"
+
+using namespace snowcrash;
+
+struct ThreadPool::State {
+    std::vector<HANDLE> threads;
+
+    CRITICAL_SECTION runLock;       // serializes run() calls
+    CRITICAL_SECTION lock;          // guards the fields below
+    CONDITION_VARIABLE work;        // signaled when tasks are available or stopping
+    CONDITION_VARIABLE done;        // signaled when the last task is done
+
+    const std::vector<Task*>* tasks;
+    size_t next;                    // next task to take
+    size_t finished;                // number of finished tasks
+    bool stopping;
+
+    // Take and run tasks until there are none left, lock must be held
+    void runTasks() {
+        while (tasks && next < tasks->size()) {
+            Task* task = (*tasks)[next++];
+            ::LeaveCriticalSection(&lock);
+            task->run();
+            ::EnterCriticalSection(&lock);
+
+            if (++finished == tasks->size())
+                ::WakeAllConditionVariable(&done);
+        }
+    }
+
+    // Worker thread entry point
+    static DWORD WINAPI worker(LPVOID context) {
+        State* state = static_cast<State*>(context);
+
+        ::EnterCriticalSection(&state->lock);
+        while (true) {
+            state->runTasks();
+            if (state->stopping)
+                break;
+
+            ::SleepConditionVariableCS(&state->work, &state->lock, INFINITE);
+        }
+        ::LeaveCriticalSection(&state->lock);
+
+        return 0;
+    }
+};
+
+ThreadPool::ThreadPool(size_t threads)
+: m_state(new State)
+{
+    if (!threads)
+        threads = HardwareConcurrency();
+
+    m_state->tasks = NULL;
+    m_state->next = 0;
+    m_state->finished = 0;
+    m_state->stopping = false;
+    ::InitializeCriticalSection(&m_state->runLock);
+    ::InitializeCriticalSection(&m_state->lock);
+    ::InitializeConditionVariable(&m_state->work);
+    ::InitializeConditionVariable(&m_state->done);
+
+    // The calling thread of run() is one of the threads
+    for (size_t i = 1; i < threads; ++i) {
+        HANDLE thread = ::CreateThread(NULL, 0, State::worker, m_state, 0, NULL);
+        if (!thread)
+            break;
+
+        m_state->threads.push_back(thread);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    ::EnterCriticalSection(&m_state->lock);
+    m_state->stopping = true;
+    ::WakeAllConditionVariable(&m_state->work);
+    ::LeaveCriticalSection(&m_state->lock);
+
+    for (std::vector<HANDLE>::iterator it = m_state->threads.begin(); it != m_state->threads.end(); ++it) {
+        ::WaitForSingleObject(*it, INFINITE);
+        ::CloseHandle(*it);
+    }
+
+    ::DeleteCriticalSection(&m_state->lock);
+    ::DeleteCriticalSection(&m_state->runLock);
+    delete m_state;
+}
+
+void ThreadPool::run(const std::vector<Task*>& tasks)
+{
+    if (tasks.empty())
+        return;
+
+    ::EnterCriticalSection(&m_state->runLock);
+    ::EnterCriticalSection(&m_state->lock);
+
+    m_state->tasks = &tasks;
+    m_state->next = 0;
+    m_state->finished = 0;
+    ::WakeAllConditionVariable(&m_state->work);
+
+    m_state->runTasks();
+    while (m_state->finished < tasks.size())
+        ::SleepConditionVariableCS(&m_state->done, &m_state->lock, INFINITE);
+
+    m_state->tasks = NULL;
+
+    ::LeaveCriticalSection(&m_state->lock);
+    ::LeaveCriticalSection(&m_state->runLock);
+}
+
+size_t ThreadPool::size() const
+{
+    return m_state->threads.size() + 1;
+}
+
+size_t ThreadPool::HardwareConcurrency()
+{
+    SYSTEM_INFO info;
+    ::GetSystemInfo(&info);
+    return (info.dwNumberOfProcessors > 0) ? static_cast<size_t>(info.dwNumberOfProcessors) : 1;
+}
+
+bool snowcrash::AtomicCompareAndSwap(void* volatile* target, void* expected, void* desired)
+{
+    return ::InterlockedCompareExchangePointer(target, desired, expected) == expected;
+}
+
+long snowcrash::AtomicIncrement(volatile long* value)
+{
+    return ::InterlockedIncrement(value);
+}
@@ -0,0 +1,390 @@
+//
+//  Fixture.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "Fixture.h"
+
+#if defined(_WIN32)
+#   include <windows.h>
+#   include <direct.h>
+#   include <io.h>
+#else
+#   include <dirent.h>
+#   include <unistd.h>
+#endif
+
+using namespace snowcrash;
+
+const SourceData snowcrashtest::SourceDataFixture = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+MarkdownBlock::Stack snowcrashtest::CanonicalBlueprintFixture()
+{
+    // Blueprint in question:
+    //R"(
+    //meta: verse
+    //
+    //# Snowcrash API
+    //
+    //## Character
+    //Uncle Enzo
+    //
+    //<see CanonicalResourceGroupFixture()>
+    //
+    //)";
+    
+    MarkdownBlock::Stack markdown;
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "meta: verse", 0, MakeSourceDataBlock(0, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Snowcrash API", 1, MakeSourceDataBlock(1, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Character", 2, MakeSourceDataBlock(2, 1)));
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Uncle Enzo", 0, MakeSourceDataBlock(3, 1)));
+    
+    MarkdownBlock::Stack methodBlocks = CanonicalResourceGroupFixture();
+    markdown.insert(markdown.end(), methodBlocks.begin(), methodBlocks.end());
+    
+    return markdown;
+}
+
+MarkdownBlock::Stack snowcrashtest::CanonicalResourceGroupFixture()
+{
+    // Blueprint in question:
+    //R"(
+    //# Group First
+    //
+    //Fiber optics
+    //
+    //<see CanonicalResourceFixture()>
+    //
+    //
+    //# Group Second
+    //
+    //Assembly language
+    //)";
+    
+    MarkdownBlock::Stack markdown;
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Group First", 1, MakeSourceDataBlock(0, 1)));
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Fiber optics", 0, MakeSourceDataBlock(1, 1)));
+
+    MarkdownBlock::Stack methodBlocks = CanonicalResourceFixture();
+    markdown.insert(markdown.end(), methodBlocks.begin(), methodBlocks.end());
+    
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Group Second", 1, MakeSourceDataBlock(0, 1)));
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Assembly language", 0, MakeSourceDataBlock(2, 1)));
+    
+    return markdown;
+}
+
+MarkdownBlock::Stack snowcrashtest::CanonicalResourceFixture()
+{
+    // Blueprint in question:
+    //R"(
+    //# My Resource [/resource]
+    //Resource Description
+    //
+    //+ My Resource Object (text/plain)
+    //
+    //        X.O.
+    //
+    //+ Headers
+    //
+    //        X-Resource-Header: Swordfighter XXII
+    //
+    // <see CanonicalMethodFixture()>
+    //
+    //)";
+    
+    MarkdownBlock::Stack markdown;
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "My Resource [/resource]", 1, MakeSourceDataBlock(0, 1)));
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Resource Description", 0, MakeSourceDataBlock(1, 1)));    
+
+    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
+
+    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "My Resource Object (text/plain)", 0, MakeSourceDataBlock(2, 1)));
+    markdown.push_back(MarkdownBlock(CodeBlockType, "X.O.", 0, MakeSourceDataBlock(3, 1)));
+    markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, MakeSourceDataBlock(4, 1)));
+    
+    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Headers", 0, MakeSourceDataBlock(5, 1)));
+    markdown.push_back(MarkdownBlock(CodeBlockType, "X-Resource-Header: Swordfighter XXII", 0, MakeSourceDataBlock(6, 1)));
+    markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, MakeSourceDataBlock(7, 1)));
+    
+    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(8, 1)));
+    
+    MarkdownBlock::Stack methodBlocks = CanonicalMethodFixture();
+    markdown.insert(markdown.end(), methodBlocks.begin(), methodBlocks.end());
+    
+    return markdown;
+}
+
+MarkdownBlock::Stack snowcrashtest::CanonicalMethodFixture()
+{
+    // Blueprint in question:
+    //R"(
+    //# My Method [GET]
+    //Method Description
+    //
+    //+ Headers
+    //
+    //        X-Method-Header: 0xdeadbeef
+    //
+    // <see CanonicalPayloadFixture()>
+    //
+    //+ Response 200 (text/plain)
+    //
+    //       OK.
+    //
+    //)";
+    
+    MarkdownBlock::Stack markdown;
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "My Method [GET]", 1, MakeSourceDataBlock(0, 1)));
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Method Description", 0, MakeSourceDataBlock(1, 1)));
+    
+    MarkdownBlock::Stack headerList;
+    headerList.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    headerList.push_back(MarkdownBlock(ParagraphBlockType, "Headers", 0, MakeSourceDataBlock(1, 1)));
+    headerList.push_back(MarkdownBlock(CodeBlockType, "X-Method-Header: 0xdeadbeef", 0, MakeSourceDataBlock(2, 1)));
+    headerList.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, MakeSourceDataBlock(3, 1)));
+    
+    MarkdownBlock::Stack listBlock = CanonicalPayloadFixture();
+    
+    // inject headers into payload list
+    MarkdownBlock::Stack::iterator cur = listBlock.begin();
+    ++cur;
+    listBlock.insert(cur, headerList.begin(), headerList.end());
+    
+    // inject response into payload list
+    MarkdownBlock::Stack responseList;
+    responseList.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    responseList.push_back(MarkdownBlock(ParagraphBlockType, "Response 200 (text/plain)", 0, MakeSourceDataBlock(4, 1)));
+    responseList.push_back(MarkdownBlock(CodeBlockType, "OK.", 0, MakeSourceDataBlock(5, 1)));
+    responseList.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, MakeSourceDataBlock(6, 1)));
+    
+    cur = listBlock.begin();
+    ++cur;
+    listBlock.insert(cur, responseList.begin(), responseList.end());
+    
+    // inject complete list into final markdown
+    markdown.insert(markdown.end(), listBlock.begin(), listBlock.end());
+
+    return markdown;
+}
+
+MarkdownBlock::Stack snowcrashtest::CanonicalPayloadFixture()
+{
+    // Blueprint in question:
+    //R"(
+    //+ Request Hello World (text/plain)
+    //
+    //  Description
+    //
+    //    + Headers
+    //
+    //            X-Header: 42
+    //
+    //    + Body
+    //
+    //            Code
+    //
+    //    + Schema
+    //
+    //            Code 2
+    //
+    //)";
+    
+    MarkdownBlock::Stack markdown;
+    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Request Hello World (text/plain)", 0, MakeSourceDataBlock(0, 1)));
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Description", 0, MakeSourceDataBlock(1, 1)));
+    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
+
+    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Headers", 0, MakeSourceDataBlock(2, 1)));
+    markdown.push_back(MarkdownBlock(CodeBlockType, "X-Header: 42", 0, MakeSourceDataBlock(3, 1)));
+    markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, MakeSourceDataBlock(4, 1)));
+    
+    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Body", 0, MakeSourceDataBlock(4, 1)));
+    markdown.push_back(MarkdownBlock(CodeBlockType, "Code", 0, MakeSourceDataBlock(4, 1)));
+    markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, MakeSourceDataBlock(5, 1)));
+    
+    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Schema", 0, MakeSourceDataBlock(6, 1)));
+    markdown.push_back(MarkdownBlock(CodeBlockType, "Code 2", 0, MakeSourceDataBlock(7, 1)));
+    markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, MakeSourceDataBlock(8, 1)));
+    
+    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(9, 1)));
+    markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, MakeSourceDataBlock(10, 1)));
+    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(11, 1)));
+    
+    return markdown;
+}
+
+MarkdownBlock::Stack snowcrashtest::CanonicalBodyAssetFixture()
+{
+    // Blueprint in question:
+    //R"(
+    //+ Body
+    //
+    //          Lorem Ipsum
+    //)";
+    
+    MarkdownBlock::Stack markdown;
+    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Body", 0, MakeSourceDataBlock(0, 1)));
+    markdown.push_back(MarkdownBlock(CodeBlockType, "Lorem Ipsum", 0, MakeSourceDataBlock(1, 1)));
+    
+    markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, MakeSourceDataBlock(2, 1)));
+    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(3, 1)));
+    
+    return markdown;
+}
+
+MarkdownBlock::Stack snowcrashtest::CanonicalSchemaAssetFixture()
+{
+    // Blueprint in question:
+    //R"(
+    //+ Sechema
+    //
+    //          Lorem Ipsum
+    //)";
+    
+    MarkdownBlock::Stack markdown;
+    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Schema", 0, MakeSourceDataBlock(0, 1)));
+    markdown.push_back(MarkdownBlock(CodeBlockType, "Dolor Sit Amet", 0, MakeSourceDataBlock(1, 1)));
+    
+    markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, MakeSourceDataBlock(2, 1)));
+    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(3, 1)));
+    
+    return markdown;
+}
+
+Blueprint snowcrashtest::SerializeBlueprintFixture()
+{
+    Blueprint blueprint;
+    blueprint.metadata.push_back(std::make_pair("FORMAT", "1A"));
+    blueprint.metadata.push_back(std::make_pair("HOST", "http://acme.com"));
+    blueprint.name = "Snowcrash API";
+    blueprint.description = "Uncle Enzo\n\nwith *Hiro*\n";
+
+    ResourceGroup group;
+    group.name = "First";
+    group.description = "Fiber optics";
+
+    Resource resource;
+    resource.uriTemplate = "/resource/{id}";
+    resource.name = "My Resource";
+    resource.description = "Resource\ndescription";
+    resource.object.name = "My Resource";
+    resource.object.description = "Object";
+    resource.object.body = "{ \"id\": 1 }\n";
+    resource.object.headers.push_back(std::make_pair("Content-Type", "application/json"));
+    resource.headers.push_back(std::make_pair("X-Header", "42"));
+    resource.headers.push_back(std::make_pair("X-Other", "Hello"));
+
+    Method method;
+    method.method = "GET";
+    method.name = "Retrieve";
+    method.description = "Method description\n";
+    method.headers.push_back(std::make_pair("Accept", "application/json"));
+
+    Request request;
+    request.name = "A";
+    request.description = "Request A";
+    request.body = "Text\n\n{ ... }\n";
+    request.schema = "Schema\n";
+    request.headers.push_back(std::make_pair("Content-Type", "text/plain"));
+    method.requests.push_back(request);
+    request.name = "B";
+    request.headers.clear();
+    method.requests.push_back(request);
+
+    Response response;
+    response.name = "200";
+    response.body = "{ \"id\": 1 }\n";
+    response.headers.push_back(std::make_pair("Content-Type", "application/json"));
+    method.responses.push_back(response);
+    response.name = "404";
+    response.body.clear();
+    response.headers.clear();
+    method.responses.push_back(response);
+
+    resource.methods.push_back(method);
+
+    Method del;
+    del.method = "DELETE";
+    resource.methods.push_back(del);
+    group.resources.push_back(resource);
+
+    Resource plain;
+    plain.uriTemplate = "/plain";
+    group.resources.push_back(plain);
+    blueprint.resourceGroups.push_back(group);
+
+    ResourceGroup empty;
+    blueprint.resourceGroups.push_back(empty);
+
+    return blueprint;
+}
+
+snowcrashtest::TemporaryDirectory::TemporaryDirectory()
+{
+#if defined(_WIN32)
+    char path[MAX_PATH];
+    char name[] = "snowcrash-XXXXXX";
+    ::GetTempPathA(MAX_PATH, path);
+    if (::_mktemp_s(name, sizeof(name)) == 0) {
+        m_path = std::string(path) + name;
+        ::_mkdir(m_path.c_str());
+    }
+#else
+    const char* tmp = ::getenv("TMPDIR");
+    std::string pattern = std::string((tmp && *tmp) ? tmp : "/tmp") + "/snowcrash-XXXXXX";
+    std::vector<char> path(pattern.begin(), pattern.end());
+    path.push_back('\0');
+    if (::mkdtemp(&path[0]))
+        m_path = &path[0];
+#endif
+}
+
+snowcrashtest::TemporaryDirectory::~TemporaryDirectory()
+{
+    if (m_path.empty())
+        return;
+    
+#if defined(_WIN32)
+    WIN32_FIND_DATAA data;
+    HANDLE find = ::FindFirstFileA((m_path + "\\*").c_str(), &data);
+    if (find != INVALID_HANDLE_VALUE) {
+        do {
+            if (!(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+                std::remove(filePath(data.cFileName).c_str());
+        } while (::FindNextFileA(find, &data));
+        ::FindClose(find);
+    }
+    
+    ::_rmdir(m_path.c_str());
+#else
+    if (DIR* dir = ::opendir(m_path.c_str())) {
+        while (struct dirent* item = ::readdir(dir)) {
+            std::string name = item->d_name;
+            if (name != "." && name != "..")
+                std::remove(filePath(name).c_str());
+        }
+        ::closedir(dir);
+    }
+    
+    ::rmdir(m_path.c_str());
+#endif
+}
@@ -9,7 +9,9 @@
 #ifndef SNOWCRASH_FIXTURES_H
 #define SNOWCRASH_FIXTURES_H
 
+#include <string>
 #include "MarkdownBlock.h"
+#include "Blueprint.h"
 
 namespace snowcrashtest {
 
@@ -22,6 +24,28 @@ namespace snowcrashtest {
     extern snowcrash::MarkdownBlock::Stack CanonicalPayloadFixture();
     extern snowcrash::MarkdownBlock::Stack CanonicalBodyAssetFixture();
     extern snowcrash::MarkdownBlock::Stack CanonicalSchemaAssetFixture();
+
+    extern snowcrash::Blueprint SerializeBlueprintFixture();
+    
+    //
+    // Temporary directory, removed with its files once destroyed
+    //
+    class TemporaryDirectory {
+    public:
+        TemporaryDirectory();
+        ~TemporaryDirectory();
+        
+        const std::string& path() const { return m_path; }
+        
+        // Path of a file in the directory
+        std::string filePath(const std::string& name) const { return m_path + "/" + name; }
+        
+    private:
+        std::string m_path;
+        
+        TemporaryDirectory(const TemporaryDirectory&);
+        TemporaryDirectory& operator=(const TemporaryDirectory&);
+    };
 }
 
 #endif
@@ -15,50 +15,6 @@
 using namespace snowcrash;
 using namespace snowcrashtest;
 
-MarkdownBlock::Stack snowcrashtest::CanonicalBodyAssetFixture()
-{
-    // Blueprint in question:
-    //R"(
-    //+ Body
-    //
-    //          Lorem Ipsum
-    //)";
-    
-    MarkdownBlock::Stack markdown;
-    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
-    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
-    
-    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Body", 0, MakeSourceDataBlock(0, 1)));
-    markdown.push_back(MarkdownBlock(CodeBlockType, "Lorem Ipsum", 0, MakeSourceDataBlock(1, 1)));
-    
-    markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, MakeSourceDataBlock(2, 1)));
-    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(3, 1)));
-    
-    return markdown;
-}
-
-MarkdownBlock::Stack snowcrashtest::CanonicalSchemaAssetFixture()
-{
-    // Blueprint in question:
-    //R"(
-    //+ Sechema
-    //
-    //          Lorem Ipsum
-    //)";
-    
-    MarkdownBlock::Stack markdown;
-    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
-    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
-    
-    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Schema", 0, MakeSourceDataBlock(0, 1)));
-    markdown.push_back(MarkdownBlock(CodeBlockType, "Dolor Sit Amet", 0, MakeSourceDataBlock(1, 1)));
-    
-    markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, MakeSourceDataBlock(2, 1)));
-    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(3, 1)));
-    
-    return markdown;
-}
-
 TEST_CASE("aparser/signature-inline", "Verify asset signature, inline")
 {
     SourceData source = "01";
@@ -191,7 +147,8 @@ TEST_CASE("aparser/parse-body", "Parse body asset")
     CHECK(markdown.size() == 6);
     
     Asset asset;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = AssetParser::Parse(markdown.begin(), markdown.end(), parser, asset);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -209,7 +166,8 @@ TEST_CASE("aparser/parse-schema", "Parse schema asset")
     CHECK(markdown.size() == 6);
     
     Asset asset;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = AssetParser::Parse(markdown.begin(), markdown.end(), parser, asset);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -229,7 +187,8 @@ TEST_CASE("aparser/parse-ajdacent", "Parse body asset followed by other blocks")
     CHECK(markdown.size() == 7);
     
     Asset asset;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = AssetParser::Parse(markdown.begin(), markdown.end(), parser, asset);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -252,7 +211,8 @@ TEST_CASE("aparser/parse-foreign", "Parse body asset with foreign block inside")
     CHECK(markdown.size() == 7);
     
     Asset asset;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = AssetParser::Parse(markdown.begin(), markdown.end(), parser, asset);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -278,7 +238,8 @@ TEST_CASE("aparser/parse-foreign-listitem", "Parse body asset with foreign list
     CHECK(markdown.size() == 8);
     
     Asset asset;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = AssetParser::Parse(markdown.begin(), markdown.end(), parser, asset);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -306,7 +267,8 @@ TEST_CASE("aparser/parse-multiline-signature", "Parse body asset with multiple l
     markdown[2].content = "Body\n  A\n";
     
     Asset asset;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = AssetParser::Parse(markdown.begin(), markdown.end(), parser, asset);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -341,7 +303,8 @@ TEST_CASE("aparser/parse-multipart", "Parse body asset composed from multiple bl
     markdown.insert(pos, 1, foreign);
     
     Asset asset;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = AssetParser::Parse(markdown.begin(), markdown.end(), parser, asset);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -368,7 +331,8 @@ TEST_CASE("aparser/fix-body-not-parsed", "Issue: Object payload body isn't parse
     markdown[2].content = "   Body";
     
     Asset asset;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = AssetParser::Parse(markdown.begin(), markdown.end(), parser, asset);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -8,38 +8,13 @@
 
 #include "catch.hpp"
 #include "Fixture.h"
+#include <sstream>
 #include "BlueprintParser.h"
+#include "SerializeJSON.h"
 
 using namespace snowcrash;
 using namespace snowcrashtest;
 
-snowcrash::MarkdownBlock::Stack snowcrashtest::CanonicalBlueprintFixture()
-{
-    // Blueprint in question:
-    //R"(
-    //meta: verse
-    //
-    //# Snowcrash API
-    //
-    //## Character
-    //Uncle Enzo
-    //
-    //<see CanonicalResourceGroupFixture()>
-    //
-    //)";
-    
-    MarkdownBlock::Stack markdown;
-    markdown.push_back(MarkdownBlock(ParagraphBlockType, "meta: verse", 0, MakeSourceDataBlock(0, 1)));
-    markdown.push_back(MarkdownBlock(HeaderBlockType, "Snowcrash API", 1, MakeSourceDataBlock(1, 1)));
-    markdown.push_back(MarkdownBlock(HeaderBlockType, "Character", 2, MakeSourceDataBlock(2, 1)));
-    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Uncle Enzo", 0, MakeSourceDataBlock(3, 1)));
-    
-    MarkdownBlock::Stack methodBlocks = CanonicalResourceGroupFixture();
-    markdown.insert(markdown.end(), methodBlocks.begin(), methodBlocks.end());
-    
-    return markdown;
-}
-
 TEST_CASE("bparser/classifier", "Blueprint block classifier")
 {
     MarkdownBlock::Stack markdown = CanonicalBlueprintFixture();
@@ -78,7 +53,7 @@ TEST_CASE("bpparser/parse", "Parse canonical blueprint")
     MarkdownBlock::Stack markdown = CanonicalBlueprintFixture();
     
     Blueprint blueprint;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = BlueprintParserInner::Parse(markdown.begin(), markdown.end(), parser, blueprint);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -295,7 +270,7 @@ TEST_CASE("bpparser/parse-multi-groups", "Parse nameless group after defined res
     markdown.push_back(MarkdownBlock(HeaderBlockType, "Group Name", 0, MakeSourceDataBlock(9, 1)));
     
     Blueprint blueprint;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = BlueprintParserInner::Parse(markdown.begin(), markdown.end(), parser, blueprint);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -513,3 +488,545 @@ TEST_CASE("bparser/incorrect-duplicity-warn", "Issue: fix incorrect warning abou
 
     REQUIRE(blueprint.resourceGroups.size() == 2);
 }
+
+// Collects resource groups handed over by the parser
+struct ResourceGroupCollector : public BlueprintParserDelegate {
+    
+    virtual void handleResourceGroup(const Blueprint& blueprint, const ResourceGroup& resourceGroup) {
+        names.push_back(blueprint.name);
+        resourceGroups.push_back(resourceGroup);
+    }
+    
+    std::vector<std::string> names;
+    Collection<ResourceGroup>::type resourceGroups;
+};
+
+TEST_CASE("bpparser/delegate", "Hand parsed resource groups over to delegate")
+{
+    // Blueprint in question:
+    //R"(
+    //# API Name
+    //
+    //# Group A
+    //# Resource 1 [/1]
+    //Description
+    //
+    //# Group A
+    //# Resource 1 [/1]
+    //");
+    
+    MarkdownBlock::Stack markdown;
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "API Name", 1, MakeSourceDataBlock(0, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Group A", 1, MakeSourceDataBlock(1, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Resource 1 [/1]", 1, MakeSourceDataBlock(2, 1)));
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Description", 0, MakeSourceDataBlock(3, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Group A", 1, MakeSourceDataBlock(4, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Resource 1 [/1]", 1, MakeSourceDataBlock(5, 1)));
+    
+    Result result;
+    Blueprint blueprint;
+    BlueprintParser::Parse(SourceDataFixture, markdown, 0, result, blueprint);
+    REQUIRE(result.error.code == Error::OK);
+    REQUIRE(result.warnings.size() == 2);
+    REQUIRE(blueprint.resourceGroups.size() == 2);
+    
+    Result delegateResult;
+    Blueprint overview;
+    ResourceGroupCollector collector;
+    BlueprintParser::Parse(SourceDataFixture, markdown, 0, delegateResult, overview, &collector);
+    REQUIRE(delegateResult.error.code == Error::OK);
+    
+    // Duplicates are still reported
+    REQUIRE(delegateResult.warnings.size() == result.warnings.size());
+    for (size_t i = 0; i < result.warnings.size(); ++i)
+        REQUIRE(delegateResult.warnings[i].message == result.warnings[i].message);
+    
+    // Delegate gets complete groups, blueprint overview is complete
+    REQUIRE(collector.resourceGroups.size() == 2);
+    REQUIRE(collector.names[0] == "API Name");
+    REQUIRE(collector.resourceGroups[0].name == "A");
+    REQUIRE(collector.resourceGroups[0].resources.size() == 1);
+    REQUIRE(collector.resourceGroups[0].resources[0].name == "Resource 1");
+    REQUIRE(collector.resourceGroups[0].resources[0].description == blueprint.resourceGroups[0].resources[0].description);
+    REQUIRE(!collector.resourceGroups[0].resources[0].description.empty());
+    
+    // Blueprint keeps the overview only
+    REQUIRE(overview.name == "API Name");
+    REQUIRE(overview.resourceGroups.empty());
+}
+
+TEST_CASE("bpparser/budget", "Abort parsing on exceeded budget")
+{
+    // Blueprint in question:
+    //R"(
+    //# API Name
+    //
+    //# Group A
+    //# Resource 1 [/1]
+    //
+    //# Group A
+    //# Resource 1 [/1]
+    //");
+    
+    MarkdownBlock::Stack markdown;
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "API Name", 1, MakeSourceDataBlock(0, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Group A", 1, MakeSourceDataBlock(1, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Resource 1 [/1]", 1, MakeSourceDataBlock(2, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Group A", 1, MakeSourceDataBlock(3, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Resource 1 [/1]", 1, MakeSourceDataBlock(4, 1)));
+    
+    // Within budget
+    ParserBudget budget;
+    budget.maxWarnings = 2;
+    budget.deadline = Now() + 3600;
+    
+    Result result;
+    Blueprint blueprint;
+    BlueprintParser::Parse(SourceDataFixture, markdown, 0, result, blueprint, NULL, NULL, NULL, &budget);
+    REQUIRE(result.error.code == Error::OK);
+    REQUIRE(result.warnings.size() == 2);
+    REQUIRE(blueprint.resourceGroups.size() == 2);
+    
+    // Too many warnings
+    budget.maxWarnings = 1;
+    Result warningsResult;
+    Blueprint warningsBlueprint;
+    BlueprintParser::Parse(SourceDataFixture, markdown, 0, warningsResult, warningsBlueprint, NULL, NULL, NULL, &budget);
+    REQUIRE(warningsResult.error.code == ParserBudget::ErrorCode);
+    REQUIRE(warningsResult.error.message == "parser budget exceeded: warnings");
+    REQUIRE(!warningsResult.error.location.empty());
+    REQUIRE(warningsResult.warnings.size() == 2);
+    
+    // Past deadline
+    budget.maxWarnings = 0;
+    budget.deadline = Now() / 2;
+    Result deadlineResult;
+    Blueprint deadlineBlueprint;
+    BlueprintParser::Parse(SourceDataFixture, markdown, 0, deadlineResult, deadlineBlueprint, NULL, NULL, NULL, &budget);
+    REQUIRE(deadlineResult.error.code == ParserBudget::ErrorCode);
+    REQUIRE(deadlineResult.error.message == "parser budget exceeded: deadline");
+    REQUIRE(deadlineBlueprint.resourceGroups.size() < 2);
+}
+
+TEST_CASE("bpparser/budget-warnings-total", "Count warnings of the whole source against the budget")
+{
+    // Blueprint in question:
+    //R"(
+    //# API Name
+    //
+    //# Group A
+    //# Resource 1 [/1]
+    //## GET
+    //
+    //# Group B
+    //# Resource 2 [/2]
+    //## GET
+    //
+    //# Resource 3 [/3]
+    //");
+    
+    MarkdownBlock::Stack markdown;
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "API Name", 1, MakeSourceDataBlock(0, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Group A", 1, MakeSourceDataBlock(1, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Resource 1 [/1]", 1, MakeSourceDataBlock(2, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "GET", 2, MakeSourceDataBlock(3, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Group B", 1, MakeSourceDataBlock(4, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Resource 2 [/2]", 1, MakeSourceDataBlock(5, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "GET", 2, MakeSourceDataBlock(6, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Resource 3 [/3]", 1, MakeSourceDataBlock(7, 1)));
+    
+    Result result;
+    Blueprint blueprint;
+    BlueprintParser::Parse(SourceDataFixture, markdown, 0, result, blueprint);
+    REQUIRE(result.error.code == Error::OK);
+    REQUIRE(result.warnings.size() == 2);
+    REQUIRE(blueprint.resourceGroups.size() == 2);
+    
+    // Each group has one warning, parsing aborts within the second one
+    ParserBudget budget;
+    budget.maxWarnings = 1;
+    Result budgetResult;
+    Blueprint budgetBlueprint;
+    BlueprintParser::Parse(SourceDataFixture, markdown, 0, budgetResult, budgetBlueprint, NULL, NULL, NULL, &budget);
+    REQUIRE(budgetResult.error.code == ParserBudget::ErrorCode);
+    REQUIRE(budgetResult.error.message == "parser budget exceeded: warnings");
+    REQUIRE(budgetResult.warnings.size() == 2);
+    REQUIRE(budgetBlueprint.resourceGroups.size() == 1);
+}
+
+TEST_CASE("bpparser/warning-kinds", "Identify warnings by their kind")
+{
+    // Blueprint in question:
+    //R"(
+    //# API Name
+    //
+    //# Group A
+    //# Resource 1 [/1]
+    //
+    //# Group A
+    //# Resource 1 [/1]
+    //");
+    
+    MarkdownBlock::Stack markdown;
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "API Name", 1, MakeSourceDataBlock(0, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Group A", 1, MakeSourceDataBlock(1, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Resource 1 [/1]", 1, MakeSourceDataBlock(2, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Group A", 1, MakeSourceDataBlock(3, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Resource 1 [/1]", 1, MakeSourceDataBlock(4, 1)));
+    
+    Result result;
+    Blueprint blueprint;
+    BlueprintParser::Parse(SourceDataFixture, markdown, 0, result, blueprint);
+    REQUIRE(result.error.code == Error::OK);
+    REQUIRE(result.warnings.size() == 2);
+    REQUIRE(result.warnings[0].kind == DuplicateResourceWarning);
+    REQUIRE(result.warnings[0].message == "resource `/1` is already defined");
+    REQUIRE(result.warnings[1].kind == DuplicateResourceGroupWarning);
+    REQUIRE(result.warnings[1].message == "group `A` is already defined");
+    
+    // Messages set explicitly are kept
+    Warning warning("custom message", 0, MakeSourceDataBlock(0, 1));
+    REQUIRE(warning.kind == UnspecifiedWarning);
+    REQUIRE(warning.message == "custom message");
+    
+    Warning anonymous(DuplicateResourceGroupWarning, 0, MakeSourceDataBlock(0, 1));
+    REQUIRE(anonymous.message == "anonymous group is already defined");
+    REQUIRE(WarningMessage(DuplicateResourceGroupWarning, "A") == "group `A` is already defined");
+}
+
+// Requires the same result of parsing with & without ValidateOnlyOption
+static void RequireSameValidation(const MarkdownBlock::Stack& markdown, Result& validation, Blueprint& validated)
+{
+    Result result;
+    Blueprint blueprint;
+    BlueprintParser::Parse(SourceDataFixture, markdown, 0, result, blueprint);
+    BlueprintParser::Parse(SourceDataFixture, markdown, ValidateOnlyOption, validation, validated);
+    
+    REQUIRE(validation.error.code == result.error.code);
+    REQUIRE(validation.error.message == result.error.message);
+    REQUIRE(validation.warnings.size() == result.warnings.size());
+    for (size_t i = 0; i < result.warnings.size(); ++i) {
+        REQUIRE(validation.warnings[i].code == result.warnings[i].code);
+        REQUIRE(validation.warnings[i].message == result.warnings[i].message);
+        REQUIRE(validation.warnings[i].location.size() == result.warnings[i].location.size());
+    }
+    
+    REQUIRE(validated.name == blueprint.name);
+    REQUIRE(validated.metadata.size() == blueprint.metadata.size());
+}
+
+TEST_CASE("bpparser/validate-only", "Validate blueprint without building its AST")
+{
+    // Blueprint in question:
+    //R"(
+    //# API Name
+    //
+    //# Group A
+    //# Resource 1 [/1]
+    //Description
+    //
+    //## GET
+    //+ Response 200
+    //
+    //        A
+    //
+    //+ Response 200
+    //
+    //        B
+    //
+    //## GET
+    //
+    //# Group A
+    //# Resource 1 [/1]
+    //");
+    
+    MarkdownBlock::Stack markdown;
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "API Name", 1, MakeSourceDataBlock(0, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Group A", 1, MakeSourceDataBlock(1, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Resource 1 [/1]", 1, MakeSourceDataBlock(2, 1)));
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Description", 0, MakeSourceDataBlock(3, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "GET", 2, MakeSourceDataBlock(4, 1)));
+    
+    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Response 200\n", 0, MakeSourceDataBlock(5, 1)));
+    markdown.push_back(MarkdownBlock(CodeBlockType, "A\n", 0, MakeSourceDataBlock(6, 1)));
+    markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, MakeSourceDataBlock(7, 1)));
+    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Response 200\n", 0, MakeSourceDataBlock(8, 1)));
+    markdown.push_back(MarkdownBlock(CodeBlockType, "B\n", 0, MakeSourceDataBlock(9, 1)));
+    markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, MakeSourceDataBlock(10, 1)));
+    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(11, 1)));
+    
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "GET", 2, MakeSourceDataBlock(12, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Group A", 1, MakeSourceDataBlock(13, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Resource 1 [/1]", 1, MakeSourceDataBlock(14, 1)));
+    
+    Result result;
+    Blueprint blueprint;
+    RequireSameValidation(markdown, result, blueprint);
+    
+    // Duplicate response, duplicate method, no response, duplicate group & resource
+    REQUIRE(result.error.code == Error::OK);
+    REQUIRE(result.warnings.size() == 5);
+    
+    // No AST but the overview
+    REQUIRE(blueprint.name == "API Name");
+    REQUIRE(blueprint.resourceGroups.empty());
+}
+
+TEST_CASE("bpparser/validate-only-canonical", "Validate canonical blueprint without building its AST")
+{
+    Result result;
+    Blueprint blueprint;
+    RequireSameValidation(CanonicalBlueprintFixture(), result, blueprint);
+    
+    REQUIRE(result.error.code == Error::OK);
+    REQUIRE(blueprint.description.empty());
+    REQUIRE(blueprint.resourceGroups.empty());
+}
+
+// Clears a payload of the parts left out by projection options
+static void ProjectPayloadFixture(BlueprintParserOptions options, Payload& payload)
+{
+    if (options & SkipDescriptionsOption)
+        payload.description.clear();
+    if (options & SkipBodiesOption)
+        payload.body.clear();
+    if (options & SkipSchemasOption)
+        payload.schema.clear();
+    if (options & SkipHeadersOption)
+        payload.headers.clear();
+}
+
+// Clears a blueprint of the parts left out by projection options
+static void ProjectBlueprintFixture(BlueprintParserOptions options, Blueprint& blueprint)
+{
+    if (options & SkipDescriptionsOption)
+        blueprint.description.clear();
+    
+    for (Collection<ResourceGroup>::iterator group = blueprint.resourceGroups.begin(); group != blueprint.resourceGroups.end(); ++group) {
+        if (options & SkipDescriptionsOption)
+            group->description.clear();
+        
+        for (Collection<Resource>::iterator resource = group->resources.begin(); resource != group->resources.end(); ++resource) {
+            if (options & SkipDescriptionsOption)
+                resource->description.clear();
+            if (options & SkipHeadersOption)
+                resource->headers.clear();
+            ProjectPayloadFixture(options, resource->object);
+            
+            for (Collection<Method>::iterator method = resource->methods.begin(); method != resource->methods.end(); ++method) {
+                if (options & SkipDescriptionsOption)
+                    method->description.clear();
+                if (options & SkipHeadersOption)
+                    method->headers.clear();
+                
+                for (Collection<Request>::iterator it = method->requests.begin(); it != method->requests.end(); ++it)
+                    ProjectPayloadFixture(options, *it);
+                for (Collection<Response>::iterator it = method->responses.begin(); it != method->responses.end(); ++it)
+                    ProjectPayloadFixture(options, *it);
+            }
+        }
+    }
+}
+
+TEST_CASE("bpparser/projection", "Leave parts of the AST out")
+{
+    const BlueprintParserOptions projections[] = {
+        SkipDescriptionsOption,
+        SkipBodiesOption,
+        SkipSchemasOption,
+        SkipHeadersOption,
+        SkipBodiesOption | SkipSchemasOption,
+        SkipDescriptionsOption | SkipBodiesOption | SkipSchemasOption | SkipHeadersOption
+    };
+    
+    MarkdownBlock::Stack markdown = CanonicalBlueprintFixture();
+    
+    Result result;
+    Blueprint blueprint;
+    BlueprintParser::Parse(SourceDataFixture, markdown, 0, result, blueprint);
+    REQUIRE(result.error.code == Error::OK);
+    
+    std::stringstream full;
+    SerializeJSON(blueprint, full);
+    
+    for (size_t i = 0; i < sizeof(projections) / sizeof(projections[0]); ++i) {
+        
+        Result projectedResult;
+        Blueprint projected;
+        BlueprintParser::Parse(SourceDataFixture, markdown, projections[i], projectedResult, projected);
+        
+        // Same result
+        REQUIRE(projectedResult.error.code == result.error.code);
+        REQUIRE(projectedResult.warnings.size() == result.warnings.size());
+        for (size_t j = 0; j < result.warnings.size(); ++j)
+            REQUIRE(projectedResult.warnings[j].message == result.warnings[j].message);
+        
+        // Same AST except the parts left out
+        Blueprint expected = blueprint;
+        ProjectBlueprintFixture(projections[i], expected);
+        
+        std::stringstream expectedJSON;
+        SerializeJSON(expected, expectedJSON);
+        std::stringstream projectedJSON;
+        SerializeJSON(projected, projectedJSON);
+        
+        REQUIRE(projectedJSON.str() == expectedJSON.str());
+        REQUIRE(projectedJSON.str() != full.str());
+    }
+}
+
+TEST_CASE("bpparser/projection-asset-checks", "Check assets & headers left out of the AST")
+{
+    // Blueprint in question:
+    //R"(
+    //# API Name
+    //# Resource 1 [/1]
+    //## GET
+    //+ Response 200
+    //    + Headers
+    //
+    //            Accept: a
+    //            Accept: b
+    //
+    //    + Body
+    //    + Body
+    //
+    //            A
+    //
+    //    + Body
+    //
+    //            B
+    //
+    //    + Schema
+    //
+    //            S
+    //
+    //    + Schema
+    //
+    //            T
+    //");
+    
+    MarkdownBlock::Stack markdown;
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "API Name", 1, MakeSourceDataBlock(0, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Resource 1 [/1]", 1, MakeSourceDataBlock(1, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "GET", 2, MakeSourceDataBlock(2, 1)));
+    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Response 200", 0, MakeSourceDataBlock(3, 1)));
+    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    
+    const char* assets[][2] = {
+        { "Headers", "Accept: a\nAccept: b\n" },
+        { "Body", NULL },
+        { "Body", "A\n" },
+        { "Body", "B\n" },
+        { "Schema", "S\n" },
+        { "Schema", "T\n" }
+    };
+    
+    for (size_t i = 0; i < sizeof(assets) / sizeof(assets[0]); ++i) {
+        markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+        if (assets[i][1]) {
+            markdown.push_back(MarkdownBlock(ParagraphBlockType, assets[i][0], 0, MakeSourceDataBlock(4 + 2 * i, 1)));
+            markdown.push_back(MarkdownBlock(CodeBlockType, assets[i][1], 0, MakeSourceDataBlock(5 + 2 * i, 1)));
+            markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, SourceDataBlock()));
+        }
+        else {
+            markdown.push_back(MarkdownBlock(ListItemBlockEndType, assets[i][0], 0, MakeSourceDataBlock(4 + 2 * i, 1)));
+        }
+    }
+    
+    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, SourceDataBlock()));
+    
+    Result result;
+    Blueprint blueprint;
+    BlueprintParser::Parse(SourceDataFixture, markdown, 0, result, blueprint);
+    REQUIRE(result.error.code == Error::OK);
+    
+    // Duplicate header, empty body, duplicate body & schema
+    REQUIRE(result.warnings.size() == 4);
+    REQUIRE(blueprint.resourceGroups[0].resources[0].methods[0].responses[0].body == "A\n");
+    
+    const BlueprintParserOptions projections[] = {
+        SkipBodiesOption,
+        SkipSchemasOption,
+        SkipHeadersOption,
+        SkipBodiesOption | SkipSchemasOption | SkipHeadersOption,
+        ValidateOnlyOption
+    };
+    
+    for (size_t i = 0; i < sizeof(projections) / sizeof(projections[0]); ++i) {
+        Result projectedResult;
+        Blueprint projected;
+        BlueprintParser::Parse(SourceDataFixture, markdown, projections[i], projectedResult, projected);
+        
+        REQUIRE(projectedResult.error.code == Error::OK);
+        REQUIRE(projectedResult.warnings.size() == result.warnings.size());
+        for (size_t j = 0; j < result.warnings.size(); ++j) {
+            REQUIRE(projectedResult.warnings[j].message == result.warnings[j].message);
+            REQUIRE(projectedResult.warnings[j].location[0].location == result.warnings[j].location[0].location);
+        }
+    }
+}
+
+TEST_CASE("bpparser/json-bodies", "Warn about JSON bodies that are not well-formed")
+{
+    SourceData source = "# API Name\n"
+                        "# Resource 1 [/1]\n"
+                        "## GET\n"
+                        "+ Response 200 (application/json)\n\n"
+                        "        { \"a\": 1 }\n\n"
+                        "+ Response 201 (application/hal+json)\n\n"
+                        "        { \"a\" 1 }\n\n"
+                        "+ Response 202 (text/plain)\n\n"
+                        "        { \"a\" 1 }\n\n";
+    
+    MarkdownBlock::Stack markdown;
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "API Name", 1, MakeSourceDataBlock(0, 11)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Resource 1 [/1]", 1, MakeSourceDataBlock(11, 18)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "GET", 2, MakeSourceDataBlock(29, 7)));
+    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    
+    const char* signatures[] = { "Response 200 (application/json)", "Response 201 (application/hal+json)", "Response 202 (text/plain)" };
+    const char* bodies[] = { "{ \"a\": 1 }\n", "{ \"a\" 1 }\n", "{ \"a\" 1 }\n" };
+    size_t code[3];
+    size_t cur = 0;
+    for (int i = 0; i < 3; ++i) {
+        size_t signature = source.find(signatures[i], cur);
+        code[i] = source.find("        {", signature);
+        cur = source.find("\n\n", code[i]) + 1;
+        
+        markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+        markdown.push_back(MarkdownBlock(ParagraphBlockType, signatures[i], 0, MakeSourceDataBlock(signature - 2, code[i] - signature + 2)));
+        markdown.push_back(MarkdownBlock(CodeBlockType, bodies[i], 0, MakeSourceDataBlock(code[i], cur - code[i])));
+        markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, SourceDataBlock()));
+    }
+    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, SourceDataBlock()));
+    
+    Result result;
+    Blueprint blueprint;
+    BlueprintParser::Parse(source, markdown, 0, result, blueprint);
+    REQUIRE(result.error.code == Error::OK);
+    REQUIRE(result.warnings.empty());
+    
+    // Same result with the body kept as its source, copied & left out
+    BlueprintParserOptions options[] = { CheckJSONBodiesOption,
+                                         CheckJSONBodiesOption | AssetSourceOption,
+                                         CheckJSONBodiesOption | ValidateOnlyOption };
+    for (int i = 0; i < 3; ++i) {
+        Result checked;
+        Blueprint checkedBlueprint;
+        BlueprintParser::Parse(source, markdown, options[i], checked, checkedBlueprint);
+        REQUIRE(checked.error.code == Error::OK);
+        REQUIRE(checked.warnings.size() == 1);
+        REQUIRE(checked.warnings[0].kind == MalformedJSONBodyWarning);
+        REQUIRE(checked.warnings[0].message == "`application/hal+json` body is not valid JSON, expected `:` on line 1 of the body");
+        REQUIRE(checked.warnings[0].location.size() == 1);
+        REQUIRE(checked.warnings[0].location[0].location == code[1]);
+    }
+}
@@ -0,0 +1,149 @@
+//
+//  test-DeserializeJSON.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <sstream>
+#include "catch.hpp"
+#include "DeserializeJSON.h"
+#include "SerializeJSON.h"
+#include "BlueprintParser.h"
+#include "Fixture.h"
+
+using namespace snowcrash;
+using namespace snowcrashtest;
+
+// Serialize, deserialize & serialize again, both serializations must match
+static void RequireRoundTrip(const Blueprint& blueprint, SerializeJSONOptions options, Blueprint& output)
+{
+    std::stringstream json;
+    SerializeJSON(blueprint, json, options);
+
+    Error error;
+    std::stringstream input(json.str());
+    DeserializeJSON(input, output, error);
+    REQUIRE(error.code == Error::OK);
+
+    std::stringstream again;
+    SerializeJSON(output, again, options);
+    REQUIRE(again.str() == json.str());
+}
+
+TEST_CASE("dejson/round-trip", "Deserialize serialized blueprint")
+{
+    Blueprint blueprint = SerializeBlueprintFixture();
+
+    Blueprint output;
+    RequireRoundTrip(blueprint, 0, output);
+
+    REQUIRE(output.metadata.size() == 2);
+    REQUIRE(output.metadata[1].first == "HOST");
+    REQUIRE(output.metadata[1].second == "http://acme.com");
+    REQUIRE(output.name == blueprint.name);
+    REQUIRE(output.description == blueprint.description);
+    REQUIRE(output.resourceGroups.size() == 2);
+
+    const Resource& resource = output.resourceGroups[0].resources[0];
+    REQUIRE(resource.uriTemplate == "/resource/{id}");
+    REQUIRE(resource.description == "Resource\ndescription");
+    REQUIRE(resource.object.name == "My Resource");
+    REQUIRE(resource.object.body == "{ \"id\": 1 }\n");
+    REQUIRE(resource.object.headers.size() == 1);
+    REQUIRE(resource.headers.size() == 2);
+    REQUIRE(resource.methods.size() == 2);
+
+    const Method& method = resource.methods[0];
+    REQUIRE(method.method == "GET");
+    REQUIRE(method.headers.size() == 1);
+    REQUIRE(method.requests.size() == 2);
+    REQUIRE(method.requests[0].body == "Text\n\n{ ... }\n");
+    REQUIRE(method.requests[1].headers.empty());
+    REQUIRE(method.responses.size() == 2);
+    REQUIRE(method.responses[1].name == "404");
+
+    REQUIRE(resource.methods[1].method == "DELETE");
+    REQUIRE(output.resourceGroups[0].resources[1].object.name.empty());
+    REQUIRE(output.resourceGroups[1].resources.empty());
+
+    Blueprint compact;
+    RequireRoundTrip(blueprint, CompactJSONOption, compact);
+    REQUIRE(compact.resourceGroups[0].resources[0].methods[0].responses[0].body == "{ \"id\": 1 }\n");
+}
+
+TEST_CASE("dejson/round-trip-parsed", "Deserialize serialized canonical blueprint")
+{
+    MarkdownBlock::Stack markdown = CanonicalBlueprintFixture();
+
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
+    ParseSectionResult result = BlueprintParserInner::Parse(markdown.begin(), markdown.end(), parser, blueprint);
+    REQUIRE(result.first.error.code == Error::OK);
+
+    Blueprint output;
+    RequireRoundTrip(blueprint, 0, output);
+    REQUIRE(output.name == "Snowcrash API");
+    REQUIRE(output.resourceGroups.size() == 2);
+    REQUIRE(output.resourceGroups[0].resources.size() == 1);
+    
+    // Compiled URI template matches the parsed one
+    const CompiledURITemplate& parsed = blueprint.resourceGroups[0].resources[0].compiledURITemplate;
+    const CompiledURITemplate& compiled = output.resourceGroups[0].resources[0].compiledURITemplate;
+    REQUIRE(!parsed.parts.empty());
+    REQUIRE(compiled.prefix == parsed.prefix);
+    REQUIRE(compiled.parts.size() == parsed.parts.size());
+}
+
+TEST_CASE("dejson/escape", "Deserialize escaped strings")
+{
+    Blueprint blueprint;
+    blueprint.name = "\"Quoted\" \\ back\tslash\r\n";
+    blueprint.description = std::string("\x01", 1) + "\x1f/\xc3\xa9";
+
+    Blueprint output;
+    RequireRoundTrip(blueprint, 0, output);
+    REQUIRE(output.name == blueprint.name);
+    REQUIRE(output.description == blueprint.description);
+
+    char json[] = "{\"name\": \"\\u00e9\\u20ac\\ud83d\\ude00\\/\"}";
+    Error error;
+    Blueprint unicode;
+    DeserializeJSON(json, sizeof(json) - 1, unicode, error);
+    REQUIRE(error.code == Error::OK);
+    REQUIRE(unicode.name == "\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80/");
+}
+
+TEST_CASE("dejson/malformed", "Report malformed input")
+{
+    const char* inputs[] = {
+        "",
+        "[]",
+        "{\"name\": \"API\"",
+        "{\"name\": \"API\",}",
+        "{\"name\": 1}",
+        "{\"unknown\": \"\"}",
+        "{\"name\": \"A\\qB\"}",
+        "{\"name\": \"A\\u12\"}",
+        "{\"name\": \"API\"} {}",
+        "{\"metadata\": [{\"a\": \"b\", \"c\": \"d\"}]}"
+    };
+
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); ++i) {
+        std::stringstream input(inputs[i]);
+        Blueprint blueprint;
+        Error error;
+        DeserializeJSON(input, blueprint, error);
+        INFO(inputs[i]);
+        REQUIRE(error.code != Error::OK);
+    }
+
+    std::stringstream input("{\"name\": \"API\", \"resourceGroups\": [{\"name\": 42}]}");
+    Blueprint blueprint;
+    Error error;
+    DeserializeJSON(input, blueprint, error);
+    REQUIRE(error.code != Error::OK);
+    REQUIRE(error.location.size() == 1);
+    REQUIRE(error.location[0].location == 44);
+    REQUIRE(error.location[0].length == 1);
+}
@@ -128,7 +128,8 @@ TEST_CASE("hparser/parse", "Parse canonical header section")
     CHECK(markdown.size() == 6);
     
     HeaderCollection headers;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());    
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);    
     ParseSectionResult result = HeadersParser::Parse(markdown.begin(),
                                                      markdown.end(),
                                                      parser,
@@ -156,7 +157,8 @@ TEST_CASE("hparser/parse-malformed", "Parse malformed header section")
     markdown[3].content = "Content-Type: application/json\nX-My-Header:\n";
     
     HeaderCollection headers;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = HeadersParser::Parse(markdown.begin(),
                                                      markdown.end(),
                                                      parser,
@@ -197,7 +199,8 @@ TEST_CASE("hparser/parse-multiple-blocks", "Parse header section composed of mul
     markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(4, 1)));
     
     HeaderCollection headers;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = HeadersParser::Parse(markdown.begin(),
                                                      markdown.end(),
                                                      parser,
@@ -224,7 +227,8 @@ TEST_CASE("hparser/warnings", "Check warnings during parsing")
     CHECK(markdown.size() == 6);
     
     HeaderCollection headers;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = HeadersParser::Parse(markdown.begin(),
                                                      markdown.end(),
                                                      parser,
@@ -0,0 +1,92 @@
+//
+//  test-JSONCheck.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include "catch.hpp"
+#include "JSONCheck.h"
+
+using namespace snowcrash;
+
+// Returns true if the string is well-formed JSON
+static bool IsWellFormed(const std::string& json)
+{
+    size_t offset = 0;
+    const char* reason = NULL;
+    return CheckJSON(json.data(), json.length(), offset, reason);
+}
+
+TEST_CASE("jsoncheck/well-formed", "Accept well-formed JSON")
+{
+    REQUIRE(IsWellFormed("{}"));
+    REQUIRE(IsWellFormed("[]"));
+    REQUIRE(IsWellFormed("  \n\t{ }\r\n"));
+    REQUIRE(IsWellFormed("\"text\""));
+    REQUIRE(IsWellFormed("-0.5e+10"));
+    REQUIRE(IsWellFormed("true"));
+    REQUIRE(IsWellFormed("null"));
+    REQUIRE(IsWellFormed("{ \"id\": 1, \"tags\": [\"a\", \"b\"], \"owner\": { \"name\": null, \"active\": false } }"));
+    REQUIRE(IsWellFormed("[\"escapes \\\" \\\\ \\/ \\b \\f \\n \\r \\t \\u00e9 in a string longer than sixteen bytes\"]"));
+    REQUIRE(IsWellFormed("[1,                                        2]"));
+    
+    // Deep nesting
+    std::string deep = std::string(100000, '[') + std::string(100000, ']');
+    REQUIRE(IsWellFormed(deep));
+}
+
+TEST_CASE("jsoncheck/malformed", "Reject malformed JSON")
+{
+    REQUIRE(!IsWellFormed(""));
+    REQUIRE(!IsWellFormed("   "));
+    REQUIRE(!IsWellFormed("{"));
+    REQUIRE(!IsWellFormed("[1, 2"));
+    REQUIRE(!IsWellFormed("[1, 2,]"));
+    REQUIRE(!IsWellFormed("{ \"id\" 1 }"));
+    REQUIRE(!IsWellFormed("{ id: 1 }"));
+    REQUIRE(!IsWellFormed("{ \"id\": 1, }"));
+    REQUIRE(!IsWellFormed("[01]"));
+    REQUIRE(!IsWellFormed("[1.]"));
+    REQUIRE(!IsWellFormed("[-]"));
+    REQUIRE(!IsWellFormed("[tru]"));
+    REQUIRE(!IsWellFormed("\"unterminated string, longer than sixteen bytes"));
+    REQUIRE(!IsWellFormed("\"invalid escape \\x\""));
+    REQUIRE(!IsWellFormed("\"invalid unicode escape \\u00g0\""));
+    REQUIRE(!IsWellFormed("\"control character\nin a string longer than sixteen bytes\""));
+    REQUIRE(!IsWellFormed("{} {}"));
+    REQUIRE(!IsWellFormed("[1, 2]]"));
+    REQUIRE(!IsWellFormed(std::string(100000, '[')));
+}
+
+TEST_CASE("jsoncheck/error-offset", "Report offending byte")
+{
+    std::string json = "{\n  \"id\": 1,\n  \"name\" \"A\"\n}";
+    size_t offset = 0;
+    const char* reason = NULL;
+    REQUIRE(!CheckJSON(json.data(), json.length(), offset, reason));
+    REQUIRE(offset == json.find("\"A\""));
+    REQUIRE(std::string(reason) == "expected `:`");
+    
+    json = "[\"0123456789abcdef\x01\"]";
+    REQUIRE(!CheckJSON(json.data(), json.length(), offset, reason));
+    REQUIRE(offset == 18);
+    REQUIRE(std::string(reason) == "unescaped control character in string");
+}
+
+TEST_CASE("jsoncheck/media-type", "Recognize JSON media types")
+{
+    REQUIRE(IsJSONMediaType("application/json"));
+    REQUIRE(IsJSONMediaType("Application/JSON; charset=utf-8"));
+    REQUIRE(IsJSONMediaType(" application/hal+json "));
+    REQUIRE(!IsJSONMediaType(""));
+    REQUIRE(!IsJSONMediaType("text/plain"));
+    REQUIRE(!IsJSONMediaType("application/jsonp"));
+    REQUIRE(!IsJSONMediaType("+json"));
+    
+    Payload payload;
+    payload.headers.push_back(std::make_pair("X-Id", "1"));
+    REQUIRE(PayloadMediaType(payload).empty());
+    payload.headers.push_back(std::make_pair("content-type", "application/json"));
+    REQUIRE(PayloadMediaType(payload) == "application/json");
+}
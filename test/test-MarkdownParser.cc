@@ -612,3 +612,54 @@ TEST_CASE("mdparser/parse-header-only", "parsing asserting header one liner")
     REQUIRE(markdown[0].data == 1);
 }
 
+
+TEST_CASE("mdparser/budget", "stop rendering Markdown on exceeded budget")
+{
+    const std::string source = \
+"# header\n\
+\n\
+paragraph\n\
+\n\
++ A\n\
+    + B\n\
+        + C\n\
+";
+    
+    MarkdownParser parser;
+    ParserBudget budget;
+    
+    // Within budget
+    Result result;
+    MarkdownBlock::Stack markdown;
+    parser.parse(source, result, markdown, &budget);
+    REQUIRE(result.error.code == Error::OK);
+    REQUIRE(markdown.size() == 14);
+    
+    // Too many blocks
+    budget.maxBlocks = 2;
+    Result blocksResult;
+    MarkdownBlock::Stack blocksMarkdown;
+    parser.parse(source, blocksResult, blocksMarkdown, &budget);
+    REQUIRE(blocksResult.error.code == ParserBudget::ErrorCode);
+    REQUIRE(blocksResult.error.message == "parser budget exceeded: blocks");
+    REQUIRE(blocksMarkdown.size() == 2);
+    
+    // Nested too deep
+    budget.maxBlocks = 0;
+    budget.maxNesting = 4;
+    Result nestingResult;
+    MarkdownBlock::Stack nestingMarkdown;
+    parser.parse(source, nestingResult, nestingMarkdown, &budget);
+    REQUIRE(nestingResult.error.code == ParserBudget::ErrorCode);
+    REQUIRE(nestingResult.error.message == "parser budget exceeded: nesting");
+    
+    // Too much text
+    budget.maxNesting = 0;
+    budget.maxOutputBytes = 8;
+    Result bytesResult;
+    MarkdownBlock::Stack bytesMarkdown;
+    parser.parse(source, bytesResult, bytesMarkdown, &budget);
+    REQUIRE(bytesResult.error.code == ParserBudget::ErrorCode);
+    REQUIRE(bytesResult.error.message == "parser budget exceeded: output bytes");
+    REQUIRE(bytesMarkdown.size() == 1);
+}
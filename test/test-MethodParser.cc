@@ -16,59 +16,6 @@
 using namespace snowcrash;
 using namespace snowcrashtest;
 
-MarkdownBlock::Stack snowcrashtest::CanonicalMethodFixture()
-{
-    // Blueprint in question:
-    //R"(
-    //# My Method [GET]
-    //Method Description
-    //
-    //+ Headers
-    //
-    //        X-Method-Header: 0xdeadbeef
-    //
-    // <see CanonicalPayloadFixture()>
-    //
-    //+ Response 200 (text/plain)
-    //
-    //       OK.
-    //
-    //)";
-    
-    MarkdownBlock::Stack markdown;
-    markdown.push_back(MarkdownBlock(HeaderBlockType, "My Method [GET]", 1, MakeSourceDataBlock(0, 1)));
-    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Method Description", 0, MakeSourceDataBlock(1, 1)));
-    
-    MarkdownBlock::Stack headerList;
-    headerList.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
-    headerList.push_back(MarkdownBlock(ParagraphBlockType, "Headers", 0, MakeSourceDataBlock(1, 1)));
-    headerList.push_back(MarkdownBlock(CodeBlockType, "X-Method-Header: 0xdeadbeef", 0, MakeSourceDataBlock(2, 1)));
-    headerList.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, MakeSourceDataBlock(3, 1)));
-    
-    MarkdownBlock::Stack listBlock = CanonicalPayloadFixture();
-    
-    // inject headers into payload list
-    MarkdownBlock::Stack::iterator cur = listBlock.begin();
-    ++cur;
-    listBlock.insert(cur, headerList.begin(), headerList.end());
-    
-    // inject response into payload list
-    MarkdownBlock::Stack responseList;
-    responseList.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
-    responseList.push_back(MarkdownBlock(ParagraphBlockType, "Response 200 (text/plain)", 0, MakeSourceDataBlock(4, 1)));
-    responseList.push_back(MarkdownBlock(CodeBlockType, "OK.", 0, MakeSourceDataBlock(5, 1)));
-    responseList.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, MakeSourceDataBlock(6, 1)));
-    
-    cur = listBlock.begin();
-    ++cur;
-    listBlock.insert(cur, responseList.begin(), responseList.end());
-    
-    // inject complete list into final markdown
-    markdown.insert(markdown.end(), listBlock.begin(), listBlock.end());
-
-    return markdown;
-}
-
 TEST_CASE("mparser/classifier", "Method block classifier")
 {
     MarkdownBlock::Stack markdown = CanonicalMethodFixture();
@@ -153,7 +100,8 @@ TEST_CASE("mparser/parse", "Parse method")
 {
     MarkdownBlock::Stack markdown = CanonicalMethodFixture();   
     Method method;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = MethodParser::Parse(markdown.begin(),
                                                     markdown.end(),
                                                     parser,
@@ -210,7 +158,8 @@ TEST_CASE("mparser/parse-list-description", "Parse description with list")
     markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(4, 1)));
     
     Method method;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = MethodParser::Parse(markdown.begin(), markdown.end(), parser, method);
     
     REQUIRE(result.first.error.code != Error::OK);
@@ -243,7 +192,8 @@ TEST_CASE("mparser/parse-list-description-request", "Parse description with list
     markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(5, 1)));
     
     Method method;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());    
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);    
     ParseSectionResult result = MethodParser::Parse(markdown.begin(), markdown.end(), parser, method);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -283,7 +233,8 @@ TEST_CASE("mparser/response-regex-problem", "Parse method with response not matc
     markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(2, 1)));
 
     Method method;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = MethodParser::Parse(markdown.begin(), markdown.end(), parser, method);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -392,7 +343,8 @@ TEST_CASE("mparser/parse-multi-request-response", "Parse method with multiple re
     markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(29, 1)));
     
     Method method;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = MethodParser::Parse(markdown.begin(), markdown.end(), parser, method);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -470,7 +422,8 @@ TEST_CASE("mparser/parse-multi-request-incomplete", "Parse method with multiple
     markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(5, 1)));
 
     Method method;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = MethodParser::Parse(markdown.begin(), markdown.end(), parser, method);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -534,7 +487,8 @@ TEST_CASE("mparser/parse-foreign", "Parse method with foreign item")
     markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(9, 1)));
     
     Method method;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = MethodParser::Parse(markdown.begin(), markdown.end(), parser, method);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -581,7 +535,8 @@ TEST_CASE("mparser/parse-inline-method-payload", "Parse method with inline paylo
     markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(4, 1)));
     
     Method method;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = MethodParser::Parse(markdown.begin(), markdown.end(), parser, method);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -616,7 +571,8 @@ TEST_CASE("mparser/parse-hr", "Parse method with a HR")
     markdown.push_back(MarkdownBlock(ParagraphBlockType, "A", 0, MakeSourceDataBlock(2, 1)));
     
     Method method;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = MethodParser::Parse(markdown.begin(), markdown.end(), parser, method);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -645,7 +601,8 @@ TEST_CASE("mparser/parse-implicit-termination", "Parse incomplete method followe
     markdown.push_back(MarkdownBlock(HeaderBlockType, "/2", 1, MakeSourceDataBlock(1, 1)));
     
     Method method;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = MethodParser::Parse(markdown.begin(), markdown.end(), parser, method);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -663,7 +620,8 @@ TEST_CASE("mparser/header-warnings", "Check warnings on overshadowing a header")
 {
     MarkdownBlock::Stack markdown = CanonicalMethodFixture();
     Method method;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     method.headers.push_back(std::make_pair("X-Header", "24"));
     ParseSectionResult result = MethodParser::Parse(markdown.begin(),
                                                     markdown.end(),
@@ -687,7 +645,8 @@ TEST_CASE("mparser/parse-nameless-method", "Parse method without name")
     markdown.push_back(MarkdownBlock(HeaderBlockType, "GET", 2, MakeSourceDataBlock(0, 1)));
     
     Method method;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = MethodParser::Parse(markdown.begin(), markdown.end(), parser, method);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -720,7 +679,8 @@ TEST_CASE("mparser/not-parse-object", "Make sure method with object payload is n
     markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(2, 1)));
     
     Method method;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = MethodParser::Parse(markdown.begin(), markdown.end(), parser, method);
     
     REQUIRE(result.first.error.code != Error::OK);
@@ -739,7 +699,8 @@ TEST_CASE("mparser/adjacent-group", "Make sure method followed by a group does n
     markdown.push_back(MarkdownBlock(HeaderBlockType, "Group Two", 1, MakeSourceDataBlock(1, 1)));
     
     Method method;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = MethodParser::Parse(markdown.begin(), markdown.end(), parser, method);
     
     REQUIRE(result.first.error.code == Error::OK);
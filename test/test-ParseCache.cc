@@ -0,0 +1,148 @@
+//
+//  test-ParseCache.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "catch.hpp"
+#include "Fixture.h"
+#include "ParseCache.h"
+
+#if defined(_WIN32)
+#   include <sys/utime.h>
+#else
+#   include <utime.h>
+#endif
+
+using namespace snowcrash;
+using namespace snowcrashtest;
+
+// Returns true if the file exists
+static bool FileExists(const std::string& path)
+{
+    std::ifstream is(path.c_str(), std::ios::binary);
+    return is.is_open();
+}
+
+// Size of a file
+static size_t FileSize(const std::string& path)
+{
+    struct stat info;
+    if (::stat(path.c_str(), &info) != 0)
+        return 0;
+
+    return static_cast<size_t>(info.st_size);
+}
+
+// Write a file with given content
+static void WriteFile(const std::string& path, const std::string& content)
+{
+    std::ofstream os(path.c_str(), std::ios::binary);
+    os << content;
+}
+
+// Set file access & modification time, seconds before now
+static void SetFileAge(const std::string& path, time_t age)
+{
+    struct utimbuf times;
+    times.actime = ::time(NULL) - age;
+    times.modtime = times.actime;
+    ::utime(path.c_str(), &times);
+}
+
+TEST_CASE("parsecache/key", "Compute cache entry key")
+{
+    std::string key = ParseCache::Key("# API", 0, "json");
+    REQUIRE(key.length() == 32);
+    REQUIRE(key.find_first_not_of("0123456789abcdef") == std::string::npos);
+
+    // Same input, same key
+    REQUIRE(ParseCache::Key("# API", 0, "json") == key);
+
+    // Source, options & format are all part of the key
+    REQUIRE(ParseCache::Key("# API 2", 0, "json") != key);
+    REQUIRE(ParseCache::Key("# API", RequireBlueprintNameOption, "json") != key);
+    REQUIRE(ParseCache::Key("# API", 0, "yaml") != key);
+}
+
+TEST_CASE("parsecache/store-fetch", "Store and retrieve cache entry")
+{
+    TemporaryDirectory directory;
+    REQUIRE(!directory.path().empty());
+
+    ParseCache cache(directory.path());
+    std::string key = ParseCache::Key("# API", 0, "json");
+
+    std::string output;
+    Result result;
+    REQUIRE(!cache.fetch(key, output, result));
+
+    Result stored;
+    stored.warnings.push_back(Warning("warning message", 2, MakeSourceDataBlock(1, 2)));
+    REQUIRE(cache.store(key, "{ \"name\": \"API\" }\n", stored));
+
+    REQUIRE(cache.fetch(key, output, result));
+    REQUIRE(output == "{ \"name\": \"API\" }\n");
+    REQUIRE(result.error.code == Error::OK);
+    REQUIRE(result.warnings.size() == 1);
+    REQUIRE(result.warnings[0].message == "warning message");
+    REQUIRE(result.warnings[0].code == 2);
+    REQUIRE(result.warnings[0].location.size() == 1);
+    REQUIRE(result.warnings[0].location[0].location == 1);
+    REQUIRE(result.warnings[0].location[0].length == 2);
+
+    // Entry without signature is a miss
+    WriteFile(directory.filePath(key), "{ \"name\": \"API\" }\n");
+    REQUIRE(!cache.fetch(key, output, result));
+}
+
+TEST_CASE("parsecache/evict", "Evict least recently used entries only")
+{
+    TemporaryDirectory directory;
+    REQUIRE(!directory.path().empty());
+
+    std::string keys[3];
+    for (int i = 0; i < 3; ++i) {
+        std::stringstream source;
+        source << "# API " << i;
+        keys[i] = ParseCache::Key(source.str(), 0, "json");
+    }
+
+    const std::string output(1024, 'x');
+    ParseCache unlimited(directory.path(), 1024 * 1024);
+    REQUIRE(unlimited.store(keys[0], output, Result()));
+    REQUIRE(unlimited.store(keys[1], output, Result()));
+    size_t entrySize = FileSize(directory.filePath(keys[0]));
+    REQUIRE(entrySize > output.length());
+    SetFileAge(directory.filePath(keys[0]), 200);
+    SetFileAge(directory.filePath(keys[1]), 100);
+
+    // Older & larger files that are not entries
+    const std::string unrelated(4 * entrySize, 'y');
+    const std::string unrelatedNames[] = {
+        "notes.txt",
+        keys[2] + ".tmp12345",
+        "0123456789abcdef0123456789abcdef"
+    };
+    for (int i = 0; i < 3; ++i) {
+        WriteFile(directory.filePath(unrelatedNames[i]), unrelated);
+        SetFileAge(directory.filePath(unrelatedNames[i]), 1000);
+    }
+
+    // Room for two entries
+    ParseCache cache(directory.path(), 2 * entrySize + entrySize / 2);
+    REQUIRE(cache.store(keys[2], output, Result()));
+
+    REQUIRE(!FileExists(directory.filePath(keys[0])));
+    REQUIRE(FileExists(directory.filePath(keys[1])));
+    REQUIRE(FileExists(directory.filePath(keys[2])));
+
+    for (int i = 0; i < 3; ++i)
+        REQUIRE(FileSize(directory.filePath(unrelatedNames[i])) == unrelated.length());
+}
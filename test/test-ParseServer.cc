@@ -0,0 +1,174 @@
+//
+//  test-ParseServer.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <cstring>
+#include <sstream>
+#include "catch.hpp"
+#include "Fixture.h"
+#include "ParseServer.h"
+#include "SerializeJSON.h"
+#include "Timer.h"
+
+#if !defined(_WIN32)
+#   include <csignal>
+#   include <pthread.h>
+#   include <sys/socket.h>
+#   include <sys/un.h>
+#   include <unistd.h>
+#endif
+
+using namespace snowcrash;
+using namespace snowcrashtest;
+
+// JSON format serializer
+static void SerializeFormat(const Blueprint& blueprint, const std::string& format, std::ostream& os)
+{
+    SerializeJSON(blueprint, os, (format == "json-compact") ? CompactJSONOption : 0);
+}
+
+TEST_CASE("parseserver/frame-length", "Encode & decode frame length prefix")
+{
+    unsigned char prefix[ParseFramePrefixSize];
+    EncodeParseFrameLength(0x01020304, prefix);
+    REQUIRE(prefix[0] == 0x01);
+    REQUIRE(prefix[1] == 0x02);
+    REQUIRE(prefix[2] == 0x03);
+    REQUIRE(prefix[3] == 0x04);
+    REQUIRE(DecodeParseFrameLength(prefix) == 0x01020304);
+
+    EncodeParseFrameLength(0, prefix);
+    REQUIRE(DecodeParseFrameLength(prefix) == 0);
+
+    EncodeParseFrameLength(MaxParsePayloadSize, prefix);
+    REQUIRE(DecodeParseFrameLength(prefix) == MaxParsePayloadSize);
+}
+
+TEST_CASE("parseserver/request", "Encode & decode parse request")
+{
+    ParseRequest request;
+    request.options = RenderDescriptionsOption | RequireBlueprintNameOption;
+    request.format = "json";
+    request.source = "# API\n\nLine 1\nLine 2\n";
+
+    std::string payload = EncodeParseRequest(request);
+    REQUIRE(payload.find("json\n# API\n") != std::string::npos);
+
+    ParseRequest decoded;
+    REQUIRE(DecodeParseRequest(payload, decoded));
+    REQUIRE(decoded.options == request.options);
+    REQUIRE(decoded.format == "json");
+    REQUIRE(decoded.source == request.source);
+
+    // Validation request, empty format & source
+    request.format.clear();
+    request.source.clear();
+    REQUIRE(DecodeParseRequest(EncodeParseRequest(request), decoded));
+    REQUIRE(decoded.format.empty());
+    REQUIRE(decoded.source.empty());
+
+    // Malformed
+    REQUIRE(!DecodeParseRequest("", decoded));
+    REQUIRE(!DecodeParseRequest("0\njson", decoded));
+    REQUIRE(!DecodeParseRequest("options\njson\n# API", decoded));
+}
+
+#if !defined(_WIN32)
+
+namespace {
+
+    // Daemon served on its own thread
+    struct ServerThread {
+        std::string socketPath;
+        std::string error;
+        bool success;
+
+        static void* run(void* context) {
+            ServerThread* server = static_cast<ServerThread*>(context);
+            server->success = ServeParseRequests(server->socketPath, SerializeFormat, server->error);
+            return NULL;
+        }
+    };
+
+    // Connect to a socket without sending anything, returns the descriptor or -1
+    int ConnectIdle(const std::string& socketPath)
+    {
+        struct sockaddr_un address;
+        ::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        ::memcpy(address.sun_path, socketPath.c_str(), socketPath.length() + 1);
+
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 && ::connect(fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0) {
+            ::close(fd);
+            fd = -1;
+        }
+
+        return fd;
+    }
+}
+
+TEST_CASE("parseserver/round-trip", "Parse by the daemon over a socket")
+{
+    TemporaryDirectory directory;
+    REQUIRE(!directory.path().empty());
+
+    ServerThread server;
+    server.socketPath = directory.filePath("snowcrash.sock");
+    server.success = false;
+
+    pthread_t thread;
+    REQUIRE(pthread_create(&thread, NULL, ServerThread::run, &server) == 0);
+
+    ParseRequest request;
+    request.format = "json";
+    request.source = "# API\nDescription\n\n# GET /resource\n+ Response 200\n\n        OK.\n";
+
+    // Wait for the daemon to serve
+    std::string output;
+    Result result;
+    std::string error;
+    bool served = false;
+    for (int i = 0; i < 500 && !served; ++i) {
+        served = RequestParse(server.socketPath, request, output, result, error);
+        if (!served)
+            ::usleep(10000);
+    }
+    REQUIRE(served);
+
+    // Same as parsed in the process
+    Result expectedResult;
+    Blueprint blueprint;
+    parse(request.source, request.options, expectedResult, blueprint);
+    std::stringstream expected;
+    SerializeFormat(blueprint, request.format, expected);
+
+    REQUIRE(output == expected.str());
+    REQUIRE(result.error.code == expectedResult.error.code);
+    REQUIRE(result.warnings.size() == expectedResult.warnings.size());
+
+    // A connection sending nothing does not hold up other requests
+    int idle = ConnectIdle(server.socketPath);
+    REQUIRE(idle >= 0);
+
+    double start = Now();
+    request.format.clear();
+    REQUIRE(RequestParse(server.socketPath, request, output, result, error));
+    REQUIRE(Now() - start < 5.0);
+    REQUIRE(output.empty());
+    REQUIRE(result.error.code == expectedResult.error.code);
+
+    ::close(idle);
+
+    // Stop serving
+    pthread_kill(thread, SIGTERM);
+    pthread_join(thread, NULL);
+    REQUIRE(server.success);
+    REQUIRE(server.error.empty());
+    REQUIRE(::access(server.socketPath.c_str(), F_OK) != 0);
+}
+
+#endif
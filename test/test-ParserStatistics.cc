@@ -0,0 +1,182 @@
+//
+//  test-ParserStatistics.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <sstream>
+#include <vector>
+#include "catch.hpp"
+#include "Fixture.h"
+#include "BlueprintParser.h"
+#include "Parser.h"
+#include "ParserStatistics.h"
+#include "Timer.h"
+
+using namespace snowcrash;
+using namespace snowcrashtest;
+
+TEST_CASE("statistics/init", "Statistics construction")
+{
+    ParserStatistics statistics;
+    
+    for (size_t i = 0; i < ParserPhaseCount; ++i) {
+        REQUIRE(statistics.time[i] == 0.0);
+        REQUIRE(statistics.allocations[i] == 0);
+        REQUIRE(statistics.allocatedBytes[i] == 0);
+        REQUIRE(statistics.peakLiveBytes[i] == 0);
+    }
+    
+    for (size_t i = 0; i < MarkdownBlockTypeCount; ++i)
+        REQUIRE(statistics.blocks[i] == 0);
+    
+    for (size_t i = 0; i < SectionCount; ++i)
+        REQUIRE(statistics.sections[i] == 0);
+    
+    REQUIRE(statistics.bytes == 0);
+    REQUIRE(statistics.regexEvaluations == 0);
+    REQUIRE(statistics.lookups == 0);
+    REQUIRE(statistics.warnings == 0);
+    REQUIRE(statistics.peakASTSize == 0);
+}
+
+TEST_CASE("statistics/blueprint", "Collect statistics of blueprint parsing")
+{
+    MarkdownBlock::Stack markdown = CanonicalBlueprintFixture();
+    
+    Result result;
+    Blueprint blueprint;
+    BlueprintParser::Parse(SourceDataFixture, markdown, 0, result, blueprint);
+    REQUIRE(result.error.code == Error::OK);
+    
+    Result statisticsResult;
+    Blueprint statisticsBlueprint;
+    ParserStatistics statistics;
+    BlueprintParser::Parse(SourceDataFixture, markdown, 0, statisticsResult, statisticsBlueprint, NULL, &statistics);
+    REQUIRE(statisticsResult.error.code == Error::OK);
+    
+    // Statistics do not change the output
+    REQUIRE(statisticsResult.warnings.size() == result.warnings.size());
+    REQUIRE(statisticsBlueprint.resourceGroups.size() == blueprint.resourceGroups.size());
+    
+    REQUIRE(statistics.sections[ResourceGroupSection] > 0);
+    REQUIRE(statistics.sections[ResourceSection] > 0);
+    REQUIRE(statistics.sections[MethodSection] > 0);
+    
+    size_t astSize = 0;
+    for (Collection<ResourceGroup>::const_iterator it = blueprint.resourceGroups.begin();
+         it != blueprint.resourceGroups.end();
+         ++it)
+        astSize += ASTSize(*it);
+    
+    REQUIRE(astSize > blueprint.resourceGroups.size());
+    REQUIRE(statistics.peakASTSize == astSize);
+    REQUIRE(statistics.astSize == statistics.peakASTSize);
+}
+
+TEST_CASE("statistics/ast-size", "Peak AST size accounting")
+{
+    ResourceGroup resourceGroup;
+    REQUIRE(ASTSize(resourceGroup) == 1);
+    
+    Resource resource;
+    Method method;
+    method.requests.push_back(Request());
+    method.responses.push_back(Response());
+    method.responses.push_back(Response());
+    resource.methods.push_back(method);
+    resourceGroup.resources.push_back(resource);
+    REQUIRE(ASTSize(resourceGroup) == 6);
+    
+    ParserStatistics statistics;
+    CountASTSize(statistics, 6, 2);
+    CountASTSize(statistics, 6, 2);
+    REQUIRE(statistics.astSize == 4);
+    REQUIRE(statistics.peakASTSize == 8);
+    
+    CountASTSize(statistics, 1, 1);
+    REQUIRE(statistics.astSize == 5);
+    REQUIRE(statistics.peakASTSize == 8);
+}
+
+TEST_CASE("statistics/parser", "Collect statistics of parsing")
+{
+    Parser parser;
+    Result result;
+    Blueprint blueprint;
+    ParserStatistics statistics;
+    parser.parse("# API\n", 0, result, blueprint, NULL, &statistics);
+    REQUIRE(result.error.code == Error::OK);
+    
+    REQUIRE(statistics.bytes == 6);
+    REQUIRE(statistics.warnings == result.warnings.size());
+    REQUIRE(statistics.time[CheckSourcePhase] >= 0.0);
+    REQUIRE(statistics.time[SerializePhase] == 0.0);
+}
+
+TEST_CASE("statistics/print", "Print statistics")
+{
+    ParserStatistics statistics;
+    statistics.bytes = 42;
+    statistics.blocks[HeaderBlockType] = 3;
+    statistics.sections[ResourceSection] = 2;
+    
+    std::stringstream text;
+    PrintStatistics(statistics, text);
+    REQUIRE(text.str().find("header") != std::string::npos);
+    REQUIRE(text.str().find("resource ") != std::string::npos);
+    REQUIRE(text.str().find("42") != std::string::npos);
+    
+    std::stringstream json;
+    PrintStatisticsJSON(statistics, json);
+    REQUIRE(json.str().find("\"bytes\":42") != std::string::npos);
+    REQUIRE(json.str().find("\"header\":3") != std::string::npos);
+    REQUIRE(json.str().find("\"resource\":2") != std::string::npos);
+}
+
+TEST_CASE("timer/scoped", "Scoped timer")
+{
+    double elapsed = 0;
+    {
+        Timer timer(&elapsed);
+    }
+    REQUIRE(elapsed >= 0.0);
+    
+    double start = Now();
+    REQUIRE(Now() >= start);
+    
+    // No counter, no time taken
+    Timer timer(NULL);
+}
+
+TEST_CASE("statistics/phase-allocations", "Phase scope allocation accounting")
+{
+    ParserStatistics statistics;
+    {
+        ParserPhaseScope phase(&statistics, MarkdownPhase);
+        std::vector<char> buffer(1024);
+        buffer[0] = 'x';
+    }
+    
+    REQUIRE(statistics.time[MarkdownPhase] >= 0.0);
+    REQUIRE(statistics.allocations[BlueprintPhase] == 0);
+    
+    if (AllocationAccountingEnabled()) {
+        REQUIRE(statistics.allocations[MarkdownPhase] >= 1);
+        REQUIRE(statistics.allocatedBytes[MarkdownPhase] >= 1024);
+        REQUIRE(statistics.peakLiveBytes[MarkdownPhase] >= 1024);
+        
+        std::stringstream json;
+        PrintStatisticsJSON(statistics, json);
+        REQUIRE(json.str().find("\"allocations\":{\"check\"") != std::string::npos);
+    }
+    else {
+        REQUIRE(statistics.allocations[MarkdownPhase] == 0);
+        REQUIRE(statistics.allocatedBytes[MarkdownPhase] == 0);
+        REQUIRE(ThreadAllocationCounters().allocations == 0);
+    }
+    
+    // No statistics, nothing collected
+    ParserPhaseScope phase(NULL, SerializePhase);
+}
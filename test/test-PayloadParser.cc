@@ -7,6 +7,7 @@
 //
 
 #include <iterator>
+#include <sstream>
 #include "catch.hpp"
 #include "PayloadParser.h"
 #include "Fixture.h"
@@ -14,57 +15,6 @@
 using namespace snowcrash;
 using namespace snowcrashtest;
 
-MarkdownBlock::Stack snowcrashtest::CanonicalPayloadFixture()
-{
-    // Blueprint in question:
-    //R"(
-    //+ Request Hello World (text/plain)
-    //
-    //  Description
-    //
-    //    + Headers
-    //
-    //            X-Header: 42
-    //
-    //    + Body
-    //
-    //            Code
-    //
-    //    + Schema
-    //
-    //            Code 2
-    //
-    //)";
-    
-    MarkdownBlock::Stack markdown;
-    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
-    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
-    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Request Hello World (text/plain)", 0, MakeSourceDataBlock(0, 1)));
-    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Description", 0, MakeSourceDataBlock(1, 1)));
-    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
-
-    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
-    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Headers", 0, MakeSourceDataBlock(2, 1)));
-    markdown.push_back(MarkdownBlock(CodeBlockType, "X-Header: 42", 0, MakeSourceDataBlock(3, 1)));
-    markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, MakeSourceDataBlock(4, 1)));
-    
-    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
-    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Body", 0, MakeSourceDataBlock(4, 1)));
-    markdown.push_back(MarkdownBlock(CodeBlockType, "Code", 0, MakeSourceDataBlock(4, 1)));
-    markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, MakeSourceDataBlock(5, 1)));
-    
-    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
-    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Schema", 0, MakeSourceDataBlock(6, 1)));
-    markdown.push_back(MarkdownBlock(CodeBlockType, "Code 2", 0, MakeSourceDataBlock(7, 1)));
-    markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, MakeSourceDataBlock(8, 1)));
-    
-    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(9, 1)));
-    markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, MakeSourceDataBlock(10, 1)));
-    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(11, 1)));
-    
-    return markdown;
-}
-
 TEST_CASE("pldparser/classifier", "Payload block classifier")
 {
     MarkdownBlock::Stack markdown = CanonicalPayloadFixture();
@@ -131,7 +81,8 @@ TEST_CASE("pldparser/parse", "Parse canonical payload")
 {
     MarkdownBlock::Stack markdown = CanonicalPayloadFixture();    
     Payload payload;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = PayloadParser::Parse(markdown.begin(), markdown.end(), parser, payload);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -181,7 +132,8 @@ TEST_CASE("pldparser/parse-list-description", "Parse description with list")
     markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(4, 1)));
     
     Payload payload;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = PayloadParser::Parse(markdown.begin(), markdown.end(), parser, payload);
     
     REQUIRE(result.first.error.code != Error::OK);
@@ -205,7 +157,8 @@ TEST_CASE("pldparser/parse-one", "Parse just one payload in a list with multiple
     markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(2, 1)));
     
     Payload payload;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = PayloadParser::Parse(markdown.begin(), markdown.end(), parser, payload);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -240,7 +193,8 @@ TEST_CASE("pldparser/parse-one-foreign", "Parse just one payload in a list with
     markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(2, 1)));
     
     Payload payload;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = PayloadParser::Parse(markdown.begin(), markdown.end(), parser, payload);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -293,7 +247,8 @@ TEST_CASE("pldparser/parse-payload-foreign-listitem", "Parse payload with foreig
     markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(8, 1)));
     
     Payload payload;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = PayloadParser::Parse(markdown.begin(), markdown.end(), parser, payload);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -343,7 +298,8 @@ TEST_CASE("pldparser/parse-payload-foreign-block", "Parse payload with foreign b
     markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(7, 1)));
     
     Payload payload;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = PayloadParser::Parse(markdown.begin(), markdown.end(), parser, payload);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -379,7 +335,8 @@ TEST_CASE("pldparser/parse-abbrev-body", "Parse abbreviated payload body")
     markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(3, 1)));
     
     Payload payload;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = PayloadParser::Parse(markdown.begin(), markdown.end(), parser, payload);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -412,7 +369,8 @@ TEST_CASE("pldparser/parse-abbrev-inline", "Parse abbreviated inline payload bod
     markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(1, 1)));
     
     Payload payload;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = PayloadParser::Parse(markdown.begin(), markdown.end(), parser, payload);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -446,7 +404,8 @@ TEST_CASE("pldparser/parse-symbol-inline-reference", "Parse inline payload with
     
     Payload payload;
     
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ResourceObject object;
     object.name = "Symbol";
     object.description = "Foo";
@@ -492,7 +451,8 @@ TEST_CASE("pldparser/parse-symbol-reference", "Parse payload with symbol referen
     
     Payload payload;
     
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ResourceObject object;
     object.name = "Symbol";
     object.description = "Foo";
@@ -541,7 +501,8 @@ TEST_CASE("pldparser/fix-missing-source-map", "Issue: Fix missing source map")
     markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(3, 1)));
     
     Payload payload;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = PayloadParser::Parse(markdown.begin(), markdown.end(), parser, payload);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -553,3 +514,115 @@ TEST_CASE("pldparser/fix-missing-source-map", "Issue: Fix missing source map")
     REQUIRE(result.first.warnings[0].location.size() == 1);
 }
 
+
+TEST_CASE("pldparser/asset-source", "Keep code block body as its source")
+{
+    SourceData source = "+ Request\n    + Body\n\n            {\n              \"a\": 1\n            }\n\n";
+    size_t code = source.find("            {");
+    
+    MarkdownBlock::Stack markdown;
+    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Request", 0, MakeSourceDataBlock(0, 10)));
+    
+    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Body", 0, MakeSourceDataBlock(10, 13)));
+    markdown.push_back(MarkdownBlock(CodeBlockType, "{\n  \"a\": 1\n}\n", 0, MakeSourceDataBlock(code, source.length() - code)));
+    markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, SourceDataBlock()));
+    
+    markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, SourceDataBlock()));
+    
+    Blueprint blueprint;
+    
+    Payload payload;
+    BlueprintParserCore parser(0, source, blueprint);
+    ParseSectionResult result = PayloadParser::Parse(markdown.begin(), markdown.end(), parser, payload);
+    REQUIRE(result.first.error.code == Error::OK);
+    REQUIRE(payload.body == "{\n  \"a\": 1\n}\n");
+    REQUIRE(payload.bodySource.sourceMap.empty());
+    
+    Payload sourcePayload;
+    BlueprintParserCore sourceParser(AssetSourceOption, source, blueprint);
+    ParseSectionResult sourceResult = PayloadParser::Parse(markdown.begin(), markdown.end(), sourceParser, sourcePayload);
+    REQUIRE(sourceResult.first.error.code == Error::OK);
+    REQUIRE(sourceResult.first.warnings.size() == result.first.warnings.size());
+    REQUIRE(sourceResult.second == result.second);
+    
+    // Single code block is a single range, trailing blank line left out
+    REQUIRE(sourcePayload.body.empty());
+    REQUIRE(sourcePayload.bodySource.indentation == 12);
+    REQUIRE(sourcePayload.bodySource.sourceMap.size() == 1);
+    REQUIRE(sourcePayload.bodySource.sourceMap[0].location == code);
+    REQUIRE(sourcePayload.bodySource.sourceMap[0].length == source.length() - code - 1);
+    REQUIRE(MapAsset(source, sourcePayload.bodySource) == payload.body);
+    REQUIRE(sourcePayload.bodySource.source == &source);
+    
+    Asset storage;
+    REQUIRE(PayloadBody(sourcePayload, storage) == payload.body);
+    REQUIRE(&PayloadBody(payload, storage) == &payload.body);
+    
+    std::stringstream ss;
+    WriteAsset(source, sourcePayload.bodySource, ss);
+    REQUIRE(ss.str() == payload.body);
+    
+    // Content other than its source is copied
+    markdown[6].content = "{}\n";
+    Payload copiedPayload;
+    BlueprintParserCore copiedParser(AssetSourceOption, source, blueprint);
+    PayloadParser::Parse(markdown.begin(), markdown.end(), copiedParser, copiedPayload);
+    REQUIRE(copiedPayload.body == "{}\n");
+    REQUIRE(copiedPayload.bodySource.sourceMap.empty());
+}
+
+
+TEST_CASE("pldparser/json-body-source", "Keep body to be checked as its source")
+{
+    SourceData source = "+ Request\n    + Body\n\n            {\n              \"a\": 1\n            }\n\n";
+    size_t code = source.find("            {");
+    
+    MarkdownBlock::Stack markdown;
+    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Request", 0, MakeSourceDataBlock(0, 10)));
+    
+    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Body", 0, MakeSourceDataBlock(10, 13)));
+    markdown.push_back(MarkdownBlock(CodeBlockType, "{\n  \"a\": 1\n}\n", 0, MakeSourceDataBlock(code, source.length() - code)));
+    markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, SourceDataBlock()));
+    
+    markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, SourceDataBlock()));
+    
+    Blueprint blueprint;
+    
+    // Built or left out, the body is checked from its source
+    BlueprintParserOptions options[] = { CheckJSONBodiesOption, CheckJSONBodiesOption | SkipBodiesOption };
+    for (int i = 0; i < 2; ++i) {
+        Payload payload;
+        BlueprintParserCore parser(options[i], source, blueprint);
+        ParseSectionResult result = PayloadParser::Parse(markdown.begin(), markdown.end(), parser, payload);
+        REQUIRE(result.first.error.code == Error::OK);
+        REQUIRE(payload.body == ((options[i] & SkipBodiesOption) ? "" : "{\n  \"a\": 1\n}\n"));
+        
+        REQUIRE(parser.jsonBody.body.empty());
+        REQUIRE(parser.jsonBody.bodySource.sourceMap.size() == 1);
+        REQUIRE(parser.jsonBody.bodySource.sourceMap[0].location == code);
+        REQUIRE(MapAsset(source, parser.jsonBody.bodySource) == "{\n  \"a\": 1\n}\n");
+        REQUIRE(parser.jsonBody.sourceMap.size() == 1);
+        REQUIRE(parser.jsonBody.sourceMap[0].location == code);
+    }
+    
+    // Content other than its source is copied
+    markdown[6].content = "{}\n";
+    Payload copiedPayload;
+    BlueprintParserCore copiedParser(CheckJSONBodiesOption | SkipBodiesOption, source, blueprint);
+    PayloadParser::Parse(markdown.begin(), markdown.end(), copiedParser, copiedPayload);
+    REQUIRE(copiedPayload.body.empty());
+    REQUIRE(copiedParser.jsonBody.body == "{}\n");
+    REQUIRE(copiedParser.jsonBody.bodySource.sourceMap.empty());
+}
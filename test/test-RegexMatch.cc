@@ -33,3 +33,31 @@ TEST_CASE("regexmatch/request-payload", "Match request payload test")
 {
     REQUIRE(RegexMatch("Request My Id (application/json)", "^[Rr]equest([[:space:]]+([A-Za-z0-9_]|[[:space:]])*)?([[:space:]]\\([^\\)]*\\))?$") == true);
 }
+
+TEST_CASE("regexmatch/evaluation-scope", "Count regex evaluations in scope only")
+{
+    size_t outer = 0;
+    size_t inner = 0;
+    
+    RegexMatch("fox", "fox");
+    {
+        RegexEvaluationScope scope(&outer);
+        RegexMatch("fox", "fox");
+        
+        {
+            RegexEvaluationScope nested(&inner);
+            CaptureGroups groups;
+            RegexCapture("fox", "(f)ox", groups);
+        }
+        
+        // No counter keeps counting into the enclosing one
+        {
+            RegexEvaluationScope none(NULL);
+            RegexMatch("fox", "fox");
+        }
+    }
+    RegexMatch("fox", "fox");
+    
+    REQUIRE(outer == 2);
+    REQUIRE(inner == 1);
+}
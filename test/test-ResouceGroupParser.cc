@@ -14,35 +14,6 @@
 using namespace snowcrash;
 using namespace snowcrashtest;
 
-snowcrash::MarkdownBlock::Stack snowcrashtest::CanonicalResourceGroupFixture()
-{
-    // Blueprint in question:
-    //R"(
-    //# Group First
-    //
-    //Fiber optics
-    //
-    //<see CanonicalResourceFixture()>
-    //
-    //
-    //# Group Second
-    //
-    //Assembly language
-    //)";
-    
-    MarkdownBlock::Stack markdown;
-    markdown.push_back(MarkdownBlock(HeaderBlockType, "Group First", 1, MakeSourceDataBlock(0, 1)));
-    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Fiber optics", 0, MakeSourceDataBlock(1, 1)));
-
-    MarkdownBlock::Stack methodBlocks = CanonicalResourceFixture();
-    markdown.insert(markdown.end(), methodBlocks.begin(), methodBlocks.end());
-    
-    markdown.push_back(MarkdownBlock(HeaderBlockType, "Group Second", 1, MakeSourceDataBlock(0, 1)));
-    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Assembly language", 0, MakeSourceDataBlock(2, 1)));
-    
-    return markdown;
-}
-
 TEST_CASE("rgparser/classifier", "Resource Group block classifier")
 {
     MarkdownBlock::Stack markdown = CanonicalResourceGroupFixture();
@@ -72,7 +43,8 @@ TEST_CASE("rgparser/parse", "Parse canonical resource group")
     MarkdownBlock::Stack markdown = CanonicalResourceGroupFixture();
     
     ResourceGroup resourceGroup;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = ResourceGroupParser::Parse(markdown.begin(), markdown.end(), parser, resourceGroup);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -96,7 +68,8 @@ TEST_CASE("rgparser/parse-empty-resource", "Parse resource group with empty reso
     markdown.push_back(MarkdownBlock(HeaderBlockType, "/resource", 1, MakeSourceDataBlock(2, 1)));
     
     ResourceGroup resourceGroup;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = ResourceGroupParser::Parse(markdown.begin(), markdown.end(), parser, resourceGroup);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -121,7 +94,8 @@ TEST_CASE("rgparser/parse-multiple-resource-description", "Parse multiple resour
     markdown.push_back(MarkdownBlock(ParagraphBlockType, "p2", 0, MakeSourceDataBlock(3, 1)));
     
     ResourceGroup resourceGroup;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = ResourceGroupParser::Parse(markdown.begin(), markdown.end(), parser, resourceGroup);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -169,7 +143,8 @@ TEST_CASE("rgparser/parse-multiple-resource", "Parse multiple resources with pay
     markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(7, 1)));
     
     ResourceGroup resourceGroup;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = ResourceGroupParser::Parse(markdown.begin(), markdown.end(), parser, resourceGroup);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -213,7 +188,8 @@ TEST_CASE("rgparser/parse-multiple-same", "Parse multiple resources with the sam
     markdown.push_back(MarkdownBlock(HeaderBlockType, "/r1", 1, MakeSourceDataBlock(1, 1)));
     
     ResourceGroup resourceGroup;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = ResourceGroupParser::Parse(markdown.begin(), markdown.end(), parser, resourceGroup);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -245,7 +221,8 @@ TEST_CASE("rgparser/parse-resource-description-list", "Parse resource with list
     markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(4, 1)));
     
     ResourceGroup resourceGroup;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = ResourceGroupParser::Parse(markdown.begin(), markdown.end(), parser, resourceGroup);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -279,7 +256,8 @@ TEST_CASE("rgparser/parse-hr", "Parse resource groups with hr in description")
     markdown.push_back(MarkdownBlock(ParagraphBlockType, "A", 0, MakeSourceDataBlock(2, 1)));
     
     ResourceGroup resourceGroup;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());   
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);   
     ParseSectionResult result = ResourceGroupParser::Parse(markdown.begin(), markdown.end(), parser, resourceGroup);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -15,49 +15,6 @@
 using namespace snowcrash;
 using namespace snowcrashtest;
 
-MarkdownBlock::Stack snowcrashtest::CanonicalResourceFixture()
-{
-    // Blueprint in question:
-    //R"(
-    //# My Resource [/resource]
-    //Resource Description
-    //
-    //+ My Resource Object (text/plain)
-    //
-    //        X.O.
-    //
-    //+ Headers
-    //
-    //        X-Resource-Header: Swordfighter XXII
-    //
-    // <see CanonicalMethodFixture()>
-    //
-    //)";
-    
-    MarkdownBlock::Stack markdown;
-    markdown.push_back(MarkdownBlock(HeaderBlockType, "My Resource [/resource]", 1, MakeSourceDataBlock(0, 1)));
-    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Resource Description", 0, MakeSourceDataBlock(1, 1)));    
-
-    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
-
-    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
-    markdown.push_back(MarkdownBlock(ParagraphBlockType, "My Resource Object (text/plain)", 0, MakeSourceDataBlock(2, 1)));
-    markdown.push_back(MarkdownBlock(CodeBlockType, "X.O.", 0, MakeSourceDataBlock(3, 1)));
-    markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, MakeSourceDataBlock(4, 1)));
-    
-    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
-    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Headers", 0, MakeSourceDataBlock(5, 1)));
-    markdown.push_back(MarkdownBlock(CodeBlockType, "X-Resource-Header: Swordfighter XXII", 0, MakeSourceDataBlock(6, 1)));
-    markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, MakeSourceDataBlock(7, 1)));
-    
-    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(8, 1)));
-    
-    MarkdownBlock::Stack methodBlocks = CanonicalMethodFixture();
-    markdown.insert(markdown.end(), methodBlocks.begin(), methodBlocks.end());
-    
-    return markdown;
-}
-
 TEST_CASE("rparser/classifier", "Resource block classifier")
 {
     MarkdownBlock::Stack markdown = CanonicalResourceFixture();
@@ -121,7 +78,8 @@ TEST_CASE("rparser/parse", "Parse resource")
 {
     MarkdownBlock::Stack markdown = CanonicalResourceFixture();
     Resource resource;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = ResourceParser::Parse(markdown.begin(), markdown.end(), parser, resource);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -132,6 +90,8 @@ TEST_CASE("rparser/parse", "Parse resource")
     
     REQUIRE(resource.name == "My Resource");
     REQUIRE(resource.uriTemplate == "/resource");
+    REQUIRE(resource.compiledURITemplate.parts.size() == 1);
+    REQUIRE(resource.compiledURITemplate.prefix == "/resource");
     REQUIRE(resource.object.name == "My Resource");
     REQUIRE(resource.object.body == "X.O.");
     REQUIRE(resource.object.headers.size() == 1);
@@ -161,7 +121,8 @@ TEST_CASE("rparser/parse-partial", "Parse partially defined resource")
     markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(5, 1)));
     
     Resource resource;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = ResourceParser::Parse(markdown.begin(), markdown.end(), parser, resource);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -194,7 +155,8 @@ TEST_CASE("rparser/parse-multi-method-desc", "Parse multiple method descriptions
     markdown.push_back(MarkdownBlock(ParagraphBlockType, "p2", 0, MakeSourceDataBlock(3, 1)));
     
     Resource resource;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = ResourceParser::Parse(markdown.begin(), markdown.end(), parser, resource);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -277,7 +239,8 @@ TEST_CASE("rparser/parse-multi-method", "Parse multiple method")
     markdown.push_back(MarkdownBlock(ParagraphBlockType, "E", 0, MakeSourceDataBlock(20, 1)));
     
     Resource resource;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = ResourceParser::Parse(markdown.begin(), markdown.end(), parser, resource);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -344,7 +307,8 @@ TEST_CASE("rparser/parse-list-description", "Parse description with list")
     markdown.push_back(MarkdownBlock(ParagraphBlockType, "p1", 0, MakeSourceDataBlock(4, 1)));
     
     Resource resource;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = ResourceParser::Parse(markdown.begin(), markdown.end(), parser, resource);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -375,7 +339,8 @@ TEST_CASE("rparser/parse-hr", "Parse resource with a HR")
     markdown.push_back(MarkdownBlock(ParagraphBlockType, "A", 0, MakeSourceDataBlock(2, 1)));
     
     Resource resource;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = ResourceParser::Parse(markdown.begin(), markdown.end(), parser, resource);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -397,7 +362,8 @@ TEST_CASE("rparser/header-warnings", "Check warnings on overshadowing a header")
     Resource resource;
     resource.headers.push_back(std::make_pair("X-Header", "24"));
     
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = ResourceParser::Parse(markdown.begin(),
                                                       markdown.end(),
                                                       parser,
@@ -443,7 +409,8 @@ TEST_CASE("rparser/parse-abbrev", "Parse resource method abbreviation")
     markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(8, 1)));
     
     Resource resource;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());    
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);    
     ParseSectionResult result = ResourceParser::Parse(markdown.begin(), markdown.end(), parser, resource);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -474,7 +441,8 @@ TEST_CASE("rparser/parse-abbrev-ambiguous", "Parse resource method abbreviation
     markdown.push_back(MarkdownBlock(HeaderBlockType, "POST", 1, MakeSourceDataBlock(1, 1)));
     
     Resource resource;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = ResourceParser::Parse(markdown.begin(), markdown.end(), parser, resource);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -501,7 +469,8 @@ TEST_CASE("rparser/parse-nameless-resource", "Parse resource without name")
     markdown.push_back(MarkdownBlock(HeaderBlockType, "/resource", 1, MakeSourceDataBlock(0, 1)));
     
     Resource resource;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = ResourceParser::Parse(markdown.begin(), markdown.end(), parser, resource);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -517,3 +486,43 @@ TEST_CASE("rparser/parse-nameless-resource", "Parse resource without name")
     REQUIRE(resource.methods.size() == 0);
 }
 
+
+TEST_CASE("rparser/malformed-uri-template", "Warn about a malformed URI template")
+{
+    // Blueprint in question:
+    //R"(
+    //# /notes/{id
+    //# GET /notes/{=id}
+    //");
+    
+    MarkdownBlock::Stack markdown;
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "/notes/{id", 1, MakeSourceDataBlock(0, 1)));
+    
+    for (int validate = 0; validate < 2; ++validate) {
+        Resource resource;
+        Blueprint blueprint;
+        BlueprintParserCore parser(validate ? ValidateOnlyOption : 0, SourceDataFixture, blueprint);
+        ParseSectionResult result = ResourceParser::Parse(markdown.begin(), markdown.end(), parser, resource);
+        
+        REQUIRE(result.first.error.code == Error::OK);
+        REQUIRE(result.first.warnings.size() == 1);
+        REQUIRE(result.first.warnings[0].kind == MalformedURITemplateWarning);
+        REQUIRE(result.first.warnings[0].location.size() == 1);
+        REQUIRE(result.first.warnings[0].location[0].location == 0);
+        REQUIRE(resource.uriTemplate == "/notes/{id");
+    }
+    
+    markdown.clear();
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "GET /notes/{=id}", 1, MakeSourceDataBlock(1, 1)));
+    
+    Resource resource;
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
+    ParseSectionResult result = ResourceParser::Parse(markdown.begin(), markdown.end(), parser, resource);
+    
+    REQUIRE(result.first.error.code == Error::OK);
+    REQUIRE(result.first.warnings.size() == 2); // malformed URI template & no response
+    REQUIRE(result.first.warnings[0].kind == MalformedURITemplateWarning);
+    REQUIRE(result.first.warnings[0].location[0].location == 1);
+    REQUIRE(resource.methods.size() == 1);
+}
@@ -0,0 +1,178 @@
+//
+//  test-Router.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include "catch.hpp"
+#include "Router.h"
+
+using namespace snowcrash;
+
+static void AddResource(ResourceGroup& group, const std::string& uriTemplate, const std::string& methods)
+{
+    Resource resource;
+    resource.uriTemplate = uriTemplate;
+
+    std::string::size_type start = 0;
+    while (start < methods.length()) {
+        std::string::size_type end = methods.find(' ', start);
+        if (end == std::string::npos)
+            end = methods.length();
+
+        Method method;
+        method.method = methods.substr(start, end - start);
+        resource.methods.push_back(method);
+        start = end + 1;
+    }
+
+    group.resources.push_back(resource);
+}
+
+static Blueprint RouterBlueprintFixture()
+{
+    Blueprint blueprint;
+    ResourceGroup group;
+    AddResource(group, "/", "GET");
+    AddResource(group, "/notes", "GET POST");
+    AddResource(group, "/notes/{id}", "GET PATCH DELETE");
+    AddResource(group, "/notes/archive", "GET");
+    AddResource(group, "/notes/{id}/tags/{tag}", "PUT");
+    AddResource(group, "/files/{+path}", "GET");
+    AddResource(group, "/reports/{id}.{format}", "GET");
+    AddResource(group, "/search{?q,limit}", "GET");
+    AddResource(group, "/users{/id}", "GET");
+    blueprint.resourceGroups.push_back(group);
+    return blueprint;
+}
+
+TEST_CASE("router/literal", "Match literal URI templates")
+{
+    Blueprint blueprint = RouterBlueprintFixture();
+    Router router(blueprint);
+    RouteMatch match;
+
+    REQUIRE(router.match("GET", "/", match));
+    REQUIRE(match.resource->uriTemplate == "/");
+    REQUIRE(match.method->method == "GET");
+
+    REQUIRE(router.match("POST", "/notes", match));
+    REQUIRE(match.resource->uriTemplate == "/notes");
+    REQUIRE(match.method->method == "POST");
+    REQUIRE(match.variables.empty());
+
+    // Literal segment takes precedence over a variable
+    REQUIRE(router.match("GET", "/notes/archive", match));
+    REQUIRE(match.resource->uriTemplate == "/notes/archive");
+
+    REQUIRE_FALSE(router.match("GET", "/unknown", match));
+    REQUIRE(match.resource == NULL);
+    REQUIRE_FALSE(router.match("GET", "notes", match));
+    REQUIRE_FALSE(router.match("GET", "", match));
+}
+
+TEST_CASE("router/variables", "Capture URI template variables")
+{
+    Blueprint blueprint = RouterBlueprintFixture();
+    Router router(blueprint);
+    RouteMatch match;
+
+    std::string path = "/notes/42/tags/red";
+    REQUIRE(router.match("PUT", path, match));
+    REQUIRE(match.resource->uriTemplate == "/notes/{id}/tags/{tag}");
+
+    Collection<KeyValuePair>::type variables;
+    match.getVariables(path, variables);
+    REQUIRE(variables.size() == 2);
+    REQUIRE(variables[0].first == "id");
+    REQUIRE(variables[0].second == "42");
+    REQUIRE(variables[1].first == "tag");
+    REQUIRE(variables[1].second == "red");
+
+    path = "/reports/2013.json";
+    REQUIRE(router.match("GET", path, match));
+    match.getVariables(path, variables);
+    REQUIRE(variables.size() == 2);
+    REQUIRE(variables[0].second == "2013");
+    REQUIRE(variables[1].second == "json");
+
+    path = "/files/a/b/c.txt";
+    REQUIRE(router.match("GET", path, match));
+    REQUIRE(match.resource->uriTemplate == "/files/{+path}");
+    match.getVariables(path, variables);
+    REQUIRE(variables.size() == 1);
+    REQUIRE(variables[0].second == "a/b/c.txt");
+
+    path = "/users/john";
+    REQUIRE(router.match("GET", path, match));
+    match.getVariables(path, variables);
+    REQUIRE(variables.size() == 1);
+    REQUIRE(variables[0].first == "id");
+    REQUIRE(variables[0].second == "john");
+
+    // Variables are never empty
+    REQUIRE_FALSE(router.match("GET", "/reports/.json", match));
+    REQUIRE_FALSE(router.match("GET", "/files/", match));
+}
+
+TEST_CASE("router/query", "Capture query variables")
+{
+    Blueprint blueprint = RouterBlueprintFixture();
+    Router router(blueprint);
+    RouteMatch match;
+
+    std::string path = "/search?limit=10&q=snow#top";
+    REQUIRE(router.match("GET", path, match));
+    REQUIRE(match.resource->uriTemplate == "/search{?q,limit}");
+
+    Collection<KeyValuePair>::type variables;
+    match.getVariables(path, variables);
+    REQUIRE(variables.size() == 2);
+    REQUIRE(variables[0].first == "q");
+    REQUIRE(variables[0].second == "snow");
+    REQUIRE(variables[1].first == "limit");
+    REQUIRE(variables[1].second == "10");
+
+    // Query does not affect routing
+    REQUIRE(router.match("GET", "/notes?page=2", match));
+    REQUIRE(match.resource->uriTemplate == "/notes");
+}
+
+TEST_CASE("router/method", "Resolve methods of matching resources")
+{
+    Blueprint blueprint = RouterBlueprintFixture();
+    Router router(blueprint);
+    RouteMatch match;
+
+    // Resource matches but has no such method
+    REQUIRE(router.match("DELETE", "/notes", match));
+    REQUIRE(match.resource->uriTemplate == "/notes");
+    REQUIRE(match.method == NULL);
+
+    // Prefer a resource having the method
+    REQUIRE(router.match("GET", "/notes/archive", match));
+    REQUIRE(match.resource->uriTemplate == "/notes/archive");
+    REQUIRE(router.match("PATCH", "/notes/archive", match));
+    REQUIRE(match.resource->uriTemplate == "/notes/{id}");
+    REQUIRE(match.method->method == "PATCH");
+}
+
+TEST_CASE("router/add", "Add resources one by one")
+{
+    Blueprint blueprint = RouterBlueprintFixture();
+    Router router;
+    RouteMatch match;
+
+    const Collection<Resource>::type& resources = blueprint.resourceGroups[0].resources;
+    for (Collection<Resource>::const_iterator it = resources.begin(); it != resources.end(); ++it)
+        router.add(*it);
+
+    REQUIRE(router.match("GET", "/notes/archive", match));
+    REQUIRE(match.resource->uriTemplate == "/notes/archive");
+    REQUIRE(router.match("GET", "/notes/1", match));
+    REQUIRE(match.resource->uriTemplate == "/notes/{id}");
+
+    router.clear();
+    REQUIRE_FALSE(router.match("GET", "/notes", match));
+}
@@ -0,0 +1,229 @@
+//
+//  test-Scaling.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <cmath>
+#include <sstream>
+#include "catch.hpp"
+#include "BlueprintParser.h"
+#include "ParserStatistics.h"
+#include "Timer.h"
+
+using namespace snowcrash;
+
+//
+// Complexity scaling of the blueprint parser
+//
+// Each family of inputs grows along one structural dimension. Inputs of
+// size N, 2N, 4N & 8N are parsed and the growth of the parse time and of
+// the duplicate check lookups is compared against n log n.
+//
+// Parse time of these sizes is dominated by the per-block work, a linear
+// scan of the AST parsed so far would not show in it before hundreds of
+// thousands of entries. Lookups count the entries such scans compare,
+// independent of the machine, and catch them at any size.
+//
+
+// Generated markdown input of given size
+typedef void (*InputFamily)(size_t size, MarkdownBlock::Stack& markdown);
+
+// Slope of log(time / n log n) over log n allowed, 0 for exact n log n
+static const double MaxExcessSlope = 0.35;
+
+// Repetitions of a parse, the fastest one is taken
+static const size_t Repetitions = 3;
+
+// Source data of generated blocks, every block maps to one character
+static const SourceData& ScalingSource()
+{
+    static const SourceData source(1 << 20, 'x');
+    return source;
+}
+
+static void PushBlock(MarkdownBlock::Stack& markdown, MarkdownBlockType type, const std::string& content = std::string(), int data = 0)
+{
+    markdown.push_back(MarkdownBlock(type, content, data, MakeSourceDataBlock(markdown.size(), 1)));
+}
+
+// + <signature>
+//
+//         <code>
+static void PushListItem(MarkdownBlock::Stack& markdown, const std::string& signature, const std::string& code)
+{
+    PushBlock(markdown, ListItemBlockBeginType);
+    PushBlock(markdown, ParagraphBlockType, signature);
+    PushBlock(markdown, CodeBlockType, code);
+    PushBlock(markdown, ListItemBlockEndType);
+}
+
+// # <name> [<uri>]
+// ## GET
+// + Response 200
+static void PushResource(MarkdownBlock::Stack& markdown, const std::string& name, const std::string& uri)
+{
+    PushBlock(markdown, HeaderBlockType, name + " [" + uri + "]", 1);
+    PushBlock(markdown, HeaderBlockType, "GET", 2);
+    PushBlock(markdown, ListBlockBeginType);
+    PushListItem(markdown, "Response 200 (text/plain)", "OK.");
+    PushBlock(markdown, ListBlockEndType);
+}
+
+// Resources in one group
+static void ResourcesFamily(size_t size, MarkdownBlock::Stack& markdown)
+{
+    PushBlock(markdown, HeaderBlockType, "API", 1);
+    PushBlock(markdown, HeaderBlockType, "Group Resources", 1);
+    for (size_t i = 0; i < size; ++i) {
+        std::stringstream uri;
+        uri << "/resource/" << i;
+        PushResource(markdown, "Resource", uri.str());
+    }
+}
+
+// Groups of one resource each
+static void GroupsFamily(size_t size, MarkdownBlock::Stack& markdown)
+{
+    PushBlock(markdown, HeaderBlockType, "API", 1);
+    for (size_t i = 0; i < size; ++i) {
+        std::stringstream name, uri;
+        name << "Group Group " << i;
+        uri << "/group/" << i;
+        PushBlock(markdown, HeaderBlockType, name.str(), 1);
+        PushResource(markdown, "Resource", uri.str());
+    }
+}
+
+// Responses of one method
+static void ResponsesFamily(size_t size, MarkdownBlock::Stack& markdown)
+{
+    PushBlock(markdown, HeaderBlockType, "API", 1);
+    PushBlock(markdown, HeaderBlockType, "Resource [/resource]", 1);
+    PushBlock(markdown, HeaderBlockType, "GET", 2);
+    PushBlock(markdown, ListBlockBeginType);
+    for (size_t i = 0; i < size; ++i) {
+        std::stringstream signature;
+        signature << "Response " << (100 + i) << " (text/plain)";
+        PushListItem(markdown, signature.str(), "OK.");
+    }
+    PushBlock(markdown, ListBlockEndType);
+}
+
+// List items nested under one payload
+static void PayloadListFamily(size_t size, MarkdownBlock::Stack& markdown)
+{
+    PushBlock(markdown, HeaderBlockType, "API", 1);
+    PushBlock(markdown, HeaderBlockType, "Resource [/resource]", 1);
+    PushBlock(markdown, HeaderBlockType, "GET", 2);
+    PushBlock(markdown, ListBlockBeginType);
+    PushBlock(markdown, ListItemBlockBeginType);
+    PushBlock(markdown, ParagraphBlockType, "Response 200 (text/plain)");
+    PushBlock(markdown, ListBlockBeginType);
+    PushListItem(markdown, "Body", "OK.");
+    for (size_t i = 0; i < size; ++i)
+        PushListItem(markdown, "Item", "Lorem ipsum");
+    PushBlock(markdown, ListBlockEndType);
+    PushBlock(markdown, ListItemBlockEndType);
+    PushBlock(markdown, ListBlockEndType);
+}
+
+// Paragraphs of one resource description
+static void DescriptionFamily(size_t size, MarkdownBlock::Stack& markdown)
+{
+    PushBlock(markdown, HeaderBlockType, "API", 1);
+    PushBlock(markdown, HeaderBlockType, "Resource [/resource]", 1);
+    for (size_t i = 0; i < size; ++i)
+        PushBlock(markdown, ParagraphBlockType, "Lorem ipsum dolor sit amet");
+    PushBlock(markdown, HeaderBlockType, "GET", 2);
+    PushBlock(markdown, ListBlockBeginType);
+    PushListItem(markdown, "Response 200 (text/plain)", "OK.");
+    PushBlock(markdown, ListBlockEndType);
+}
+
+// Fastest parse time & the lookups of the family input of given size
+static double ParseTime(InputFamily family, size_t size, size_t& lookups)
+{
+    MarkdownBlock::Stack markdown;
+    family(size, markdown);
+    REQUIRE(markdown.size() < ScalingSource().length());
+
+    double fastest = 0;
+    for (size_t i = 0; i < Repetitions; ++i) {
+        Result result;
+        Blueprint blueprint;
+        ParserStatistics statistics;
+        double start = Now();
+        BlueprintParser::Parse(ScalingSource(), markdown, 0, result, blueprint, NULL, &statistics);
+        double elapsed = Now() - start;
+
+        REQUIRE(result.error.code == Error::OK);
+        if (i == 0 || elapsed < fastest)
+            fastest = elapsed;
+
+        lookups = statistics.lookups;
+    }
+
+    return fastest;
+}
+
+// n log n
+static double NLogN(size_t n)
+{
+    return static_cast<double>(n) * std::log(static_cast<double>(n));
+}
+
+// Check parse time & lookups of sizes N, 2N, 4N & 8N grow no faster than n log n
+static void RequireScaling(InputFamily family, size_t size)
+{
+    // Least squares slope of log(t / n log n) over log n
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    const size_t points = 4;
+    size_t lookups[points];
+    for (size_t i = 0; i < points; ++i) {
+        double n = static_cast<double>(size << i);
+        double t = ParseTime(family, size << i, lookups[i]);
+
+        double x = std::log(n);
+        double y = std::log(t / (n * std::log(n)));
+        sx += x;
+        sy += y;
+        sxx += x * x;
+        sxy += x * y;
+    }
+
+    double slope = (points * sxy - sx * sy) / (points * sxx - sx * sx);
+    INFO("excess growth slope " << slope);
+    REQUIRE(slope < MaxExcessSlope);
+
+    // Lookups are exact, 8N may take at most 8N log 8N / N log N times
+    // the lookups of N. Quadratic growth takes 64 times as many.
+    INFO("lookups " << lookups[0] << " at " << size << ", " << lookups[points - 1] << " at " << (size << (points - 1)));
+    REQUIRE(static_cast<double>(lookups[points - 1]) * NLogN(size) <= static_cast<double>(lookups[0]) * NLogN(size << (points - 1)));
+}
+
+TEST_CASE("scaling/resources", "Parse time scaling with resources in a group")
+{
+    RequireScaling(ResourcesFamily, 25);
+}
+
+TEST_CASE("scaling/groups", "Parse time scaling with resource groups")
+{
+    RequireScaling(GroupsFamily, 25);
+}
+
+TEST_CASE("scaling/responses", "Parse time scaling with responses of a method")
+{
+    RequireScaling(ResponsesFamily, 50);
+}
+
+TEST_CASE("scaling/payload-list", "Parse time scaling with list items of a payload")
+{
+    RequireScaling(PayloadListFamily, 100);
+}
+
+TEST_CASE("scaling/description", "Parse time scaling with description paragraphs")
+{
+    RequireScaling(DescriptionFamily, 200);
+}
@@ -0,0 +1,296 @@
+//
+//  test-SerializeJSON.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <sstream>
+#include <stdexcept>
+#include "catch.hpp"
+#include "SerializeJSON.h"
+#include "Serialize.h"
+#include "AssetSource.h"
+#include "Fixture.h"
+
+using namespace snowcrash;
+using namespace snowcrashtest;
+
+// Serializer failing on a group named "fail"
+static void FailingGroupSerializer(const ResourceGroup& group, std::ostream& os, unsigned int options)
+{
+    if (group.name == "fail")
+        throw std::runtime_error("failed group");
+
+    os << group.name;
+}
+
+TEST_CASE("json/serialize", "Serialize blueprint into JSON")
+{
+    std::stringstream ss;
+    SerializeJSON(SerializeBlueprintFixture(), ss);
+    REQUIRE(ss.str() ==
+    "{\n"
+    "  \"metadata\": [\n"
+    "    {\n"
+    "      \"FORMAT\": \"1A\"\n"
+    "    },\n"
+    "    {\n"
+    "      \"HOST\": \"http://acme.com\"\n"
+    "    }\n"
+    "  ],\n"
+    "  \"name\": \"Snowcrash API\",\n"
+    "  \"description\": \"Uncle Enzo\\n\\nwith *Hiro*\\n\",\n"
+    "  \"resourceGroups\": [\n"
+    "    {\n"
+    "      \"name\": \"First\",\n"
+    "      \"description\": \"Fiber optics\",\n"
+    "      \"resources\": [\n"
+    "        {\n"
+    "          \"uriTemplate\": \"/resource/{id}\",\n"
+    "          \"name\": \"My Resource\",\n"
+    "          \"description\": \"Resource\\ndescription\",\n"
+    "          \"object\": {\n"
+    "              \"name\": \"My Resource\",\n"
+    "              \"description\": \"Object\",\n"
+    "              \"body\": \"{ \\\"id\\\": 1 }\\n\",\n"
+    "              \"schema\": \"\",\n"
+    "              \"headers\": [\n"
+    "                {\n"
+    "                  \"Content-Type\": \"application/json\"\n"
+    "                }\n"
+    "              ]\n"
+    "            },\n"
+    "          \"headers\": [\n"
+    "            {\n"
+    "              \"X-Header\": \"42\"\n"
+    "            },\n"
+    "            {\n"
+    "              \"X-Other\": \"Hello\"\n"
+    "            }\n"
+    "          ],\n"
+    "          \"methods\": [\n"
+    "            {\n"
+    "              \"method\": \"GET\",\n"
+    "              \"name\": \"Retrieve\",\n"
+    "              \"description\": \"Method description\\n\",\n"
+    "              \"headers\": [\n"
+    "                {\n"
+    "                  \"Accept\": \"application/json\"\n"
+    "                }\n"
+    "              ],\n"
+    "              \"requests\": [\n"
+    "                {\n"
+    "                  \"name\": \"A\",\n"
+    "                  \"description\": \"Request A\",\n"
+    "                  \"body\": \"Text\\n\\n{ ... }\\n\",\n"
+    "                  \"schema\": \"Schema\\n\",\n"
+    "                  \"headers\": [\n"
+    "                    {\n"
+    "                      \"Content-Type\": \"text/plain\"\n"
+    "                    }\n"
+    "                  ]\n"
+    "                },\n"
+    "                {\n"
+    "                  \"name\": \"B\",\n"
+    "                  \"description\": \"Request A\",\n"
+    "                  \"body\": \"Text\\n\\n{ ... }\\n\",\n"
+    "                  \"schema\": \"Schema\\n\"\n"
+    "                }\n"
+    "              ],\n"
+    "              \"responses\": [\n"
+    "                {\n"
+    "                  \"name\": \"200\",\n"
+    "                  \"description\": \"\",\n"
+    "                  \"body\": \"{ \\\"id\\\": 1 }\\n\",\n"
+    "                  \"schema\": \"\",\n"
+    "                  \"headers\": [\n"
+    "                    {\n"
+    "                      \"Content-Type\": \"application/json\"\n"
+    "                    }\n"
+    "                  ]\n"
+    "                },\n"
+    "                {\n"
+    "                  \"name\": \"404\",\n"
+    "                  \"description\": \"\",\n"
+    "                  \"body\": \"\",\n"
+    "                  \"schema\": \"\"\n"
+    "                }\n"
+    "              ]\n"
+    "            },\n"
+    "            {\n"
+    "              \"method\": \"DELETE\",\n"
+    "              \"name\": \"\",\n"
+    "              \"description\": \"\"\n"
+    "            }\n"
+    "          ]\n"
+    "        },\n"
+    "        {\n"
+    "          \"uriTemplate\": \"/plain\",\n"
+    "          \"name\": \"\",\n"
+    "          \"description\": \"\",\n"
+    "          \"object\": {}\n"
+    "        }\n"
+    "      ]\n"
+    "    },\n"
+    "    {\n"
+    "      \"name\": \"\",\n"
+    "      \"description\": \"\"\n"
+    "    }\n"
+    "  ]\n"
+    "}\n");
+}
+
+TEST_CASE("json/serialize-empty", "Serialize empty blueprint into JSON")
+{
+    std::stringstream ss;
+    SerializeJSON(Blueprint(), ss);
+    REQUIRE(ss.str() ==
+    "{\n"
+    "  \"name\": \"\",\n"
+    "  \"description\": \"\"\n"
+    "}\n");
+}
+
+TEST_CASE("json/serialize-compact", "Serialize blueprint into compact JSON")
+{
+    std::stringstream ss;
+    SerializeJSON(Blueprint(), ss, CompactJSONOption);
+    REQUIRE(ss.str() == "{\"name\":\"\",\"description\":\"\"}");
+
+    std::stringstream compact;
+    SerializeJSON(SerializeBlueprintFixture(), compact, CompactJSONOption);
+    REQUIRE(compact.str() ==
+    "{\"metadata\":[{\"FORMAT\":\"1A\"},{\"HOST\":\"http://acme.com\"}],\"name\":\"Snowcrash API\","
+    "\"description\":\"Uncle Enzo\\n\\nwith *Hiro*\\n\",\"resourceGroups\":["
+    "{\"name\":\"First\",\"description\":\"Fiber optics\",\"resources\":[{\"uriTemplate\":\"/resource/{id}\","
+    "\"name\":\"My Resource\",\"description\":\"Resource\\ndescription\","
+    "\"object\":{\"name\":\"My Resource\",\"description\":\"Object\",\"body\":\"{ \\\"id\\\": 1 }\\n\","
+    "\"schema\":\"\",\"headers\":[{\"Content-Type\":\"application/json\"}]},"
+    "\"headers\":[{\"X-Header\":\"42\"},{\"X-Other\":\"Hello\"}],\"methods\":["
+    "{\"method\":\"GET\",\"name\":\"Retrieve\",\"description\":\"Method description\\n\","
+    "\"headers\":[{\"Accept\":\"application/json\"}],\"requests\":[{\"name\":\"A\","
+    "\"description\":\"Request A\",\"body\":\"Text\\n\\n{ ... }\\n\",\"schema\":\"Schema\\n\","
+    "\"headers\":[{\"Content-Type\":\"text/plain\"}]},{\"name\":\"B\",\"description\":\"Request A\","
+    "\"body\":\"Text\\n\\n{ ... }\\n\",\"schema\":\"Schema\\n\"}],\"responses\":["
+    "{\"name\":\"200\",\"description\":\"\",\"body\":\"{ \\\"id\\\": 1 }\\n\",\"schema\":\"\","
+    "\"headers\":[{\"Content-Type\":\"application/json\"}]},{\"name\":\"404\","
+    "\"description\":\"\",\"body\":\"\",\"schema\":\"\"}]},{\"method\":\"DELETE\","
+    "\"name\":\"\",\"description\":\"\"}]},{\"uriTemplate\":\"/plain\",\"name\":\"\","
+    "\"description\":\"\",\"object\":{}}]},{\"name\":\"\",\"description\":\"\"}]}");
+}
+
+TEST_CASE("json/serialize-escape", "Escape JSON string values")
+{
+    Blueprint blueprint;
+    blueprint.name = "\"Quoted\" \\ back\tslash\r\n";
+    blueprint.description = std::string("\x01", 1) + "\x1f" + "/" + "\xc3\xa9";
+
+    std::stringstream ss;
+    SerializeJSON(blueprint, ss, CompactJSONOption);
+    REQUIRE(ss.str() == "{\"name\":\"\\\"Quoted\\\" \\\\ back\\tslash\\r\\n\",\"description\":\"\\u0001\\u001f/\xc3\xa9\"}");
+}
+
+TEST_CASE("json/serialize-parallel", "Serialize resource groups in parallel")
+{
+    Blueprint blueprint = SerializeBlueprintFixture();
+    Collection<ResourceGroup>::type groups = blueprint.resourceGroups;
+    for (size_t i = 0; i < 32; ++i)
+        blueprint.resourceGroups.insert(blueprint.resourceGroups.end(), groups.begin(), groups.end());
+
+    std::stringstream serial;
+    SerializeJSON(blueprint, serial);
+
+    std::stringstream parallel;
+    SerializeJSON(blueprint, parallel, ParallelJSONOption);
+    REQUIRE(parallel.str() == serial.str());
+
+    std::stringstream compact;
+    SerializeJSON(blueprint, compact, CompactJSONOption);
+
+    std::stringstream parallelCompact;
+    SerializeJSON(blueprint, parallelCompact, CompactJSONOption | ParallelJSONOption);
+    REQUIRE(parallelCompact.str() == compact.str());
+}
+
+TEST_CASE("json/serialize-groups-failure", "Rethrow a failure of serializing resource groups")
+{
+    Collection<ResourceGroup>::type groups;
+    std::vector<std::string> outputs;
+    SerializeResourceGroups(groups, FailingGroupSerializer, 0, outputs);
+    REQUIRE(outputs.empty());
+
+    groups.resize(8);
+    for (size_t i = 0; i < groups.size(); ++i)
+        groups[i].name = "ok";
+    SerializeResourceGroups(groups, FailingGroupSerializer, 0, outputs);
+    REQUIRE(outputs.size() == 8);
+    REQUIRE(outputs[7] == "ok");
+
+    groups[5].name = "fail";
+    REQUIRE_THROWS_AS(SerializeResourceGroups(groups, FailingGroupSerializer, 0, outputs), std::runtime_error);
+
+    groups.resize(1);
+    groups[0].name = "fail";
+    REQUIRE_THROWS_AS(SerializeResourceGroups(groups, FailingGroupSerializer, 0, outputs), std::runtime_error);
+}
+
+TEST_CASE("json/serialize-stream", "Serialize resource groups one by one")
+{
+    Blueprint blueprint = SerializeBlueprintFixture();
+
+    for (int compact = 0; compact < 2; ++compact) {
+        SerializeJSONOptions options = compact ? CompactJSONOption : 0;
+
+        std::stringstream expected;
+        SerializeJSON(blueprint, expected, options);
+
+        std::stringstream ss;
+        JSONStreamSerializer serializer(ss, options);
+        for (Collection<ResourceGroup>::const_iterator it = blueprint.resourceGroups.begin();
+             it != blueprint.resourceGroups.end();
+             ++it)
+            serializer.resourceGroup(blueprint, *it);
+        serializer.end(blueprint);
+
+        REQUIRE(ss.str() == expected.str());
+    }
+
+    Blueprint empty;
+    empty.name = "API";
+
+    std::stringstream expected;
+    SerializeJSON(empty, expected);
+
+    std::stringstream ss;
+    JSONStreamSerializer serializer(ss);
+    serializer.end(empty);
+    REQUIRE(ss.str() == expected.str());
+}
+
+TEST_CASE("json/serialize-asset-source", "Serialize assets kept as their source")
+{
+    Blueprint blueprint = SerializeBlueprintFixture();
+    std::stringstream expected;
+    SerializeJSON(blueprint, expected);
+
+    // Request body & schema in the source, see AssetSourceOption
+    const SourceData source = "Text\n\n{ ... }\nSchema\n";
+    Request& request = blueprint.resourceGroups[0].resources[0].methods[0].requests[0];
+    REQUIRE(request.body + request.schema == source);
+
+    request.bodySource.source = &source;
+    request.bodySource.sourceMap = MakeSourceDataBlock(0, request.body.length());
+    request.schemaSource.source = &source;
+    request.schemaSource.sourceMap = MakeSourceDataBlock(request.body.length(), request.schema.length());
+    request.body.clear();
+    request.schema.clear();
+
+    Asset storage;
+    REQUIRE(PayloadBody(request, storage) == "Text\n\n{ ... }\n");
+    REQUIRE(PayloadSchema(request, storage) == "Schema\n");
+
+    std::stringstream ss;
+    SerializeJSON(blueprint, ss);
+    REQUIRE(ss.str() == expected.str());
+}
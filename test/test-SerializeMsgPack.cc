@@ -0,0 +1,159 @@
+//
+//  test-SerializeMsgPack.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <sstream>
+#include "catch.hpp"
+#include "SerializeMsgPack.h"
+#include "Fixture.h"
+
+using namespace snowcrash;
+using namespace snowcrashtest;
+
+// Read big-endian length of given size
+static size_t ReadLength(const std::string& data, size_t& offset, size_t bytes)
+{
+    size_t length = 0;
+    for (size_t i = 0; i < bytes; ++i)
+        length = (length << 8) | static_cast<unsigned char>(data[offset++]);
+    return length;
+}
+
+// Decode MessagePack produced by the serializer into a JSON-like text,
+// strings are quoted as they are
+static void Decode(const std::string& data, size_t& offset, std::string& text)
+{
+    unsigned char format = static_cast<unsigned char>(data[offset++]);
+
+    size_t length = 0;
+    char type = 0;
+    if ((format & 0xe0) == 0xa0) {
+        type = 's';
+        length = format & 0x1f;
+    }
+    else if ((format & 0xf0) == 0x80) {
+        type = 'm';
+        length = format & 0x0f;
+    }
+    else if ((format & 0xf0) == 0x90) {
+        type = 'a';
+        length = format & 0x0f;
+    }
+    else {
+        switch (format) {
+            case 0xd9: type = 's'; length = ReadLength(data, offset, 1); break;
+            case 0xda: type = 's'; length = ReadLength(data, offset, 2); break;
+            case 0xdb: type = 's'; length = ReadLength(data, offset, 4); break;
+            case 0xdc: type = 'a'; length = ReadLength(data, offset, 2); break;
+            case 0xdd: type = 'a'; length = ReadLength(data, offset, 4); break;
+            case 0xde: type = 'm'; length = ReadLength(data, offset, 2); break;
+            case 0xdf: type = 'm'; length = ReadLength(data, offset, 4); break;
+            default:
+                FAIL("unexpected format byte");
+        }
+    }
+
+    if (type == 's') {
+        text += "\"" + data.substr(offset, length) + "\"";
+        offset += length;
+        return;
+    }
+
+    text += (type == 'm') ? "{" : "[";
+    for (size_t i = 0; i < length; ++i) {
+        if (i > 0)
+            text += ",";
+
+        Decode(data, offset, text);
+
+        if (type == 'm') {
+            text += ":";
+            Decode(data, offset, text);
+        }
+    }
+    text += (type == 'm') ? "}" : "]";
+}
+
+static std::string Decode(const std::string& data)
+{
+    std::string text;
+    size_t offset = 0;
+    Decode(data, offset, text);
+    REQUIRE(offset == data.length());
+    return text;
+}
+
+TEST_CASE("msgpack/serialize-empty", "Serialize empty blueprint into MessagePack")
+{
+    std::stringstream ss;
+    SerializeMsgPack(Blueprint(), ss);
+
+    const char expected[] = "\x82\xa4" "name" "\xa0\xab" "description" "\xa0";
+    REQUIRE(ss.str() == std::string(expected, sizeof(expected) - 1));
+}
+
+TEST_CASE("msgpack/serialize", "Serialize blueprint into MessagePack")
+{
+    std::stringstream ss;
+    SerializeMsgPack(SerializeBlueprintFixture(), ss);
+    REQUIRE(Decode(ss.str()) ==
+    "{\"metadata\":[{\"FORMAT\":\"1A\"},{\"HOST\":\"http://acme.com\"}],\"name\":\"Snowcrash API\","
+    "\"description\":\"Uncle Enzo\n\nwith *Hiro*\n\",\"resourceGroups\":["
+    "{\"name\":\"First\",\"description\":\"Fiber optics\",\"resources\":[{\"uriTemplate\":\"/resource/{id}\","
+    "\"name\":\"My Resource\",\"description\":\"Resource\ndescription\","
+    "\"object\":{\"name\":\"My Resource\",\"description\":\"Object\",\"body\":\"{ \"id\": 1 }\n\","
+    "\"schema\":\"\",\"headers\":[{\"Content-Type\":\"application/json\"}]},"
+    "\"headers\":[{\"X-Header\":\"42\"},{\"X-Other\":\"Hello\"}],\"methods\":["
+    "{\"method\":\"GET\",\"name\":\"Retrieve\",\"description\":\"Method description\n\","
+    "\"headers\":[{\"Accept\":\"application/json\"}],\"requests\":[{\"name\":\"A\","
+    "\"description\":\"Request A\",\"body\":\"Text\n\n{ ... }\n\",\"schema\":\"Schema\n\","
+    "\"headers\":[{\"Content-Type\":\"text/plain\"}]},{\"name\":\"B\",\"description\":\"Request A\","
+    "\"body\":\"Text\n\n{ ... }\n\",\"schema\":\"Schema\n\"}],\"responses\":["
+    "{\"name\":\"200\",\"description\":\"\",\"body\":\"{ \"id\": 1 }\n\",\"schema\":\"\","
+    "\"headers\":[{\"Content-Type\":\"application/json\"}]},{\"name\":\"404\","
+    "\"description\":\"\",\"body\":\"\",\"schema\":\"\"}]},{\"method\":\"DELETE\","
+    "\"name\":\"\",\"description\":\"\"}]},{\"uriTemplate\":\"/plain\",\"name\":\"\","
+    "\"description\":\"\",\"object\":{}}]},{\"name\":\"\",\"description\":\"\"}]}");
+}
+
+TEST_CASE("msgpack/serialize-strings", "Serialize strings with length prefixes")
+{
+    Blueprint blueprint;
+    blueprint.name = std::string(31, 'a');
+    blueprint.description = std::string(32, 'b');
+
+    std::stringstream ss;
+    SerializeMsgPack(blueprint, ss);
+    std::string data = ss.str();
+    REQUIRE(data.length() == 1 + 5 + 1 + 31 + 12 + 2 + 32);
+    REQUIRE(data.substr(6, 1) == "\xbf");
+    REQUIRE(data.substr(50, 2) == "\xd9\x20");
+
+    blueprint.name = std::string(256, 'a');
+    blueprint.description = std::string(70000, 'b');
+    ss.str(std::string());
+    SerializeMsgPack(blueprint, ss);
+    data = ss.str();
+    REQUIRE(data.substr(6, 3) == std::string("\xda\x01\x00", 3));
+    REQUIRE(data.substr(6 + 3 + 256 + 12, 5) == std::string("\xdb\x00\x01\x11\x70", 5));
+    REQUIRE(Decode(data) == "{\"name\":\"" + blueprint.name + "\",\"description\":\"" + blueprint.description + "\"}");
+}
+
+TEST_CASE("msgpack/serialize-collections", "Serialize large collections")
+{
+    Blueprint blueprint;
+    ResourceGroup group;
+    group.resources.resize(16);
+    blueprint.resourceGroups.push_back(group);
+
+    std::stringstream ss;
+    SerializeMsgPack(blueprint, ss);
+    std::string data = ss.str();
+    REQUIRE(data.find(std::string("\xa9" "resources" "\xdc\x00\x10", 13)) != std::string::npos);
+
+    std::string text = Decode(data);
+    REQUIRE(text.find("\"resources\":[{\"uriTemplate\":\"\"") != std::string::npos);
+}
@@ -0,0 +1,161 @@
+//
+//  test-SerializeYAML.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <sstream>
+#include "catch.hpp"
+#include "SerializeYAML.h"
+#include "Fixture.h"
+
+using namespace snowcrash;
+using namespace snowcrashtest;
+
+TEST_CASE("yaml/serialize", "Serialize blueprint into YAML")
+{
+    std::stringstream ss;
+    SerializeYAML(SerializeBlueprintFixture(), ss);
+    REQUIRE(ss.str() ==
+    "metadata:\n"
+    "- FORMAT: 1A\n"
+    "  HOST: http://acme.com\n"
+    "name: Snowcrash API\n"
+    "description: \"Uncle Enzo\\n\\nwith *Hiro*\\n\"\n"
+    "resourceGroups:\n"
+    "- name: First\n"
+    "  description: Fiber optics\n"
+    "  resources:\n"
+    "  - uriTemplate: /resource/{id}\n"
+    "    name: My Resource\n"
+    "    description: \"Resource\\ndescription\\n\"\n"
+    "    object:\n"
+    "      name: My Resource\n"
+    "      description: Object\n"
+    "      body: \"{ \"id\": 1 }\\n\"\n"
+    "      schema:\n"
+    "      headers:\n"
+    "      - Content-Type: application/json\n"
+    "    headers:\n"
+    "    - X-Header: 42\n"
+    "      X-Other: Hello\n"
+    "    methods:\n"
+    "    - method: GET\n"
+    "      name: Retrieve\n"
+    "      description: \"Method description\\n\"\n"
+    "      headers:\n"
+    "      - Accept: application/json\n"
+    "      requests:\n"
+    "      - name: A\n"
+    "        description: Request A\n"
+    "        body: \"Text\\n\\n{ ... }\\n\"\n"
+    "        schema: \"Schema\\n\"\n"
+    "        headers:\n"
+    "        - Content-Type: text/plain\n"
+    "      - name: B\n"
+    "        description: Request A\n"
+    "        body: \"Text\\n\\n{ ... }\\n\"\n"
+    "        schema: \"Schema\\n\"\n"
+    "      responses:\n"
+    "      - name: 200\n"
+    "        description:\n"
+    "        body: \"{ \"id\": 1 }\\n\"\n"
+    "        schema:\n"
+    "        headers:\n"
+    "        - Content-Type: application/json\n"
+    "      - name: 404\n"
+    "        description:\n"
+    "        body:\n"
+    "        schema:\n"
+    "    - method: DELETE\n"
+    "      name:\n"
+    "      description:\n"
+    "  - uriTemplate: /plain\n"
+    "    name:\n"
+    "    description:\n"
+    "    object:\n"
+    "- name:\n"
+    "  description:\n");
+}
+
+TEST_CASE("yaml/serialize-empty", "Serialize empty blueprint into YAML")
+{
+    std::stringstream ss;
+    SerializeYAML(Blueprint(), ss);
+    REQUIRE(ss.str() ==
+    "name:\n"
+    "description:\n");
+}
+
+TEST_CASE("yaml/serialize-escape", "Escape new lines of YAML values")
+{
+    Blueprint blueprint;
+    blueprint.name = "\n";
+    blueprint.description = "a\n\nb";
+
+    // Headers with an empty key are skipped
+    blueprint.metadata.push_back(std::make_pair("", "ignored"));
+    blueprint.metadata.push_back(std::make_pair("KEY", "1\n2\n"));
+
+    std::stringstream ss;
+    SerializeYAML(blueprint, ss);
+    REQUIRE(ss.str() ==
+            "metadata:\n"
+            "- "
+            "  KEY: \"1\\n2\\n\"\n"
+            "name: \"\\n\"\n"
+            "description: \"a\\n\\nb\\n\"\n");
+}
+
+TEST_CASE("yaml/serialize-large", "Serialize values larger than output buffer")
+{
+    Blueprint blueprint;
+    blueprint.description = std::string(100000, 'x') + "\n";
+
+    std::stringstream ss;
+    SerializeYAML(blueprint, ss);
+    REQUIRE(ss.str() == "name:\ndescription: \"" + std::string(100000, 'x') + "\\n\"\n");
+}
+
+TEST_CASE("yaml/serialize-parallel", "Serialize resource groups in parallel")
+{
+    Blueprint blueprint = SerializeBlueprintFixture();
+    Collection<ResourceGroup>::type groups = blueprint.resourceGroups;
+    for (size_t i = 0; i < 32; ++i)
+        blueprint.resourceGroups.insert(blueprint.resourceGroups.end(), groups.begin(), groups.end());
+
+    std::stringstream serial;
+    SerializeYAML(blueprint, serial);
+
+    std::stringstream parallel;
+    SerializeYAML(blueprint, parallel, ParallelYAMLOption);
+    REQUIRE(parallel.str() == serial.str());
+}
+
+TEST_CASE("yaml/serialize-stream", "Serialize resource groups one by one")
+{
+    Blueprint blueprint = SerializeBlueprintFixture();
+
+    std::stringstream expected;
+    SerializeYAML(blueprint, expected);
+
+    std::stringstream ss;
+    YAMLStreamSerializer serializer(ss);
+    for (Collection<ResourceGroup>::const_iterator it = blueprint.resourceGroups.begin();
+         it != blueprint.resourceGroups.end();
+         ++it)
+        serializer.resourceGroup(blueprint, *it);
+    serializer.end(blueprint);
+
+    REQUIRE(ss.str() == expected.str());
+
+    Blueprint empty;
+    std::stringstream emptyExpected;
+    SerializeYAML(empty, emptyExpected);
+
+    std::stringstream emptyStream;
+    YAMLStreamSerializer emptySerializer(emptyStream);
+    emptySerializer.end(empty);
+    REQUIRE(emptyStream.str() == emptyExpected.str());
+}
@@ -0,0 +1,224 @@
+//
+//  test-Snapshot.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <sstream>
+#include <cstring>
+#include <vector>
+#include "catch.hpp"
+#include "Snapshot.h"
+#include "SerializeSnapshot.h"
+
+using namespace snowcrash;
+
+static Blueprint SnapshotBlueprintFixture()
+{
+    Blueprint blueprint;
+    blueprint.metadata.push_back(std::make_pair("FORMAT", "1A"));
+    blueprint.name = "Snowcrash API";
+    blueprint.description = "Uncle Enzo\n";
+
+    ResourceGroup group;
+    group.name = "First";
+    group.description = "p1\n";
+
+    Resource resource;
+    resource.uriTemplate = "/resource/{id}";
+    resource.name = "My Resource";
+    resource.object.name = "My Resource";
+    resource.object.body = "{ ... }\n";
+    resource.headers.push_back(std::make_pair("X-Header", "42"));
+
+    Method method;
+    method.method = "GET";
+    method.description = "Method description\n";
+
+    Response response;
+    response.name = "200";
+    response.body = "Text\n\n{ ... }\n";
+    response.headers.push_back(std::make_pair("Content-Type", "text/plain"));
+    method.responses.push_back(response);
+
+    Request request;
+    request.name = "A";
+    request.schema = "Schema\n";
+    request.headers.push_back(std::make_pair("Content-Type", "text/plain"));
+    method.requests.push_back(request);
+
+    resource.methods.push_back(method);
+    group.resources.push_back(resource);
+    blueprint.resourceGroups.push_back(group);
+    blueprint.resourceGroups.push_back(ResourceGroup());
+
+    return blueprint;
+}
+
+TEST_CASE("snapshot/roundtrip", "Serialize and materialize a snapshot")
+{
+    std::stringstream ss;
+    SerializeSnapshot(SnapshotBlueprintFixture(), ss);
+    REQUIRE(ss.good());
+
+    std::string data = ss.str();
+    Snapshot snapshot;
+    REQUIRE(snapshot.load(data.data(), data.length()));
+    REQUIRE(snapshot.isValid());
+
+    Blueprint blueprint;
+    snapshot.materialize(blueprint);
+
+    REQUIRE(blueprint.metadata.size() == 1);
+    REQUIRE(blueprint.metadata[0].first == "FORMAT");
+    REQUIRE(blueprint.metadata[0].second == "1A");
+    REQUIRE(blueprint.name == "Snowcrash API");
+    REQUIRE(blueprint.description == "Uncle Enzo\n");
+    REQUIRE(blueprint.resourceGroups.size() == 2);
+    REQUIRE(blueprint.resourceGroups[1].name.empty());
+    REQUIRE(blueprint.resourceGroups[1].resources.empty());
+
+    ResourceGroup& group = blueprint.resourceGroups[0];
+    REQUIRE(group.name == "First");
+    REQUIRE(group.description == "p1\n");
+    REQUIRE(group.resources.size() == 1);
+
+    Resource& resource = group.resources[0];
+    REQUIRE(resource.uriTemplate == "/resource/{id}");
+    REQUIRE(resource.name == "My Resource");
+    REQUIRE(resource.object.name == "My Resource");
+    REQUIRE(resource.object.body == "{ ... }\n");
+    REQUIRE(resource.headers.size() == 1);
+    REQUIRE(resource.headers[0].first == "X-Header");
+    REQUIRE(resource.headers[0].second == "42");
+    REQUIRE(resource.methods.size() == 1);
+
+    Method& method = resource.methods[0];
+    REQUIRE(method.method == "GET");
+    REQUIRE(method.name.empty());
+    REQUIRE(method.description == "Method description\n");
+    REQUIRE(method.requests.size() == 1);
+    REQUIRE(method.requests[0].name == "A");
+    REQUIRE(method.requests[0].schema == "Schema\n");
+    REQUIRE(method.requests[0].body.empty());
+    REQUIRE(method.responses.size() == 1);
+    REQUIRE(method.responses[0].name == "200");
+    REQUIRE(method.responses[0].body == "Text\n\n{ ... }\n");
+    REQUIRE(method.responses[0].headers.size() == 1);
+    REQUIRE(method.responses[0].headers[0].second == "text/plain");
+}
+
+TEST_CASE("snapshot/in-place", "Read snapshot strings in place")
+{
+    std::stringstream ss;
+    SerializeSnapshot(SnapshotBlueprintFixture(), ss);
+    std::string data = ss.str();
+
+    Snapshot snapshot;
+    REQUIRE(snapshot.load(data.data(), data.length()));
+
+    const SnapshotBlueprint& blueprint = snapshot.blueprint();
+    REQUIRE(blueprint.resourceGroups.count == 2);
+
+    const char* name = snapshot.c_str(blueprint.name);
+    REQUIRE(name >= data.data());
+    REQUIRE(name < data.data() + data.length());
+    REQUIRE(std::strcmp(name, "Snowcrash API") == 0);
+
+    const SnapshotResourceGroup& group = snapshot.at<SnapshotResourceGroup>(blueprint.resourceGroups, 0);
+    const SnapshotResource& resource = snapshot.at<SnapshotResource>(group.resources, 0);
+    REQUIRE(snapshot.str(resource.uriTemplate) == "/resource/{id}");
+
+    // Identical short strings are shared
+    const SnapshotMethod& method = snapshot.at<SnapshotMethod>(resource.methods, 0);
+    const SnapshotPayload& request = snapshot.at<SnapshotPayload>(method.requests, 0);
+    const SnapshotPayload& response = snapshot.at<SnapshotPayload>(method.responses, 0);
+    REQUIRE(snapshot.at<SnapshotKeyValue>(request.headers, 0).key.offset ==
+            snapshot.at<SnapshotKeyValue>(response.headers, 0).key.offset);
+}
+
+TEST_CASE("snapshot/empty", "Snapshot of an empty blueprint")
+{
+    std::stringstream ss;
+    SerializeSnapshot(Blueprint(), ss);
+    std::string data = ss.str();
+
+    Snapshot snapshot;
+    REQUIRE(snapshot.load(data.data(), data.length()));
+
+    Blueprint blueprint;
+    snapshot.materialize(blueprint);
+    REQUIRE(blueprint.name.empty());
+    REQUIRE(blueprint.metadata.empty());
+    REQUIRE(blueprint.resourceGroups.empty());
+}
+
+TEST_CASE("snapshot/invalid", "Reject malformed snapshots")
+{
+    std::stringstream ss;
+    SerializeSnapshot(SnapshotBlueprintFixture(), ss);
+    std::string data = ss.str();
+
+    Snapshot snapshot;
+    REQUIRE_FALSE(snapshot.load(NULL, 0));
+    REQUIRE_FALSE(snapshot.load(data.data(), 4));
+    REQUIRE_FALSE(snapshot.isValid());
+
+    // Truncated
+    REQUIRE_FALSE(snapshot.load(data.data(), data.length() - 1));
+
+    // Bad magic
+    std::string corrupted = data;
+    corrupted[0] = 'X';
+    REQUIRE_FALSE(snapshot.load(corrupted.data(), corrupted.length()));
+
+    // Unknown version
+    corrupted = data;
+    SnapshotHeader header;
+    std::memcpy(&header, corrupted.data(), sizeof(header));
+    header.version = SnapshotVersion + 1;
+    std::memcpy(&corrupted[0], &header, sizeof(header));
+    REQUIRE_FALSE(snapshot.load(corrupted.data(), corrupted.length()));
+
+    // Out of bounds offset
+    corrupted = data;
+    std::memcpy(&header, corrupted.data(), sizeof(header));
+    header.blueprint.resourceGroups.offset = header.size;
+    std::memcpy(&corrupted[0], &header, sizeof(header));
+    REQUIRE_FALSE(snapshot.load(corrupted.data(), corrupted.length()));
+
+    // Misaligned buffer
+    std::vector<uint32_t> buffer(data.length() / sizeof(uint32_t) + 1);
+    char* misaligned = reinterpret_cast<char*>(&buffer[0]) + 1;
+    std::memcpy(misaligned, data.data(), data.length());
+    REQUIRE_FALSE(snapshot.load(misaligned, data.length()));
+
+    REQUIRE(snapshot.load(data.data(), data.length()));
+}
+
+TEST_CASE("snapshot/shared-arrays", "Reject snapshots sharing record arrays")
+{
+    Blueprint blueprint;
+    blueprint.resourceGroups.resize(8);
+    blueprint.resourceGroups[0].resources.resize(8);
+
+    std::stringstream ss;
+    SerializeSnapshot(blueprint, ss);
+    std::string data = ss.str();
+
+    Snapshot snapshot;
+    REQUIRE(snapshot.load(data.data(), data.length()));
+
+    // All groups refer to resources of the first one
+    SnapshotHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    std::vector<SnapshotResourceGroup> groups(header.blueprint.resourceGroups.count);
+    char* records = &data[header.blueprint.resourceGroups.offset];
+    std::memcpy(&groups[0], records, groups.size() * sizeof(SnapshotResourceGroup));
+    for (size_t i = 1; i < groups.size(); ++i)
+        groups[i].resources = groups[0].resources;
+    std::memcpy(records, &groups[0], groups.size() * sizeof(SnapshotResourceGroup));
+
+    REQUIRE_FALSE(snapshot.load(data.data(), data.length()));
+}
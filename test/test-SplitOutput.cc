@@ -0,0 +1,98 @@
+//
+//  test-SplitOutput.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <fstream>
+#include <sstream>
+#include "catch.hpp"
+#include "Fixture.h"
+#include "SplitOutput.h"
+#include "SerializeJSON.h"
+#include "DeserializeJSON.h"
+
+using namespace snowcrash;
+using namespace snowcrashtest;
+
+// JSON format serializer
+static void SerializeFormat(const Blueprint& blueprint, const std::string& format, std::ostream& os)
+{
+    SerializeJSON(blueprint, os, (format == "json-compact") ? CompactJSONOption : 0);
+}
+
+// Read a file written by the serializer back
+static bool ReadBlueprint(const std::string& path, Blueprint& blueprint)
+{
+    std::ifstream is(path.c_str(), std::ios::binary);
+    if (!is.is_open())
+        return false;
+
+    Error error;
+    DeserializeJSON(is, blueprint, error);
+    return error.code == Error::OK;
+}
+
+TEST_CASE("splitoutput/file-names", "Name index & resource group files")
+{
+    REQUIRE(SplitOutputIndexFileName("json") == "index.json");
+    REQUIRE(SplitOutputIndexFileName("json-compact") == "index.json");
+    REQUIRE(SplitOutputFileName(0, "yaml") == "group-001.yaml");
+    REQUIRE(SplitOutputFileName(41, "json-compact") == "group-042.json");
+}
+
+TEST_CASE("splitoutput/write", "Write sharded output matching the single file output")
+{
+    const char* formats[] = { "json", "json-compact" };
+    for (int f = 0; f < 2; ++f) {
+        TemporaryDirectory directory;
+        REQUIRE(!directory.path().empty());
+
+        Blueprint blueprint = SerializeBlueprintFixture();
+        std::string error;
+        REQUIRE(WriteSplitOutput(blueprint, directory.path(), formats[f], SerializeFormat, error));
+        REQUIRE(error.empty());
+
+        // Index holds the overview & group names only
+        Blueprint index;
+        REQUIRE(ReadBlueprint(directory.filePath(SplitOutputIndexFileName(formats[f])), index));
+        REQUIRE(index.name == blueprint.name);
+        REQUIRE(index.metadata.size() == blueprint.metadata.size());
+        REQUIRE(index.resourceGroups.size() == blueprint.resourceGroups.size());
+        for (size_t i = 0; i < index.resourceGroups.size(); ++i) {
+            REQUIRE(index.resourceGroups[i].name == blueprint.resourceGroups[i].name);
+            REQUIRE(index.resourceGroups[i].resources.empty());
+        }
+
+        // Shards put back into the index make the single file output
+        Blueprint merged = index;
+        for (size_t i = 0; i < index.resourceGroups.size(); ++i) {
+            Blueprint shard;
+            REQUIRE(ReadBlueprint(directory.filePath(SplitOutputFileName(i, formats[f])), shard));
+            REQUIRE(shard.name == blueprint.name);
+            REQUIRE(shard.resourceGroups.size() == 1);
+            merged.resourceGroups[i] = shard.resourceGroups[0];
+        }
+
+        Blueprint extra;
+        REQUIRE(!ReadBlueprint(directory.filePath(SplitOutputFileName(index.resourceGroups.size(), formats[f])), extra));
+
+        std::stringstream single;
+        SerializeFormat(blueprint, formats[f], single);
+        std::stringstream reassembled;
+        SerializeFormat(merged, formats[f], reassembled);
+        REQUIRE(reassembled.str() == single.str());
+    }
+}
+
+TEST_CASE("splitoutput/unwritable", "Report directory that cannot be created")
+{
+    TemporaryDirectory directory;
+    REQUIRE(!directory.path().empty());
+
+    std::string error;
+    std::string missing = directory.filePath("missing/output");
+    REQUIRE(!WriteSplitOutput(SerializeBlueprintFixture(), missing, "json", SerializeFormat, error));
+    REQUIRE(error.find("unable to create directory `" + missing + "`") == 0);
+}
@@ -19,7 +19,8 @@ TEST_CASE("symbol/resource-object", "Parse object resource symbol")
 {
     MarkdownBlock::Stack markdown = CanonicalResourceFixture();
     Resource resource;
-    BlueprintParserCore parser(0, SourceDataFixture, Blueprint());
+    Blueprint blueprint;
+    BlueprintParserCore parser(0, SourceDataFixture, blueprint);
     ParseSectionResult result = ResourceParser::Parse(markdown.begin(), markdown.end(), parser, resource);
     
     REQUIRE(result.first.error.code == Error::OK);
@@ -31,7 +32,7 @@ TEST_CASE("symbol/resource-object", "Parse object resource symbol")
     REQUIRE(it->second.body == "X.O.");
     
     // Check we will get error parsing the same symbol again with the same symbol table
-    BlueprintParserCore parser2(0, SourceDataFixture, Blueprint());
+    BlueprintParserCore parser2(0, SourceDataFixture, blueprint);
     parser2.symbolTable = parser.symbolTable;
     Resource resource2;
     ParseSectionResult result2 = ResourceParser::Parse(markdown.begin(), markdown.end(), parser2, resource2);
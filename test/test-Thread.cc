@@ -0,0 +1,72 @@
+//
+//  test-Thread.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include "catch.hpp"
+#include "Thread.h"
+
+using namespace snowcrash;
+
+namespace {
+
+    // Task summing numbers of a range
+    class SumTask : public Task {
+    public:
+        SumTask(size_t from, size_t to) : from(from), to(to), sum(0), runs(0) {}
+
+        virtual void run() {
+            for (size_t i = from; i < to; ++i)
+                sum += i;
+            ++runs;
+        }
+
+        size_t from;
+        size_t to;
+        size_t sum;
+        size_t runs;
+    };
+}
+
+TEST_CASE("thread/pool", "Run tasks on a thread pool")
+{
+    ThreadPool pool(4);
+    REQUIRE(pool.size() == 4);
+
+    std::vector<SumTask> tasks;
+    for (size_t i = 0; i < 100; ++i)
+        tasks.push_back(SumTask(i * 100, (i + 1) * 100));
+
+    std::vector<Task*> work;
+    for (std::vector<SumTask>::iterator it = tasks.begin(); it != tasks.end(); ++it)
+        work.push_back(&*it);
+
+    // Pool is reused for subsequent runs
+    for (size_t run = 1; run <= 3; ++run) {
+        pool.run(work);
+
+        size_t sum = 0;
+        for (std::vector<SumTask>::const_iterator it = tasks.begin(); it != tasks.end(); ++it) {
+            REQUIRE(it->runs == run);
+            sum += it->sum;
+        }
+
+        REQUIRE(sum == run * (9999 * 10000 / 2));
+    }
+}
+
+TEST_CASE("thread/pool-empty", "Run no tasks on a thread pool")
+{
+    ThreadPool pool(2);
+    pool.run(std::vector<Task*>());
+
+    SumTask task(0, 10);
+    ThreadPool single(1);
+    REQUIRE(single.size() == 1);
+    single.run(std::vector<Task*>(1, &task));
+    REQUIRE(task.sum == 45);
+
+    REQUIRE(ThreadPool::HardwareConcurrency() >= 1);
+}
@@ -0,0 +1,143 @@
+//
+//  test-Trace.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <sstream>
+#include "catch.hpp"
+#include "Fixture.h"
+#include "BlueprintParser.h"
+#include "Trace.h"
+#include "Thread.h"
+
+using namespace snowcrash;
+using namespace snowcrashtest;
+
+namespace {
+    
+    // Records given number of spans
+    class RecordTask : public Task {
+    public:
+        RecordTask(Trace& trace, size_t spans) : m_trace(trace), m_spans(spans) {}
+        
+        virtual void run() {
+            for (size_t i = 0; i < m_spans; ++i)
+                TraceSpan span(&m_trace, "task", "test");
+        }
+        
+    private:
+        Trace& m_trace;
+        size_t m_spans;
+    };
+}
+
+TEST_CASE("trace/record", "Record spans")
+{
+    Trace trace;
+    REQUIRE(trace.size() == 0);
+    
+    {
+        TraceSpan outer(&trace, "outer", "test");
+        TraceSpan inner(&trace, "inner", "test");
+    }
+    
+    TraceEvent event;
+    event.name = "source";
+    event.category = "test";
+    event.begin = Now();
+    event.end = event.begin;
+    event.source.location = 4;
+    event.source.length = 2;
+    trace.record(event);
+    
+    REQUIRE(trace.size() == 3);
+    
+    std::stringstream ss;
+    trace.write(ss);
+    std::string json = ss.str();
+    REQUIRE(json.find("{\"traceEvents\":[") == 0);
+    REQUIRE(json.find("\"name\":\"outer\",\"cat\":\"test\",\"ph\":\"X\"") != std::string::npos);
+    REQUIRE(json.find("\"name\":\"inner\"") != std::string::npos);
+    REQUIRE(json.find("\"args\":{\"location\":4,\"length\":2}") != std::string::npos);
+}
+
+TEST_CASE("trace/empty", "Write empty trace")
+{
+    Trace trace;
+    
+    {
+        TraceSpan span(NULL, "none", "test");
+    }
+    
+    REQUIRE(trace.size() == 0);
+    
+    std::stringstream ss;
+    trace.write(ss);
+    REQUIRE(ss.str() == "{\"traceEvents\":[\n],\"displayTimeUnit\":\"ms\"}\n");
+}
+
+TEST_CASE("trace/threads", "Record spans from multiple threads")
+{
+    Trace trace;
+    
+    std::vector<RecordTask> tasks(8, RecordTask(trace, 500));
+    std::vector<Task*> work;
+    for (std::vector<RecordTask>::iterator it = tasks.begin(); it != tasks.end(); ++it)
+        work.push_back(&*it);
+    
+    ThreadPool pool(4);
+    pool.run(work);
+    
+    REQUIRE(trace.size() == 8 * 500);
+    
+    // Another trace on the same threads
+    Trace other;
+    std::vector<RecordTask> otherTasks(4, RecordTask(other, 10));
+    work.clear();
+    for (std::vector<RecordTask>::iterator it = otherTasks.begin(); it != otherTasks.end(); ++it)
+        work.push_back(&*it);
+    
+    pool.run(work);
+    REQUIRE(other.size() == 4 * 10);
+    REQUIRE(trace.size() == 8 * 500);
+}
+
+TEST_CASE("trace/alternate", "Alternate recording between live traces")
+{
+    // More traces than a thread keeps at hand
+    Trace traces[6];
+    for (size_t i = 0; i < 100; ++i) {
+        for (size_t t = 0; t < 6; ++t)
+            TraceSpan span(&traces[t], "span", "test");
+    }
+    
+    // Single buffer per trace
+    for (size_t t = 0; t < 6; ++t) {
+        REQUIRE(traces[t].size() == 100);
+        
+        std::stringstream ss;
+        traces[t].write(ss);
+        REQUIRE(ss.str().find("\"tid\":1}") != std::string::npos);
+        REQUIRE(ss.str().find("\"tid\":2}") == std::string::npos);
+    }
+}
+
+TEST_CASE("trace/blueprint", "Trace blueprint parsing")
+{
+    MarkdownBlock::Stack markdown = CanonicalBlueprintFixture();
+    
+    Result result;
+    Blueprint blueprint;
+    Trace trace;
+    BlueprintParser::Parse(SourceDataFixture, markdown, 0, result, blueprint, NULL, NULL, &trace);
+    REQUIRE(result.error.code == Error::OK);
+    REQUIRE(trace.size() > 0);
+    
+    std::stringstream ss;
+    trace.write(ss);
+    REQUIRE(ss.str().find("\"name\":\"resourceGroup\",\"cat\":\"section\"") != std::string::npos);
+    REQUIRE(ss.str().find("\"name\":\"resource\",\"cat\":\"section\"") != std::string::npos);
+    REQUIRE(ss.str().find("\"args\":{\"location\":") != std::string::npos);
+}
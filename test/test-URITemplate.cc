@@ -0,0 +1,160 @@
+//
+//  test-URITemplate.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include "catch.hpp"
+#include "URITemplate.h"
+
+using namespace snowcrash;
+
+static Collection<KeyValuePair>::type URITemplateValuesFixture()
+{
+    Collection<KeyValuePair>::type values;
+    values.push_back(std::make_pair("var", "value"));
+    values.push_back(std::make_pair("hello", "Hello World!"));
+    values.push_back(std::make_pair("path", "/foo/bar"));
+    values.push_back(std::make_pair("empty", ""));
+    values.push_back(std::make_pair("x", "1024"));
+    values.push_back(std::make_pair("y", "768"));
+    return values;
+}
+
+static std::string Expand(const std::string& uriTemplate)
+{
+    CompiledURITemplate compiled;
+    REQUIRE(CompileURITemplate(uriTemplate, compiled));
+
+    std::string result;
+    ExpandURITemplate(compiled, URITemplateValuesFixture(), result);
+    return result;
+}
+
+TEST_CASE("uritemplate/compile", "Compile URI template")
+{
+    CompiledURITemplate compiled;
+    REQUIRE(CompileURITemplate("/notes/{id}{?q,limit:3}{&page*}", compiled));
+    REQUIRE(compiled.prefix == "/notes/");
+    REQUIRE(compiled.parts.size() == 4);
+
+    REQUIRE(compiled.parts[0].type == LiteralURITemplatePartType);
+    REQUIRE(compiled.parts[0].literal == "/notes/");
+
+    REQUIRE(compiled.parts[1].type == ExpressionURITemplatePartType);
+    REQUIRE(compiled.parts[1].op == '\0');
+    REQUIRE(compiled.parts[1].variables.size() == 1);
+    REQUIRE(compiled.parts[1].variables[0].name == "id");
+
+    REQUIRE(compiled.parts[2].op == '?');
+    REQUIRE(compiled.parts[2].variables.size() == 2);
+    REQUIRE(compiled.parts[2].variables[0].name == "q");
+    REQUIRE(compiled.parts[2].variables[0].maxLength == 0);
+    REQUIRE(compiled.parts[2].variables[1].name == "limit");
+    REQUIRE(compiled.parts[2].variables[1].maxLength == 3);
+
+    REQUIRE(compiled.parts[3].op == '&');
+    REQUIRE(compiled.parts[3].variables[0].name == "page");
+    REQUIRE(compiled.parts[3].variables[0].explode);
+
+    REQUIRE(CompileURITemplate("{/id}", compiled));
+    REQUIRE(compiled.prefix.empty());
+}
+
+TEST_CASE("uritemplate/malformed", "Reject malformed URI template")
+{
+    CompiledURITemplate compiled;
+    REQUIRE_FALSE(CompileURITemplate("/notes/{id", compiled));
+    REQUIRE(compiled.parts.size() == 1);
+    REQUIRE(compiled.prefix == "/notes/");
+
+    REQUIRE_FALSE(CompileURITemplate("/notes/{}", compiled));
+    REQUIRE_FALSE(CompileURITemplate("/notes/{a b}", compiled));
+    REQUIRE_FALSE(CompileURITemplate("/notes/{id:x}", compiled));
+    REQUIRE_FALSE(CompileURITemplate("/notes/{=id}", compiled));
+    REQUIRE_FALSE(CompileURITemplate("/notes/{!id}", compiled));
+}
+
+TEST_CASE("uritemplate/expand", "Expand URI template")
+{
+    // RFC 6570 examples
+    REQUIRE(Expand("{var}") == "value");
+    REQUIRE(Expand("{hello}") == "Hello%20World%21");
+    REQUIRE(Expand("{+hello}") == "Hello%20World!");
+    REQUIRE(Expand("{+path}/here") == "/foo/bar/here");
+    REQUIRE(Expand("{#path,x}/here") == "#/foo/bar,1024/here");
+    REQUIRE(Expand("map?{x,y}") == "map?1024,768");
+    REQUIRE(Expand("X{.var}") == "X.value");
+    REQUIRE(Expand("{/var,x}/here") == "/value/1024/here");
+    REQUIRE(Expand("{;x,y,empty}") == ";x=1024;y=768;empty");
+    REQUIRE(Expand("{?x,y,empty}") == "?x=1024&y=768&empty=");
+    REQUIRE(Expand("?fixed=yes{&x}") == "?fixed=yes&x=1024");
+    REQUIRE(Expand("{var:3}") == "val");
+    REQUIRE(Expand("{/undef}") == "");
+    REQUIRE(Expand("{?undef,x}") == "?x=1024");
+}
+
+TEST_CASE("uritemplate/match", "Match URI against URI template")
+{
+    CompiledURITemplate compiled;
+    std::vector<URITemplateCapture> captures;
+
+    REQUIRE(CompileURITemplate("/reports/{id}.{format}{?q,limit}", compiled));
+    std::string uri = "/reports/2013.json?limit=10&q=snow";
+    REQUIRE(MatchURITemplate(compiled, uri, captures));
+    REQUIRE(captures.size() == 4);
+    REQUIRE(*captures[0].name == "id");
+    REQUIRE(uri.substr(captures[0].offset, captures[0].length) == "2013");
+    REQUIRE(*captures[1].name == "format");
+    REQUIRE(uri.substr(captures[1].offset, captures[1].length) == "json");
+    REQUIRE(*captures[2].name == "limit");
+    REQUIRE(uri.substr(captures[2].offset, captures[2].length) == "10");
+    REQUIRE(*captures[3].name == "q");
+    REQUIRE(uri.substr(captures[3].offset, captures[3].length) == "snow");
+
+    // Prefix rejection
+    REQUIRE_FALSE(MatchURITemplate(compiled, "/notes/1", captures));
+
+    REQUIRE(CompileURITemplate("/files/{+path}/edit", compiled));
+    uri = "/files/a/b/edit";
+    REQUIRE(MatchURITemplate(compiled, uri, captures));
+    REQUIRE(captures.size() == 1);
+    REQUIRE(uri.substr(captures[0].offset, captures[0].length) == "a/b");
+
+    REQUIRE(CompileURITemplate("/notes/{id}", compiled));
+    REQUIRE_FALSE(MatchURITemplate(compiled, "/notes/1/2", captures));
+}
+
+TEST_CASE("uritemplate/roundtrip", "Match expanded URI template")
+{
+    const char* templates[] = {
+        "/notes/{var}",
+        "{+path}/here",
+        "/map{?x,y}",
+        "X{.var}{/x,y}",
+        "/matrix{;x,y}"
+    };
+
+    Collection<KeyValuePair>::type values = URITemplateValuesFixture();
+    for (size_t i = 0; i < sizeof(templates) / sizeof(templates[0]); ++i) {
+
+        CompiledURITemplate compiled;
+        REQUIRE(CompileURITemplate(templates[i], compiled));
+
+        std::string uri;
+        ExpandURITemplate(compiled, values, uri);
+
+        std::vector<URITemplateCapture> captures;
+        REQUIRE(MatchURITemplate(compiled, uri, captures));
+
+        for (std::vector<URITemplateCapture>::const_iterator it = captures.begin(); it != captures.end(); ++it) {
+            Collection<KeyValuePair>::const_iterator value = values.begin();
+            while (value != values.end() && value->first != *it->name)
+                ++value;
+
+            REQUIRE(value != values.end());
+            REQUIRE(uri.substr(it->offset, it->length) == value->second);
+        }
+    }
+}
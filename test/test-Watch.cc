@@ -0,0 +1,65 @@
+//
+//  test-Watch.cc
+//  snowcrash
+//
+//  Copyright (c) 2013 Apiary Inc. All rights reserved.
+//
+
+#include <sstream>
+#include "catch.hpp"
+#include "Watch.h"
+
+using namespace snowcrash;
+
+TEST_CASE("watch/diagnostic-lines", "Diagnostics lines of a parser result")
+{
+    Result result;
+    std::vector<std::string> lines;
+    DiagnosticLines("api.apib", result, lines);
+    REQUIRE(lines.empty());
+
+    SourceDataBlock location = MakeSourceDataBlock(1, 2);
+    location.push_back(MakeSourceDataBlock(5, 3).front());
+    result.error = Error("unexpected block", 2, location);
+    result.warnings.push_back(Warning("ignoring content", 6, MakeSourceDataBlock(10, 4)));
+    result.warnings.push_back(Warning(ExpectedAPINameWarning, 0, SourceDataBlock()));
+
+    lines.push_back("stale");
+    DiagnosticLines("api.apib", result, lines);
+    REQUIRE(lines.size() == 3);
+
+    // Sorted
+    REQUIRE(lines[0] == "api.apib: error: (2) unexpected block :1:2;5:3");
+    REQUIRE(lines[1] == "api.apib: warning: (6) ignoring content :10:4");
+    REQUIRE(lines[2] == "api.apib: warning: expected API name, e.g. `# <API Name>`");
+}
+
+TEST_CASE("watch/delta", "Write diagnostics delta")
+{
+    std::vector<std::string> before;
+    before.push_back("a");
+    before.push_back("b");
+    before.push_back("c");
+
+    std::vector<std::string> after;
+    after.push_back("b");
+    after.push_back("d");
+
+    std::stringstream delta;
+    WriteDiagnosticsDelta(before, after, delta);
+    REQUIRE(delta.str() == "- a\n- c\n+ d\n");
+
+    // Nothing changed
+    std::stringstream unchanged;
+    WriteDiagnosticsDelta(before, before, unchanged);
+    REQUIRE(unchanged.str().empty());
+
+    // File added & removed
+    std::stringstream added;
+    WriteDiagnosticsDelta(std::vector<std::string>(), after, added);
+    REQUIRE(added.str() == "+ b\n+ d\n");
+
+    std::stringstream removed;
+    WriteDiagnosticsDelta(after, std::vector<std::string>(), removed);
+    REQUIRE(removed.str() == "- b\n- d\n");
+}
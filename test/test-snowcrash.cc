@@ -12,8 +12,6 @@
 #include "snowcrash.h"
 #include "Fixture.h"
 
-const snowcrash::SourceData snowcrashtest::SourceDataFixture = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-
 using namespace snowcrash;
 
 TEST_CASE("snowcrash/parse", "snowcrash parse test")